@@ -72,6 +72,8 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
   m_eventsWithContextEmpty = true;
+  m_batchNext = 0;
+  m_batchLastUid = 0;
   m_main = SystemThread::Self();
 }
 
@@ -135,19 +137,41 @@ DefaultSimulatorImpl::GetSystemId (void) const
 }
 
 void
-DefaultSimulatorImpl::ProcessOneEvent (void)
+DefaultSimulatorImpl::ProcessEventBatch (void)
 {
   Scheduler::Event next = m_events->RemoveNext ();
 
   NS_ASSERT (next.key.m_ts >= m_currentTs);
-  m_unscheduledEvents--;
-
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
-  m_currentContext = next.key.m_context;
-  m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
-  next.impl->Unref ();
+
+  // The scheduler returns the events with the same timestamp in uid
+  // order, so the batch is sorted.
+  m_batch.push_back (next);
+  while (!m_events->IsEmpty () && m_events->PeekNext ().key.m_ts == m_currentTs)
+    {
+      m_batch.push_back (m_events->RemoveNext ());
+    }
+  m_batchLastUid = m_batch.back ().key.m_uid;
+
+  m_batchNext = 0;
+  while (m_batchNext < m_batch.size () && !m_stop)
+    {
+      Scheduler::Event &ev = m_batch[m_batchNext++];
+      m_unscheduledEvents--;
+      m_currentContext = ev.key.m_context;
+      m_currentUid = ev.key.m_uid;
+      ev.impl->Invoke ();
+      ev.impl->Unref ();
+    }
+  // Put back the events left by Stop, for the next Run
+  for (; m_batchNext < m_batch.size (); m_batchNext++)
+    {
+      m_events->Insert (m_batch[m_batchNext]);
+    }
+  m_batch.clear ();
+  m_batchNext = 0;
+  m_batchLastUid = 0;
 
   ProcessEventsWithContext ();
 }
@@ -155,7 +179,7 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
 bool 
 DefaultSimulatorImpl::IsFinished (void) const
 {
-  return m_events->IsEmpty () || m_stop;
+  return (m_events->IsEmpty () && m_batchNext == m_batch.size ()) || m_stop;
 }
 
 void
@@ -199,7 +223,7 @@ DefaultSimulatorImpl::Run (void)
 
   while (!m_events->IsEmpty () && !m_stop) 
     {
-      ProcessOneEvent ();
+      ProcessEventBatch ();
     }
 
   // If the simulator stopped naturally by lack of events, make a
@@ -344,6 +368,13 @@ DefaultSimulatorImpl::Remove (const EventId &id)
     {
       return;
     }
+  if (id.GetTs () == m_currentTs && id.GetUid () <= m_batchLastUid)
+    {
+      // The event is in the current batch, out of the queue:  it is
+      // skipped and released with the batch.
+      id.PeekEventImpl ()->Cancel ();
+      return;
+    }
   Scheduler::Event event;
   event.impl = id.PeekEventImpl ();
   event.key.m_ts = id.GetTs ();
@@ -30,6 +30,7 @@
 #include "ptr.h"
 
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -43,6 +44,14 @@ namespace ns3 {
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * The events are dispatched in batches of all the events with the
+ * same timestamp, as they are typical of multicast fan-outs and of
+ * applications started together.  A batch runs in the order of the
+ * event uids, which is the order the events were scheduled in, so
+ * the order of the events is the same as with one event at a time:
+ * an event scheduled for the current time by the batch gets a larger
+ * uid than the whole batch and runs in the next one.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -81,8 +90,8 @@ public:
 private:
   virtual void DoDispose (void);
 
-  /** Process the next event. */
-  void ProcessOneEvent (void);
+  /** Process all the events with the timestamp of the next event. */
+  void ProcessEventBatch (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
  
@@ -116,6 +125,18 @@ private:
   /** The event priority queue. */
   Ptr<Scheduler> m_events;
 
+  /** Container type for a batch of events with the same timestamp. */
+  typedef std::vector<Scheduler::Event> EventBatch;
+  /**
+   * The events removed from the queue for the current timestamp, in
+   * uid order; kept between batches to reuse the storage.
+   */
+  EventBatch m_batch;
+  /** Index in m_batch of the next event to run. */
+  uint32_t m_batchNext;
+  /** Unique id of the last event of the current batch, or 0. */
+  uint32_t m_batchLastUid;
+
   /** Next event unique id. */
   uint32_t m_uid;
   /** Unique id of the current event. */
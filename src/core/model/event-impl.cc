@@ -20,6 +20,10 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include "system-mutex.h"
+
+#include <atomic>
+#include <new>
 
 /**
  * \file
@@ -31,13 +35,211 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/** Difference between the sizes of two consecutive size classes. */
+const std::size_t SIZE_CLASS_STEP = 16;
+/** Number of size classes; larger events use the global allocator. */
+const std::size_t N_SIZE_CLASSES = 8;
+/** Size of the memory blocks which are divided into events. */
+const std::size_t SLAB_SIZE = 64 * 1024;
+
+/** The memory of a released event, in the free list of its size class. */
+struct FreeEvent
+{
+  FreeEvent *next;  /**< The next free event of the same size class. */
+};
+
+struct EventPool;
+
+/**
+ * The header of the memory of a pooled event, before the event.
+ *
+ * It is 16 bytes long so that the events keep the alignment of
+ * ::operator new.
+ */
+struct EventHeader
+{
+  EventPool *owner;  /**< The pool of the memory, or 0 for the global allocator. */
+  void *padding;     /**< Unused. */
+};
+
+/**
+ * Free lists of event memory, one per size class.
+ *
+ * Each thread owns a pool, so that allocating and releasing events
+ * in the same thread needs no locking.  An event may be released by
+ * another thread than the one which scheduled it (see
+ * Simulator::ScheduleWithContext):  its memory then goes back to the
+ * pool which owns it, through a lock-free list of remote releases
+ * which the owning thread takes over when its own list is empty.
+ *
+ * When a thread exits, its pool is kept for the next thread which
+ * needs one, e.g., the partition threads of the next run of the
+ * multithreaded simulator, so that the memory of the pools is bounded
+ * by the number of threads running at the same time.
+ */
+struct EventPool
+{
+  FreeEvent *free[N_SIZE_CLASSES];                /**< The free lists. */
+  std::atomic<FreeEvent *> remote[N_SIZE_CLASSES]; /**< The events released by other threads. */
+  char *slab;                                     /**< The unused part of the last slab. */
+  std::size_t slabLeft;                           /**< The size of the unused part of the last slab. */
+  EventPool *nextIdle;                            /**< The next pool without thread. */
+};
+
+/** The pools whose thread has exited. */
+EventPool *g_idlePools = 0;
+
+/**
+ * Get the mutex protecting the pools whose thread has exited.
+ *
+ * The mutex is never destroyed, as threads may exit during the
+ * destruction of the statics.
+ *
+ * \returns The mutex.
+ */
+SystemMutex &
+GetIdlePoolsMutex (void)
+{
+  static SystemMutex *mutex = new SystemMutex;
+  return *mutex;
+}
+
+/** The pool of the current thread, if any. */
+thread_local EventPool *g_eventPool = 0;
+/** Whether the current thread has released its pool, while exiting. */
+thread_local bool g_eventPoolReleased = false;
+
+/** Releases the pool of a thread when the thread exits. */
+struct EventPoolRelease
+{
+  ~EventPoolRelease ()
+  {
+    if (g_eventPool != 0)
+      {
+        CriticalSection cs (GetIdlePoolsMutex ());
+        g_eventPool->nextIdle = g_idlePools;
+        g_idlePools = g_eventPool;
+        g_eventPool = 0;
+      }
+    g_eventPoolReleased = true;
+  }
+};
+
+/** The release of the pool of the current thread. */
+thread_local EventPoolRelease g_eventPoolRelease;
+
+/**
+ * Get the pool of the current thread, taking an idle one or creating
+ * one at first use.
+ *
+ * \returns The pool, or 0 if the thread is exiting.
+ */
+EventPool *
+GetEventPool (void)
+{
+  if (g_eventPool != 0 || g_eventPoolReleased)
+    {
+      return g_eventPool;
+    }
+  // constructs the release of the pool at thread exit
+  (void)&g_eventPoolRelease;
+
+  CriticalSection cs (GetIdlePoolsMutex ());
+  if (g_idlePools != 0)
+    {
+      g_eventPool = g_idlePools;
+      g_idlePools = g_idlePools->nextIdle;
+    }
+  else
+    {
+      g_eventPool = new EventPool ();
+    }
+  return g_eventPool;
+}
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  std::size_t sizeClass = (size - 1) / SIZE_CLASS_STEP;
+  if (sizeClass >= N_SIZE_CLASSES)
+    {
+      return ::operator new (size);
+    }
+  std::size_t blockSize = sizeof (EventHeader) + (sizeClass + 1) * SIZE_CLASS_STEP;
+  EventPool *pool = GetEventPool ();
+  if (pool == 0)
+    {
+      EventHeader *header = static_cast<EventHeader *> (::operator new (blockSize));
+      header->owner = 0;
+      return header + 1;
+    }
+  FreeEvent *event = pool->free[sizeClass];
+  if (event == 0)
+    {
+      event = pool->remote[sizeClass].exchange (0, std::memory_order_acquire);
+    }
+  if (event != 0)
+    {
+      pool->free[sizeClass] = event->next;
+      return event;
+    }
+  if (pool->slabLeft < blockSize)
+    {
+      // the end of the previous slab, if any, is too small and is lost
+      pool->slab = static_cast<char *> (::operator new (SLAB_SIZE));
+      pool->slabLeft = SLAB_SIZE;
+    }
+  EventHeader *header = reinterpret_cast<EventHeader *> (pool->slab);
+  header->owner = pool;
+  pool->slab += blockSize;
+  pool->slabLeft -= blockSize;
+  return header + 1;
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  std::size_t sizeClass = (size - 1) / SIZE_CLASS_STEP;
+  if (sizeClass >= N_SIZE_CLASSES)
+    {
+      ::operator delete (p);
+      return;
+    }
+  EventHeader *header = static_cast<EventHeader *> (p) - 1;
+  EventPool *owner = header->owner;
+  FreeEvent *event = static_cast<FreeEvent *> (p);
+  if (owner == 0)
+    {
+      ::operator delete (header);
+    }
+  else if (owner == g_eventPool)
+    {
+      event->next = owner->free[sizeClass];
+      owner->free[sizeClass] = event;
+    }
+  else
+    {
+      event->next = owner->remote[sizeClass].load (std::memory_order_relaxed);
+      while (!owner->remote[sizeClass].compare_exchange_weak (event->next, event,
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
 }
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_schedulerIndex (0),
+    m_cancel (false)
 {
   NS_LOG_FUNCTION (this);
 }
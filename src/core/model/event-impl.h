@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,11 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events of up to 128 bytes, which include all the events created by
+ * MakeEvent() with their bound arguments, are allocated from free
+ * lists kept for each size class, so that scheduling an event does not
+ * go through the general purpose memory allocator in steady state.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -65,6 +71,40 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Get the position of this event in the event list.
+   *
+   * Only meaningful while the event is held by a Scheduler which
+   * maintains this index, such as IndexedHeapScheduler.
+   *
+   * \returns The index last stored by the Scheduler.
+   */
+  inline uint32_t GetSchedulerIndex (void) const;
+  /**
+   * Record the position of this event in the event list.
+   *
+   * Used by Scheduler implementations to locate an event in
+   * constant time when it is removed.
+   *
+   * \param [in] index The position of the event.
+   */
+  inline void SetSchedulerIndex (uint32_t index);
+
+  /**
+   * Allocate the memory of an event.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory, taken from the free list of the size class
+   *          of \p size if it is small enough.
+   */
+  static void *operator new (std::size_t size);
+  /**
+   * Release the memory of an event.
+   *
+   * \param [in] p The memory.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
 
 protected:
   /**
@@ -76,9 +116,22 @@ protected:
   virtual void Notify (void) = 0;
 
 private:
+  uint32_t m_schedulerIndex;  /**< Position in the event list, maintained by the Scheduler. */
   bool m_cancel;  /**< Has this event been cancelled. */
 };
 
+uint32_t
+EventImpl::GetSchedulerIndex (void) const
+{
+  return m_schedulerIndex;
+}
+
+void
+EventImpl::SetSchedulerIndex (uint32_t index)
+{
+  m_schedulerIndex = index;
+}
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
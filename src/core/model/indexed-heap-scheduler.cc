@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "indexed-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::IndexedHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("IndexedHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (IndexedHeapScheduler);
+
+namespace {
+
+/** Number of children of each heap entry. */
+const uint32_t ARITY = 4;
+
+} // unnamed namespace
+
+TypeId
+IndexedHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::IndexedHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<IndexedHeapScheduler> ()
+  ;
+  return tid;
+}
+
+IndexedHeapScheduler::IndexedHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+IndexedHeapScheduler::~IndexedHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+IndexedHeapScheduler::Place (uint32_t index, const Event &ev)
+{
+  m_heap[index] = ev;
+  ev.impl->SetSchedulerIndex (index);
+}
+
+void
+IndexedHeapScheduler::SiftUp (uint32_t hole, const Event &ev)
+{
+  while (hole > 0)
+    {
+      uint32_t parent = (hole - 1) / ARITY;
+      if (!(ev.key < m_heap[parent].key))
+        {
+          break;
+        }
+      Place (hole, m_heap[parent]);
+      hole = parent;
+    }
+  Place (hole, ev);
+}
+
+void
+IndexedHeapScheduler::SiftDown (uint32_t hole, const Event &ev)
+{
+  uint32_t size = m_heap.size ();
+  while (true)
+    {
+      uint32_t first = hole * ARITY + 1;
+      if (first >= size)
+        {
+          break;
+        }
+      uint32_t last = std::min (first + ARITY, size);
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; child++)
+        {
+          if (m_heap[child].key < m_heap[smallest].key)
+            {
+              smallest = child;
+            }
+        }
+      if (!(m_heap[smallest].key < ev.key))
+        {
+          break;
+        }
+      Place (hole, m_heap[smallest]);
+      hole = smallest;
+    }
+  Place (hole, ev);
+}
+
+void
+IndexedHeapScheduler::RemoveAt (uint32_t index)
+{
+  Event last = m_heap.back ();
+  m_heap.pop_back ();
+  if (index == m_heap.size ())
+    {
+      return;
+    }
+  if (index > 0 && last.key < m_heap[(index - 1) / ARITY].key)
+    {
+      SiftUp (index, last);
+    }
+  else
+    {
+      SiftDown (index, last);
+    }
+}
+
+void
+IndexedHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_heap.push_back (ev);
+  SiftUp (m_heap.size () - 1, ev);
+}
+
+bool
+IndexedHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_heap.empty ();
+}
+
+Scheduler::Event
+IndexedHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_heap.front ();
+}
+
+Scheduler::Event
+IndexedHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Event next = m_heap.front ();
+  RemoveAt (0);
+  return next;
+}
+
+void
+IndexedHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint32_t index = ev.impl->GetSchedulerIndex ();
+  if (index >= m_heap.size () || m_heap[index].key.m_uid != ev.key.m_uid)
+    {
+      // the EventImpl is scheduled more than once and its index
+      // refers to another entry
+      NS_LOG_LOGIC ("stale index " << index << ", searching for uid " << ev.key.m_uid);
+      for (index = 0; index < m_heap.size (); index++)
+        {
+          if (m_heap[index].key.m_uid == ev.key.m_uid)
+            {
+              break;
+            }
+        }
+      NS_ASSERT (index < m_heap.size ());
+    }
+  NS_ASSERT (m_heap[index].impl == ev.impl);
+  RemoveAt (index);
+}
+
+} // namespace ns3
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INDEXED_HEAP_SCHEDULER_H
+#define INDEXED_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::IndexedHeapScheduler class.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler with removal in logarithmic time
+ *
+ * Events are stored by value in a contiguous array managed as an
+ * implicit 4-ary heap: the children of the entry at index \c i are
+ * stored at indexes \c 4i+1 to \c 4i+4.  Compared to a binary heap,
+ * the tree is half as deep and the children of an entry share a
+ * cache line, which makes both insertion and removal of the next
+ * event cheaper.
+ *
+ * Whenever an event is moved in the array, its new index is
+ * recorded in its EventImpl (see EventImpl::SetSchedulerIndex), so
+ * that Remove() can locate the event without searching the array.
+ * This makes Remove() O(log n), instead of O(n) for HeapScheduler,
+ * and no memory is allocated per event, unlike MapScheduler.
+ *
+ * If the same EventImpl is scheduled more than once, its index
+ * refers to only one of the entries.  Remove() detects this case
+ * and falls back to a linear search.
+ */
+class IndexedHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  IndexedHeapScheduler ();
+  /** Destructor. */
+  virtual ~IndexedHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Event list type: vector of Events, managed as a 4-ary heap. */
+  typedef std::vector<Scheduler::Event> Heap;
+
+  /**
+   * Store an event at a given index and record the index in the event.
+   *
+   * \param [in] index The index.
+   * \param [in] ev The event.
+   */
+  inline void Place (uint32_t index, const Scheduler::Event &ev);
+  /**
+   * Move an event up from a hole until the heap property holds,
+   * and store it there.
+   *
+   * \param [in] hole The index of the hole to start from.
+   * \param [in] ev The event to store.
+   */
+  void SiftUp (uint32_t hole, const Scheduler::Event &ev);
+  /**
+   * Move an event down from a hole until the heap property holds,
+   * and store it there.
+   *
+   * \param [in] hole The index of the hole to start from.
+   * \param [in] ev The event to store.
+   */
+  void SiftDown (uint32_t hole, const Scheduler::Event &ev);
+  /**
+   * Remove the event at a given index.
+   *
+   * \param [in] index The index of the event to remove.
+   */
+  void RemoveAt (uint32_t index);
+
+  /** The event list. */
+  Heap m_heap;
+};
+
+} // namespace ns3
+
+#endif /* INDEXED_HEAP_SCHEDULER_H */
@@ -0,0 +1,353 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+namespace {
+
+/** Maximum number of events in a bucket moved to Bottom without spawning a rung. */
+const uint32_t THRESHOLD = 50;
+/** Maximum number of rungs. */
+const uint32_t MAX_RUNGS = 8;
+
+} // unnamed namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_topMin (0),
+    m_topMax (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0),
+    m_bottomHead (0),
+    m_nEvents (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderScheduler::GetCurrentStart (const Rung &rung) const
+{
+  if (rung.current < rung.nBuckets)
+    {
+      return rung.start + rung.current * rung.width;
+    }
+  return rung.end;
+}
+
+LadderScheduler::Bucket &
+LadderScheduler::GetBucket (Rung &rung, uint64_t ts)
+{
+  uint64_t index = (ts - rung.start) / rung.width;
+  if (index >= rung.nBuckets)
+    {
+      index = rung.nBuckets - 1;
+    }
+  return rung.buckets[index];
+}
+
+LadderScheduler::Bucket *
+LadderScheduler::FindBucket (uint64_t ts)
+{
+  if (ts >= m_topStart)
+    {
+      return &m_top;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= GetCurrentStart (rung))
+        {
+          return &GetBucket (rung, ts);
+        }
+    }
+  return 0;
+}
+
+void
+LadderScheduler::Append (Bucket &bucket, const Event &ev)
+{
+  ev.impl->SetSchedulerIndex (bucket.size ());
+  bucket.push_back (ev);
+}
+
+void
+LadderScheduler::InsertBottom (const Event &ev)
+{
+  Bucket::iterator first = m_bottom.begin () + m_bottomHead;
+  Bucket::iterator pos = std::upper_bound (first, m_bottom.end (), ev);
+  uint32_t nBefore = pos - first;
+  uint32_t nAfter = m_bottom.end () - pos;
+  if (m_bottomHead > 0 && nBefore < nAfter)
+    {
+      // cheaper to move the earlier events into the free slot before the head
+      std::copy (first, pos, first - 1);
+      *(pos - 1) = ev;
+      m_bottomHead--;
+      return;
+    }
+  m_bottom.insert (pos, ev);
+
+  if (nAfter > THRESHOLD && m_nRungs < MAX_RUNGS
+      && m_bottom[m_bottomHead].key.m_ts < m_bottom.back ().key.m_ts)
+    {
+      // Bottom got too large to be kept sorted: spread it over a new rung
+      NS_LOG_LOGIC ("spawn rung " << m_nRungs << " from bottom");
+      m_bottom.erase (m_bottom.begin (), m_bottom.begin () + m_bottomHead);
+      m_bottomHead = 0;
+      uint64_t end = m_nRungs > 0 ? GetCurrentStart (m_rungs[m_nRungs - 1]) : m_topStart;
+      Spawn (m_bottom, m_bottom.front ().key.m_ts, m_bottom.back ().key.m_ts, end);
+      m_bottom.clear ();
+    }
+}
+
+LadderScheduler::Rung &
+LadderScheduler::Spawn (const Bucket &events, uint64_t minTs, uint64_t maxTs, uint64_t end)
+{
+  NS_ASSERT (!events.empty () && m_nRungs < MAX_RUNGS);
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+
+  // about one event per bucket, if the time stamps were uniform
+  rung.start = minTs;
+  rung.width = (maxTs - minTs) / events.size () + 1;
+  rung.nBuckets = (maxTs - minTs) / rung.width + 1;
+  rung.end = std::max (end, rung.start + rung.nBuckets * rung.width);
+  rung.current = 0;
+  if (rung.buckets.size () < rung.nBuckets)
+    {
+      rung.buckets.resize (rung.nBuckets);
+    }
+  NS_LOG_LOGIC ("rung " << m_nRungs - 1 << ": " << events.size () << " events in " <<
+                rung.nBuckets << " buckets of width " << rung.width);
+
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      Append (GetBucket (rung, i->key.m_ts), *i);
+    }
+  return rung;
+}
+
+void
+LadderScheduler::FillBottom (void)
+{
+  NS_ASSERT (m_nEvents > 0);
+  m_bottom.clear ();
+  m_bottomHead = 0;
+  while (true)
+    {
+      if (m_nRungs == 0)
+        {
+          NS_LOG_LOGIC ("new epoch with " << m_top.size () << " events");
+          Rung &rung = Spawn (m_top, m_topMin, m_topMax, 0);
+          m_topStart = rung.end;
+          m_top.clear ();
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.current < rung.nBuckets && rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      if (rung.current == rung.nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+
+      Bucket &bucket = rung.buckets[rung.current];
+      rung.current++;
+      if (bucket.size () > THRESHOLD && m_nRungs < MAX_RUNGS)
+        {
+          uint64_t minTs = bucket.front ().key.m_ts;
+          uint64_t maxTs = minTs;
+          for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
+            {
+              minTs = std::min (minTs, i->key.m_ts);
+              maxTs = std::max (maxTs, i->key.m_ts);
+            }
+          if (minTs < maxTs)
+            {
+              Spawn (bucket, minTs, maxTs, GetCurrentStart (rung));
+              bucket.clear ();
+              continue;
+            }
+        }
+
+      m_bottom.swap (bucket);
+      std::sort (m_bottom.begin (), m_bottom.end ());
+      if (rung.current == rung.nBuckets)
+        {
+          // later events before the end of the rung go to Bottom
+          m_nRungs--;
+        }
+      return;
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  Bucket *bucket = FindBucket (ev.key.m_ts);
+  if (bucket == 0)
+    {
+      InsertBottom (ev);
+    }
+  else
+    {
+      if (bucket == &m_top)
+        {
+          if (m_top.empty ())
+            {
+              m_topMin = ev.key.m_ts;
+              m_topMax = ev.key.m_ts;
+            }
+          m_topMin = std::min (m_topMin, ev.key.m_ts);
+          m_topMax = std::max (m_topMax, ev.key.m_ts);
+        }
+      Append (*bucket, ev);
+    }
+  m_nEvents++;
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_nEvents == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottomHead == m_bottom.size ())
+    {
+      // refilling Bottom does not change the content of the queue
+      const_cast<LadderScheduler *> (this)->FillBottom ();
+    }
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottomHead == m_bottom.size ())
+    {
+      FillBottom ();
+    }
+  Event next = m_bottom[m_bottomHead];
+  m_bottomHead++;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      m_bottom.clear ();
+      m_bottomHead = 0;
+    }
+  m_nEvents--;
+  return next;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  Bucket *bucket = FindBucket (ev.key.m_ts);
+  if (bucket == 0)
+    {
+      Bucket::iterator first = m_bottom.begin () + m_bottomHead;
+      Bucket::iterator pos = std::lower_bound (first, m_bottom.end (), ev);
+      NS_ASSERT (pos != m_bottom.end () && pos->key.m_uid == ev.key.m_uid);
+      if (pos - first < m_bottom.end () - pos)
+        {
+          std::copy_backward (first, pos, pos + 1);
+          m_bottomHead++;
+        }
+      else
+        {
+          m_bottom.erase (pos);
+        }
+      if (m_bottomHead == m_bottom.size ())
+        {
+          m_bottom.clear ();
+          m_bottomHead = 0;
+        }
+    }
+  else
+    {
+      uint32_t index = ev.impl->GetSchedulerIndex ();
+      if (index >= bucket->size () || (*bucket)[index].key.m_uid != ev.key.m_uid)
+        {
+          // the EventImpl is scheduled more than once and its index
+          // refers to another entry
+          NS_LOG_LOGIC ("stale index " << index << ", searching for uid " << ev.key.m_uid);
+          for (index = 0; index < bucket->size (); index++)
+            {
+              if ((*bucket)[index].key.m_uid == ev.key.m_uid)
+                {
+                  break;
+                }
+            }
+          NS_ASSERT (index < bucket->size ());
+        }
+      Event last = bucket->back ();
+      bucket->pop_back ();
+      if (index < bucket->size ())
+        {
+          (*bucket)[index] = last;
+          last.impl->SetSchedulerIndex (index);
+        }
+    }
+  m_nEvents--;
+}
+
+} // namespace ns3
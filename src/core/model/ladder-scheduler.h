@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh
+ * and Ian Li-Jin Thng (ACM TOMACS, 2005).  Events are kept in three
+ * tiers:
+ *
+ *  - Top: an unsorted array of the events beyond the current epoch.
+ *  - Ladder: up to 8 rungs of buckets.  When the ladder is empty, all
+ *    events of Top are spread over the buckets of a new rung, whose
+ *    width is chosen from the number of events and their time span,
+ *    and a new epoch begins.  When the next bucket of the lowest rung
+ *    holds more than 50 events, they are spread over a new, finer
+ *    rung instead of being sorted.
+ *  - Bottom: a small sorted array, from which events are dequeued.
+ *    It is refilled with the next non-empty bucket of the lowest rung.
+ *
+ * Buckets are unsorted arrays, and their storage is reused across
+ * epochs, so that enqueue and dequeue are O(1) amortized and no
+ * memory is allocated in steady state, even when the event times are
+ * very skewed.
+ *
+ * The container of an event is fully determined by its time stamp,
+ * and its index in the container is recorded in its EventImpl (see
+ * EventImpl::SetSchedulerIndex), so Remove() is O(1) except for
+ * events in Bottom, which are found by binary search.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Bucket type: unsorted array of Events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t start;               /**< Start time of the first bucket. */
+    uint64_t width;               /**< Duration of a bucket. */
+    uint64_t end;                 /**< End time of the last bucket. */
+    uint32_t nBuckets;            /**< Number of buckets in use. */
+    uint32_t current;             /**< Index of the next bucket to dequeue. */
+    std::vector<Bucket> buckets;  /**< The buckets.  Storage is kept for reuse. */
+  };
+
+  /**
+   * Get the start time of the next bucket to dequeue from a rung.
+   * Events before this time are in lower rungs or in Bottom.
+   *
+   * \param [in] rung The rung.
+   * \returns The start time of the current bucket.
+   */
+  inline uint64_t GetCurrentStart (const Rung &rung) const;
+  /**
+   * Find the bucket of a rung covering a time stamp.
+   * The last bucket extends to the end of the rung.
+   *
+   * \param [in] rung The rung.
+   * \param [in] ts The time stamp.
+   * \returns The bucket.
+   */
+  inline Bucket &GetBucket (Rung &rung, uint64_t ts);
+  /**
+   * Find the bucket of Top or of the ladder which holds events with a
+   * given time stamp.
+   *
+   * \param [in] ts The time stamp.
+   * \returns The bucket, or 0 if such events are in Bottom.
+   */
+  Bucket *FindBucket (uint64_t ts);
+  /**
+   * Append an event to an unsorted bucket.
+   *
+   * \param [in] bucket The bucket.
+   * \param [in] ev The event.
+   */
+  inline void Append (Bucket &bucket, const Scheduler::Event &ev);
+  /**
+   * Insert an event at its place in Bottom.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Add a new lowest rung and spread events over its buckets.
+   *
+   * \param [in] events The events, all between \p minTs and \p maxTs.
+   * \param [in] minTs The minimum time stamp of the events.
+   * \param [in] maxTs The maximum time stamp of the events.
+   * \param [in] end The end time of the new rung.
+   * \returns The new rung.
+   */
+  Rung &Spawn (const Bucket &events, uint64_t minTs, uint64_t maxTs, uint64_t end);
+  /** Move the next events from the ladder, or from Top, to the empty Bottom. */
+  void FillBottom (void);
+
+  /** Events beyond the current epoch. */
+  Bucket m_top;
+  /** Start time of Top. */
+  uint64_t m_topStart;
+  /** Lower bound of the time stamps in Top. */
+  uint64_t m_topMin;
+  /** Upper bound of the time stamps in Top. */
+  uint64_t m_topMax;
+  /** The rungs, from the coarsest one.  Storage is kept for reuse. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** The next events, sorted from m_bottomHead. */
+  Bucket m_bottom;
+  /** Index of the first event in Bottom. */
+  uint32_t m_bottomHead;
+  /** Number of events in queue. */
+  uint32_t m_nEvents;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
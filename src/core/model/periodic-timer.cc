@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "periodic-timer.h"
+#include "simulator.h"
+#include "simple-ref-count.h"
+#include "system-mutex.h"
+#include "assert.h"
+#include "log.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::PeriodicTimer class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PeriodicTimer");
+
+/**
+ * \ingroup timer
+ * The periodic timers with the same context, period and phase, which
+ * expire together in one event.
+ *
+ * The groups are registered by their key while they have an event
+ * scheduled, so that the timers started or woken later join them.  A
+ * group whose timers are all stopped or suspended lets its last event
+ * expire, as events scheduled with a context cannot be cancelled, and
+ * then leaves the registry.
+ */
+class PeriodicTimerGroup : public SimpleRefCount<PeriodicTimerGroup>
+{
+public:
+  /**
+   * Get the registered group of a key, creating it if needed.
+   *
+   * \param [in] context The context of the timers
+   * \param [in] period The period of the timers, in time steps
+   * \param [in] phase The start time of the timers modulo the period
+   * \returns The group
+   */
+  static Ptr<PeriodicTimerGroup> Get (uint32_t context, int64_t period, int64_t phase);
+
+  /**
+   * Add a timer, which first expires with the next event of the group.
+   * \param [in] timer The timer
+   */
+  void Add (PeriodicTimer *timer);
+  /**
+   * Remove a timer.
+   * \param [in] timer The timer
+   */
+  void Remove (PeriodicTimer *timer);
+
+private:
+  /** Group key:  the context, period and phase of the timers. */
+  struct Key
+  {
+    uint32_t context;   //!< The context
+    int64_t period;     //!< The period
+    int64_t phase;      //!< The phase
+    /**
+     * Lexicographic order.
+     * \param [in] o The other key
+     * \returns \c true if this key is before the other one
+     */
+    bool operator < (const Key &o) const
+    {
+      if (period != o.period)
+        {
+          return period < o.period;
+        }
+      if (phase != o.phase)
+        {
+          return phase < o.phase;
+        }
+      return context < o.context;
+    }
+  };
+  /** Container type of the registered groups. */
+  typedef std::map<Key, PeriodicTimerGroup *> Groups;
+
+  /**
+   * Constructor.
+   * \param [in] key The key of the group
+   */
+  PeriodicTimerGroup (const Key &key);
+
+  /** Expire the timers of the group and schedule the next event. */
+  void Expire (void);
+  /** Schedule the event of the next period. */
+  void ScheduleNext (void);
+  /** Remove the slots of the removed timers, keeping the order. */
+  void Compact (void);
+
+  /**
+   * \returns The registered groups, with the mutex protecting them.
+   * \param [out] mutex The mutex
+   */
+  static Groups & GetGroups (SystemMutex **mutex);
+  /** Forget all the groups and stop their timers, with the events of the simulation. */
+  static void Clear (void);
+
+  /** The key of the group. */
+  Key m_key;
+  /** The timers, in expiration order, with 0 for the removed ones. */
+  std::vector<PeriodicTimer *> m_timers;
+  /** Number of timers in m_timers. */
+  uint32_t m_nTimers;
+  /** Flag \c true while the timers expire. */
+  bool m_expiring;
+  /** Flag \c true if the group has an event scheduled, and is registered. */
+  bool m_scheduled;
+  /** Flag \c true if Clear is scheduled at Simulator::Destroy. */
+  static bool g_clearScheduled;
+};
+
+bool PeriodicTimerGroup::g_clearScheduled = false;
+
+PeriodicTimerGroup::Groups &
+PeriodicTimerGroup::GetGroups (SystemMutex **mutex)
+{
+  static Groups groups;
+  static SystemMutex groupsMutex;
+  *mutex = &groupsMutex;
+  return groups;
+}
+
+void
+PeriodicTimerGroup::Clear (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  SystemMutex *mutex;
+  Groups &groups = GetGroups (&mutex);
+  CriticalSection cs (*mutex);
+  for (Groups::iterator i = groups.begin (); i != groups.end (); i++)
+    {
+      PeriodicTimerGroup *group = i->second;
+      // the timers lose their events, so they are stopped
+      for (uint32_t j = 0; j < group->m_timers.size (); j++)
+        {
+          PeriodicTimer *timer = group->m_timers[j];
+          if (timer != 0)
+            {
+              timer->m_running = false;
+              timer->m_group = 0;
+            }
+        }
+      group->m_timers.clear ();
+      group->m_nTimers = 0;
+      group->m_scheduled = false;
+      group->Unref ();
+    }
+  groups.clear ();
+  g_clearScheduled = false;
+}
+
+Ptr<PeriodicTimerGroup>
+PeriodicTimerGroup::Get (uint32_t context, int64_t period, int64_t phase)
+{
+  Key key;
+  key.context = context;
+  key.period = period;
+  key.phase = phase;
+
+  SystemMutex *mutex;
+  Groups &groups = GetGroups (&mutex);
+  CriticalSection cs (*mutex);
+  Groups::iterator i = groups.find (key);
+  if (i != groups.end ())
+    {
+      return i->second;
+    }
+  return Ptr<PeriodicTimerGroup> (new PeriodicTimerGroup (key), false);
+}
+
+PeriodicTimerGroup::PeriodicTimerGroup (const Key &key)
+  : m_key (key),
+    m_nTimers (0),
+    m_expiring (false),
+    m_scheduled (false)
+{
+}
+
+void
+PeriodicTimerGroup::Add (PeriodicTimer *timer)
+{
+  timer->m_index = m_timers.size ();
+  m_timers.push_back (timer);
+  m_nTimers++;
+  if (!m_scheduled)
+    {
+      // registers the group, which then holds a reference to itself
+      SystemMutex *mutex;
+      Groups &groups = GetGroups (&mutex);
+      {
+        CriticalSection cs (*mutex);
+        std::pair<Groups::iterator, bool> inserted = groups.insert (std::make_pair (m_key, this));
+        NS_ASSERT (inserted.second);
+        Ref ();
+        if (!g_clearScheduled)
+          {
+            Simulator::ScheduleDestroy (&PeriodicTimerGroup::Clear);
+            g_clearScheduled = true;
+          }
+      }
+      m_scheduled = true;
+      ScheduleNext ();
+    }
+}
+
+void
+PeriodicTimerGroup::Remove (PeriodicTimer *timer)
+{
+  NS_ASSERT (m_timers[timer->m_index] == timer);
+  m_timers[timer->m_index] = 0;
+  m_nTimers--;
+  if (!m_expiring && m_timers.size () > 2 * m_nTimers + 16)
+    {
+      Compact ();
+    }
+}
+
+void
+PeriodicTimerGroup::Compact (void)
+{
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < m_timers.size (); i++)
+    {
+      if (m_timers[i] != 0)
+        {
+          m_timers[i]->m_index = n;
+          m_timers[n++] = m_timers[i];
+        }
+    }
+  m_timers.resize (n);
+}
+
+void
+PeriodicTimerGroup::ScheduleNext (void)
+{
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  // the first expiration time after now
+  int64_t next = now + m_key.period - (now - m_key.phase) % m_key.period;
+  Simulator::ScheduleWithContext (m_key.context, TimeStep (next - now),
+                                  &PeriodicTimerGroup::Expire, Ptr<PeriodicTimerGroup> (this));
+}
+
+void
+PeriodicTimerGroup::Expire (void)
+{
+  NS_LOG_FUNCTION (this << m_nTimers);
+  if (!m_scheduled)
+    {
+      // cleared by Simulator::Destroy
+      return;
+    }
+
+  m_expiring = true;
+  // the timers added while expiring wait for the next period
+  uint32_t size = m_timers.size ();
+  for (uint32_t i = 0; i < size; i++)
+    {
+      PeriodicTimer *timer = m_timers[i];
+      if (timer == 0)
+        {
+          continue;
+        }
+      bool hasWork = timer->m_callback ();
+      // the function may have stopped or destroyed the timer
+      if (!hasWork && m_timers[i] == timer)
+        {
+          m_timers[i] = 0;
+          m_nTimers--;
+          timer->m_group = 0;
+        }
+    }
+  m_expiring = false;
+  Compact ();
+
+  if (m_nTimers > 0)
+    {
+      ScheduleNext ();
+      return;
+    }
+
+  SystemMutex *mutex;
+  Groups &groups = GetGroups (&mutex);
+  {
+    CriticalSection cs (*mutex);
+    groups.erase (m_key);
+  }
+  m_scheduled = false;
+  // drop the reference held while registered; the event still holds one
+  Unref ();
+}
+
+PeriodicTimer::PeriodicTimer ()
+  : m_index (0),
+    m_running (false),
+    m_context (0),
+    m_period (0),
+    m_phase (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PeriodicTimer::~PeriodicTimer ()
+{
+  NS_LOG_FUNCTION (this);
+  Stop ();
+}
+
+void
+PeriodicTimer::SetFunction (Callback<bool> callback)
+{
+  NS_LOG_FUNCTION (this);
+  m_callback = callback;
+}
+
+void
+PeriodicTimer::Start (const Time &period)
+{
+  NS_LOG_FUNCTION (this << period);
+  NS_ASSERT_MSG (period.IsStrictlyPositive (), "The period must be positive");
+  NS_ASSERT_MSG (!m_callback.IsNull (), "No function set");
+  Stop ();
+
+  m_running = true;
+  m_context = Simulator::GetContext ();
+  m_period = period.GetTimeStep ();
+  m_phase = Simulator::Now ().GetTimeStep () % m_period;
+  m_group = PeriodicTimerGroup::Get (m_context, m_period, m_phase);
+  m_group->Add (this);
+}
+
+void
+PeriodicTimer::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_group != 0)
+    {
+      m_group->Remove (this);
+      m_group = 0;
+    }
+  m_running = false;
+}
+
+void
+PeriodicTimer::Wake (void)
+{
+  if (!IsSuspended ())
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_group = PeriodicTimerGroup::Get (m_context, m_period, m_phase);
+  m_group->Add (this);
+}
+
+bool
+PeriodicTimer::IsRunning (void) const
+{
+  return m_running;
+}
+
+bool
+PeriodicTimer::IsSuspended (void) const
+{
+  return m_running && m_group == 0;
+}
+
+Time
+PeriodicTimer::GetPeriod (void) const
+{
+  return TimeStep (m_period);
+}
+
+} // namespace ns3
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PERIODIC_TIMER_H
+#define PERIODIC_TIMER_H
+
+#include "nstime.h"
+#include "callback.h"
+#include "ptr.h"
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::PeriodicTimer class declaration.
+ */
+
+namespace ns3 {
+
+class PeriodicTimerGroup;
+
+/**
+ * \ingroup timer
+ * \brief A periodic timer sharing its events with the timers of the
+ * same period and phase.
+ *
+ * Components which run a periodic task forever, e.g., a tracer printing
+ * every second or a face polling its queue, each schedule one event per
+ * period.  Instead, all the periodic timers started in the same context
+ * with the same period and the same phase (the start time modulo the
+ * period) form a group, with one event per period for the whole group.
+ * The timers of a group expire in the order they were started, or woken.
+ *
+ * The function of the timer returns whether the owner has more work: if
+ * it returns false, the timer is suspended and takes no more part in the
+ * events of its group, until the owner calls Wake when some work
+ * arrives.  The timer then expires again at the next multiple of the
+ * period from its start time, as if it had never been suspended; a group
+ * with only suspended timers has no event at all.
+ *
+ * The timers are not thread-safe: with a parallel simulator, a timer must
+ * be started, woken and stopped from the partition of its context.
+ * Simulator::Destroy stops the timers which are not suspended, as their
+ * events are dropped.
+ *
+ * \see Timer for a one-shot timer.
+ */
+class PeriodicTimer
+{
+public:
+  /** Constructor. */
+  PeriodicTimer ();
+  /** Destructor, stopping the timer. */
+  ~PeriodicTimer ();
+
+  /**
+   * Set the function to execute when the timer expires.
+   *
+   * \param [in] callback The function, returning false when the owner
+   *             has no more work and the timer should be suspended
+   */
+  void SetFunction (Callback<bool> callback);
+
+  /**
+   * Set the function to execute when the timer expires.
+   *
+   * \tparam MEM_PTR \deduced Class method function type.
+   * \tparam OBJ_PTR \deduced Class type containing the function.
+   * \param [in] memPtr The member function pointer
+   * \param [in] objPtr The pointer to object
+   */
+  template <typename MEM_PTR, typename OBJ_PTR>
+  void SetFunction (MEM_PTR memPtr, OBJ_PTR objPtr);
+
+  /**
+   * Start the timer, stopping it first if it is running.
+   *
+   * \param [in] period The period:  the timer expires every period from now
+   */
+  void Start (const Time &period);
+  /** Stop the timer. */
+  void Stop (void);
+  /**
+   * Resume a timer suspended by its function, at the next expiration
+   * time of its period.  Does nothing if the timer is not suspended.
+   */
+  void Wake (void);
+
+  /** \returns \c true if the timer is started, even if suspended. */
+  bool IsRunning (void) const;
+  /** \returns \c true if the timer is suspended by its function. */
+  bool IsSuspended (void) const;
+  /** \returns The period of the timer. */
+  Time GetPeriod (void) const;
+
+private:
+  friend class PeriodicTimerGroup;
+
+  /**
+   * Copy constructor, not implemented: the groups refer to the timers.
+   * \param [in] o The other timer
+   */
+  PeriodicTimer (const PeriodicTimer &o);
+  /**
+   * Assignment operator, not implemented.
+   * \param [in] o The other timer
+   * \returns This timer
+   */
+  PeriodicTimer &operator = (const PeriodicTimer &o);
+
+  /** The function to execute when the timer expires. */
+  Callback<bool> m_callback;
+  /** The group of the timer, or 0 if the timer is stopped or suspended. */
+  Ptr<PeriodicTimerGroup> m_group;
+  /** Index of the timer in its group. */
+  uint32_t m_index;
+  /** Flag \c true if the timer is running. */
+  bool m_running;
+  /** Context the timer was started in. */
+  uint32_t m_context;
+  /** Period, in time steps. */
+  int64_t m_period;
+  /** Start time modulo the period, in time steps. */
+  int64_t m_phase;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+PeriodicTimer::SetFunction (MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+  SetFunction (MakeCallback (memPtr, objPtr));
+}
+
+} // namespace ns3
+
+#endif /* PERIODIC_TIMER_H */
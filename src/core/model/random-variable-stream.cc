@@ -33,6 +33,8 @@
 #include "log.h"
 #include "rng-stream.h"
 #include "rng-seed-manager.h"
+#include "system-mutex.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -48,6 +50,44 @@ NS_LOG_COMPONENT_DEFINE ("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED (RandomVariableStream);
 
+namespace {
+
+/**
+ * \ingroup randomvariable
+ * The existing streams, in creation order, to checkpoint their state.
+ *
+ * The streams are linked through their m_prevStream and m_nextStream
+ * members, so that creating a stream does not allocate.  These are
+ * plain pointers, still valid when streams with static storage are
+ * destroyed at exit.
+ */
+RandomVariableStream *g_firstStream = 0;
+/** The last created of the existing streams. */
+RandomVariableStream *g_lastStream = 0;
+
+/**
+ * \ingroup randomvariable
+ * Get the mutex protecting the list of the existing streams.
+ *
+ * The list is locked as the partitions of the multithreaded simulator
+ * create and destroy streams concurrently, e.g., with the models of
+ * their nodes.  Locking is uncontended in a sequential simulation, and
+ * cheap compared to the attribute construction of the stream.
+ *
+ * The mutex is deliberately never destroyed, as streams with static
+ * storage may be destroyed after the function-local statics.
+ *
+ * \returns The mutex.
+ */
+SystemMutex &
+GetStreamsMutex (void)
+{
+  static SystemMutex *mutex = new SystemMutex;
+  return *mutex;
+}
+
+} // anonymous namespace
+
 TypeId 
 RandomVariableStream::GetTypeId (void)
 {
@@ -72,14 +112,139 @@ RandomVariableStream::GetTypeId (void)
 }
 
 RandomVariableStream::RandomVariableStream()
-  : m_rng (0)
+  : m_rng (0),
+    m_streamIndex (0)
 {
   NS_LOG_FUNCTION (this);
+  CriticalSection cs (GetStreamsMutex ());
+  m_prevStream = g_lastStream;
+  m_nextStream = 0;
+  if (g_lastStream != 0)
+    {
+      g_lastStream->m_nextStream = this;
+    }
+  else
+    {
+      g_firstStream = this;
+    }
+  g_lastStream = this;
 }
 RandomVariableStream::~RandomVariableStream()
 {
   NS_LOG_FUNCTION (this);
   delete m_rng;
+  CriticalSection cs (GetStreamsMutex ());
+  if (m_prevStream != 0)
+    {
+      m_prevStream->m_nextStream = m_nextStream;
+    }
+  else
+    {
+      g_firstStream = m_nextStream;
+    }
+  if (m_nextStream != 0)
+    {
+      m_nextStream->m_prevStream = m_prevStream;
+    }
+  else
+    {
+      g_lastStream = m_prevStream;
+    }
+}
+
+/**
+ * \ingroup randomvariable
+ * Order of the streams in the checkpoints.
+ *
+ * \param [in] a A stream
+ * \param [in] b Another stream
+ * \returns \c true if \p a is before \p b
+ */
+static bool
+IsStreamBefore (const std::pair<uint64_t, RngStream *> &a,
+                const std::pair<uint64_t, RngStream *> &b)
+{
+  return a.first < b.first;
+}
+
+std::vector<std::pair<uint64_t, RngStream *> >
+RandomVariableStream::GetSortedRngStreams (void)
+{
+  CriticalSection cs (GetStreamsMutex ());
+
+  // by creation order, then stably by stream index
+  std::vector<std::pair<uint64_t, RngStream *> > sorted;
+  for (RandomVariableStream *i = g_firstStream; i != 0; i = i->m_nextStream)
+    {
+      if (i->m_rng != 0)
+        {
+          sorted.push_back (std::make_pair (i->m_streamIndex, i->m_rng));
+        }
+    }
+  std::stable_sort (sorted.begin (), sorted.end (), &IsStreamBefore);
+  return sorted;
+}
+
+std::vector<RandomVariableStream::RngState>
+RandomVariableStream::GetRngStates (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<std::pair<uint64_t, RngStream *> > sorted = GetSortedRngStreams ();
+  std::vector<RngState> states (sorted.size ());
+  for (uint32_t i = 0; i < sorted.size (); ++i)
+    {
+      states[i].stream = sorted[i].first;
+      sorted[i].second->GetState (states[i].state);
+    }
+  return states;
+}
+
+uint32_t
+RandomVariableStream::SetRngStates (const std::vector<RngState> &states)
+{
+  NS_LOG_FUNCTION (states.size ());
+  std::vector<std::pair<uint64_t, RngStream *> > sorted = GetSortedRngStreams ();
+
+  // The automatic stream indices also count the streams created before,
+  // e.g., by a previous simulation in the same process:  these streams
+  // are matched by order.
+  uint64_t base = ((1ULL)<<63);
+  uint32_t nFound = 0;
+  std::vector<std::pair<uint64_t, RngStream *> >::const_iterator stream = sorted.begin ();
+  std::vector<RngState>::const_iterator state = states.begin ();
+  while (state != states.end () && state->stream < base
+         && stream != sorted.end () && stream->first < base)
+    {
+      stream->second->SetState (state->state);
+      ++stream;
+      ++state;
+      ++nFound;
+    }
+  while (state != states.end () && state->stream < base)
+    {
+      ++state;
+    }
+  while (stream != sorted.end () && stream->first < base)
+    {
+      ++stream;
+    }
+
+  // merge the streams with a deterministic index
+  for (; state != states.end () && stream != sorted.end (); ++state)
+    {
+      while (stream != sorted.end () && stream->first < state->stream)
+        {
+          ++stream;
+        }
+      if (stream != sorted.end () && stream->first == state->stream)
+        {
+          stream->second->SetState (state->state);
+          ++stream;
+          ++nFound;
+        }
+    }
+  NS_LOG_LOGIC ("restored " << nFound << " of " << states.size () << " streams");
+  return nFound;
 }
 
 void
@@ -110,6 +275,7 @@ RandomVariableStream::SetStream (int64_t stream)
       m_rng = new RngStream (RngSeedManager::GetSeed (),
                              nextStream,
                              RngSeedManager::GetRun ());
+      m_streamIndex = nextStream;
     }
   else
     {
@@ -120,6 +286,7 @@ RandomVariableStream::SetStream (int64_t stream)
       m_rng = new RngStream (RngSeedManager::GetSeed (),
                              target,
                              RngSeedManager::GetRun ());
+      m_streamIndex = target;
     }
   m_stream = stream;
 }
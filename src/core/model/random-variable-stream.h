@@ -30,6 +30,8 @@
 #include "object.h"
 #include "attribute-helper.h"
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 /**
  * \file
@@ -149,6 +151,41 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief State of the generator of a stream.
+   */
+  struct RngState
+  {
+    /** The index of the stream, as allocated from the stream number. */
+    uint64_t stream;
+    /** The state vector of the generator. */
+    double state[6];
+  };
+
+  /**
+   * \brief Get the state of the generators of all the existing streams,
+   * e.g., to checkpoint a simulation.
+   *
+   * The states are sorted by stream index, then by creation order of
+   * the streams with the same index.
+   *
+   * \return The states.
+   */
+  static std::vector<RngState> GetRngStates (void);
+  /**
+   * \brief Set the state of the generators of the existing streams,
+   * e.g., to restore a checkpoint into the same scenario.
+   *
+   * The streams with an automatic stream number are matched in order,
+   * and the others by stream index, then by creation order:  the
+   * streams must be created in the same order as when the states were
+   * saved.
+   *
+   * \param [in] states The states, sorted as by GetRngStates.
+   * \return The number of streams found for the states.
+   */
+  static uint32_t SetRngStates (const std::vector<RngState> &states);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RNG stream.
@@ -156,6 +193,12 @@ protected:
   RngStream *Peek(void) const;
 
 private:
+  /**
+   * \brief Get the generators of the existing streams, in checkpoint order.
+   * \return The stream index and generator of each stream.
+   */
+  static std::vector<std::pair<uint64_t, RngStream *> > GetSortedRngStreams (void);
+
   /**
    * Copy constructor.  These objects are not copyable.
    *
@@ -186,6 +229,13 @@ private:
   /** The stream number for this RNG stream. */
   int64_t m_stream;
 
+  /** The index of the underlying RNG stream. */
+  uint64_t m_streamIndex;
+  /** The previously created of the existing streams. */
+  RandomVariableStream *m_prevStream;
+  /** The next created of the existing streams. */
+  RandomVariableStream *m_nextStream;
+
 };  // class RandomVariableStream
 
   
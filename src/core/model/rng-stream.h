@@ -71,6 +71,19 @@ public:
    */
   double RandU01 (void);
 
+  /**
+   * Get the state of the generator, e.g., to checkpoint it.
+   *
+   * \param [out] state The state vector.
+   */
+  void GetState (double state[6]) const;
+  /**
+   * Set the state of the generator, e.g., to restore a checkpoint.
+   *
+   * \param [in] state The state vector.
+   */
+  void SetState (const double state[6]);
+
 private:
   /**
    * Advance \p state of the RNG by leaps and bounds.
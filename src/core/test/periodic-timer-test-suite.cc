@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/periodic-timer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+class PeriodicTimerGroupTestCase : public TestCase
+{
+public:
+  PeriodicTimerGroupTestCase ();
+  virtual void DoRun (void);
+  bool Expire (uint32_t id);
+  void StartLate (void);
+  std::vector<std::pair<uint32_t, Time> > m_expirations;
+  PeriodicTimer m_timers[3];
+};
+
+PeriodicTimerGroupTestCase::PeriodicTimerGroupTestCase ()
+  : TestCase ("Check that periodic timers expire together with the same period and phase")
+{
+}
+
+bool
+PeriodicTimerGroupTestCase::Expire (uint32_t id)
+{
+  m_expirations.push_back (std::make_pair (id, Simulator::Now ()));
+  if (id == 1 && Simulator::Now () == MicroSeconds (20))
+    {
+      m_timers[1].Stop ();
+    }
+  return true;
+}
+
+static bool
+ExpireTimer (PeriodicTimerGroupTestCase *test, uint32_t id)
+{
+  return test->Expire (id);
+}
+
+void
+PeriodicTimerGroupTestCase::StartLate (void)
+{
+  m_timers[2].Start (MicroSeconds (10));
+}
+
+void
+PeriodicTimerGroupTestCase::DoRun (void)
+{
+  for (uint32_t id = 0; id < 3; id++)
+    {
+      m_timers[id].SetFunction (MakeBoundCallback (&ExpireTimer, this, id));
+    }
+  m_timers[1].Start (MicroSeconds (10));
+  m_timers[0].Start (MicroSeconds (10));
+  Simulator::Schedule (MicroSeconds (5), &PeriodicTimerGroupTestCase::StartLate, this);
+  Simulator::Stop (MicroSeconds (32));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_timers[0].IsRunning (), true, "Timer should be running");
+  NS_TEST_EXPECT_MSG_EQ (m_timers[1].IsRunning (), false, "Timer should be stopped");
+  m_timers[0].Stop ();
+  m_timers[2].Stop ();
+  Simulator::Destroy ();
+
+  // expiration order:  started order, then the other phase
+  std::pair<uint32_t, Time> expected[] = {
+    std::make_pair (1, MicroSeconds (10)),
+    std::make_pair (0, MicroSeconds (10)),
+    std::make_pair (2, MicroSeconds (15)),
+    std::make_pair (1, MicroSeconds (20)),
+    std::make_pair (0, MicroSeconds (20)),
+    std::make_pair (2, MicroSeconds (25)),
+    std::make_pair (0, MicroSeconds (30)),
+  };
+  uint32_t nExpected = sizeof (expected) / sizeof (expected[0]);
+  NS_TEST_ASSERT_MSG_EQ (m_expirations.size (), nExpected, "Wrong number of expirations");
+  for (uint32_t i = 0; i < nExpected; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_expirations[i].first, expected[i].first, "Wrong timer for expiration " << i);
+      NS_TEST_EXPECT_MSG_EQ (m_expirations[i].second, expected[i].second, "Wrong time for expiration " << i);
+    }
+}
+
+class PeriodicTimerSuspendTestCase : public TestCase
+{
+public:
+  PeriodicTimerSuspendTestCase ();
+  virtual void DoRun (void);
+  bool Expire (void);
+  void AddWork (void);
+  uint32_t m_work;
+  std::vector<Time> m_expirations;
+  PeriodicTimer m_timer;
+};
+
+PeriodicTimerSuspendTestCase::PeriodicTimerSuspendTestCase ()
+  : TestCase ("Check that a periodic timer without work is suspended until woken")
+{
+}
+
+bool
+PeriodicTimerSuspendTestCase::Expire (void)
+{
+  m_expirations.push_back (Simulator::Now ());
+  m_work--;
+  return m_work > 0;
+}
+
+void
+PeriodicTimerSuspendTestCase::AddWork (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_timer.IsSuspended (), true, "Timer should be suspended");
+  m_work++;
+  m_timer.Wake ();
+  NS_TEST_EXPECT_MSG_EQ (m_timer.IsSuspended (), false, "Timer should be woken");
+}
+
+void
+PeriodicTimerSuspendTestCase::DoRun (void)
+{
+  m_work = 2;
+  m_timer.SetFunction (&PeriodicTimerSuspendTestCase::Expire, this);
+  m_timer.Start (MicroSeconds (10));
+  Simulator::Schedule (MicroSeconds (43), &PeriodicTimerSuspendTestCase::AddWork, this);
+  Simulator::Run ();
+
+  // no more events once suspended
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MicroSeconds (50), "Events after the last expiration");
+  NS_TEST_EXPECT_MSG_EQ (m_timer.IsSuspended (), true, "Timer should be suspended");
+  m_timer.Stop ();
+  NS_TEST_EXPECT_MSG_EQ (m_timer.IsRunning (), false, "Timer should be stopped");
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_expirations.size (), 3, "Wrong number of expirations");
+  NS_TEST_EXPECT_MSG_EQ (m_expirations[0], MicroSeconds (10), "Wrong expiration time");
+  NS_TEST_EXPECT_MSG_EQ (m_expirations[1], MicroSeconds (20), "Wrong expiration time");
+  // aligned on the start time
+  NS_TEST_EXPECT_MSG_EQ (m_expirations[2], MicroSeconds (50), "Wrong expiration time");
+}
+
+class PeriodicTimerDestroyTestCase : public TestCase
+{
+public:
+  PeriodicTimerDestroyTestCase ();
+  virtual void DoRun (void);
+  bool Expire (void);
+  uint32_t m_nExpirations;
+  PeriodicTimer m_timers[2];
+};
+
+PeriodicTimerDestroyTestCase::PeriodicTimerDestroyTestCase ()
+  : TestCase ("Check that Simulator::Destroy stops the periodic timers")
+{
+}
+
+bool
+PeriodicTimerDestroyTestCase::Expire (void)
+{
+  m_nExpirations++;
+  return true;
+}
+
+void
+PeriodicTimerDestroyTestCase::DoRun (void)
+{
+  m_nExpirations = 0;
+  for (uint32_t id = 0; id < 2; id++)
+    {
+      m_timers[id].SetFunction (&PeriodicTimerDestroyTestCase::Expire, this);
+      m_timers[id].Start (MicroSeconds (10));
+    }
+  Simulator::Stop (MicroSeconds (25));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_nExpirations, 4, "Wrong number of expirations");
+  NS_TEST_EXPECT_MSG_EQ (m_timers[0].IsRunning (), false, "Timer should be stopped");
+  NS_TEST_EXPECT_MSG_EQ (m_timers[1].IsRunning (), false, "Timer should be stopped");
+
+  // the timers start again in the next simulation
+  m_timers[0].Start (MicroSeconds (10));
+  Simulator::Stop (MicroSeconds (25));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpirations, 6, "Wrong number of expirations");
+  NS_TEST_EXPECT_MSG_EQ (m_timers[0].IsRunning (), true, "Timer should be running");
+  m_timers[0].Stop ();
+  Simulator::Destroy ();
+}
+
+static class PeriodicTimerTestSuite : public TestSuite
+{
+public:
+  PeriodicTimerTestSuite ()
+    : TestSuite ("periodic-timer", UNIT)
+  {
+    AddTestCase (new PeriodicTimerGroupTestCase (), TestCase::QUICK);
+    AddTestCase (new PeriodicTimerSuspendTestCase (), TestCase::QUICK);
+    AddTestCase (new PeriodicTimerDestroyTestCase (), TestCase::QUICK);
+  }
+} g_periodicTimerTestSuite;
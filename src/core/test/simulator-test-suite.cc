@@ -23,6 +23,9 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/indexed-heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/random-variable-stream.h"
 
 using namespace ns3;
 
@@ -168,6 +171,169 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SimulatorOrderTestCase : public TestCase
+{
+public:
+  SimulatorOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  Time GetDelay (void);
+  void ScheduleEvent (void);
+  void Event (uint32_t seq);
+  ObjectFactory m_schedulerFactory;
+  Ptr<UniformRandomVariable> m_random;
+  std::vector<EventId> m_ids;
+  std::vector<bool> m_removed;
+  uint32_t m_nRemoved;
+  uint32_t m_nRun;
+  Time m_lastTime;
+  uint32_t m_lastSeq;
+  bool m_inOrder;
+  bool m_runRemoved;
+};
+
+SimulatorOrderTestCase::SimulatorOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that many events with skewed delays run in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+Time
+SimulatorOrderTestCase::GetDelay (void)
+{
+  switch (m_random->GetInteger (0, 3))
+    {
+    case 0:
+      // bursts of events with the same time stamp
+      return MilliSeconds (10 * m_random->GetInteger (0, 3));
+    case 1:
+      return NanoSeconds (m_random->GetInteger (0, 1000000));
+    case 2:
+      return Seconds (m_random->GetValue (2, 4));
+    default:
+      return Seconds (100);
+    }
+}
+
+void
+SimulatorOrderTestCase::ScheduleEvent (void)
+{
+  uint32_t seq = m_ids.size ();
+  m_ids.push_back (Simulator::Schedule (GetDelay (), &SimulatorOrderTestCase::Event, this, seq));
+  m_removed.push_back (false);
+}
+
+void
+SimulatorOrderTestCase::Event (uint32_t seq)
+{
+  // events with the same time stamp run in the order they were scheduled
+  if (Now () < m_lastTime || (Now () == m_lastTime && seq < m_lastSeq))
+    {
+      m_inOrder = false;
+    }
+  if (m_removed[seq])
+    {
+      m_runRemoved = true;
+    }
+  m_lastTime = Now ();
+  m_lastSeq = seq;
+  m_nRun++;
+
+  if (m_ids.size () < 20000)
+    {
+      ScheduleEvent ();
+      ScheduleEvent ();
+    }
+  uint32_t victim = m_random->GetInteger (0, m_ids.size () - 1);
+  if (!m_ids[victim].IsExpired ())
+    {
+      Simulator::Remove (m_ids[victim]);
+      m_removed[victim] = true;
+      m_nRemoved++;
+    }
+}
+
+void
+SimulatorOrderTestCase::DoRun (void)
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_nRemoved = 0;
+  m_nRun = 0;
+  m_lastTime = Seconds (0);
+  m_lastSeq = 0;
+  m_inOrder = true;
+  m_runRemoved = false;
+
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      ScheduleEvent ();
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_inOrder, true, "Events did not run in order");
+  NS_TEST_EXPECT_MSG_EQ (m_runRemoved, false, "Removed event did run");
+  NS_TEST_EXPECT_MSG_EQ (m_nRun + m_nRemoved, m_ids.size (), "Some events did not run");
+
+  Simulator::Destroy ();
+}
+
+class SimulatorStopTestCase : public TestCase
+{
+public:
+  SimulatorStopTestCase ();
+  virtual void DoRun (void);
+  void Event (uint32_t seq);
+  std::vector<uint32_t> m_seqs;
+  EventId m_idRemoved;
+};
+
+SimulatorStopTestCase::SimulatorStopTestCase ()
+  : TestCase ("Check that Stop within events with the same time stamp leaves the next ones for Run")
+{
+}
+
+void
+SimulatorStopTestCase::Event (uint32_t seq)
+{
+  m_seqs.push_back (seq);
+  if (seq == 1)
+    {
+      Simulator::Remove (m_idRemoved);
+      Simulator::ScheduleNow (&SimulatorStopTestCase::Event, this, 5);
+      Simulator::Stop ();
+    }
+}
+
+void
+SimulatorStopTestCase::DoRun (void)
+{
+  for (uint32_t seq = 0; seq < 4; seq++)
+    {
+      EventId id = Simulator::Schedule (Seconds (1), &SimulatorStopTestCase::Event, this, seq);
+      if (seq == 2)
+        {
+          m_idRemoved = id;
+        }
+    }
+  Simulator::Schedule (Seconds (2), &SimulatorStopTestCase::Event, this, 4);
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_seqs.size (), 2, "Events ran after Stop");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (1), "Wrong stop time");
+  NS_TEST_EXPECT_MSG_EQ (m_idRemoved.IsExpired (), true, "Event was removed: it is now expired");
+
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_seqs.size (), 5, "Wrong number of events");
+  uint32_t expected[] = { 0, 1, 3, 5, 4 };
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_seqs[i], expected[i], "Events did not run in order");
+    }
+
+  Simulator::Destroy ();
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -475,5 +641,24 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (IndexedHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (IndexedHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorOrderTestCase (factory), TestCase::QUICK);
+
+    AddTestCase (new SimulatorStopTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
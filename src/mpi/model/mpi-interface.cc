@@ -27,6 +27,7 @@
 
 #include "null-message-mpi-interface.h"
 #include "granted-time-window-mpi-interface.h"
+#include "shared-memory-interface.h"
 
 namespace ns3 {
 
@@ -72,6 +73,19 @@ MpiInterface::IsEnabled ()
     }
 }
 
+bool
+MpiInterface::IsLocal (uint32_t systemId)
+{
+  if (g_parallelCommunicationInterface)
+    {
+      return g_parallelCommunicationInterface->IsLocal (systemId);
+    }
+  else
+    {
+      return true;
+    }
+}
+
 void
 MpiInterface::Enable (int* pargc, char*** pargv)
 {
@@ -94,6 +108,11 @@ MpiInterface::Enable (int* pargc, char*** pargv)
           g_parallelCommunicationInterface = new GrantedTimeWindowMpiInterface ();
           useDefault = false;
         }
+      else if (simulationType.compare ("ns3::MultithreadedSimulatorImpl") == 0)
+        {
+          g_parallelCommunicationInterface = new SharedMemoryInterface ();
+          useDefault = false;
+        }
     }
 
   // User did not specify a valid parallel simulator; use the default.
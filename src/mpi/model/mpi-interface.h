@@ -70,6 +70,15 @@ public:
    * \return true if parallel communication is enabled
    */
   static bool IsEnabled ();
+  /**
+   * \param systemId system id of a node
+   * \return true if the nodes with this system id are simulated by
+   *         this process, so that links between them do not need a
+   *         remote channel
+   *
+   * When running a sequential simulation this will return true.
+   */
+  static bool IsLocal (uint32_t systemId);
   /**
    * \param pargc number of command line arguments
    * \param pargv command line arguments
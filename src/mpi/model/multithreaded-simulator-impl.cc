@@ -0,0 +1,1017 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "mpi-interface.h"
+#include "mpi-receiver.h"
+
+#include "ns3/simulator.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/system-thread.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/nstime.h"
+#include "ns3/tag.h"
+#include "ns3/nix-vector.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+/** Time stamp of a partition with no event to execute. */
+const uint64_t MAX_TS = 0x7fffffffffffffffULL;
+/** Number of messages in a block of a MessageQueue. */
+const uint32_t BLOCK_SIZE = 256;
+/** Number of tests of a barrier before a waiting thread yields. */
+const uint32_t SPIN_COUNT = 4096;
+
+/** The simulator, for SendPacket. */
+MultithreadedSimulatorImpl *g_simulator = 0;
+
+/**
+ * \param p a packet
+ * \return a copy of the bytes, tags and nix vector of the packet,
+ * which shares no data with it
+ */
+Ptr<Packet>
+CopyPacket (Ptr<const Packet> p)
+{
+  static thread_local std::vector<uint8_t> buffer;
+  uint32_t size = p->GetSize ();
+  buffer.resize (std::max<uint32_t> (size, 1));
+  p->CopyData (&buffer[0], size);
+  Ptr<Packet> copy = Create<Packet> (&buffer[0], size);
+
+  PacketTagIterator i = p->GetPacketTagIterator ();
+  while (i.HasNext ())
+    {
+      PacketTagIterator::Item item = i.Next ();
+      Callback<ObjectBase *> constructor = item.GetTypeId ().GetConstructor ();
+      Tag *tag = dynamic_cast<Tag *> (constructor ());
+      NS_ASSERT (tag != 0);
+      item.GetTag (*tag);
+      copy->AddPacketTag (*tag);
+      delete tag;
+    }
+  ByteTagIterator j = p->GetByteTagIterator ();
+  while (j.HasNext ())
+    {
+      ByteTagIterator::Item item = j.Next ();
+      Callback<ObjectBase *> constructor = item.GetTypeId ().GetConstructor ();
+      Tag *tag = dynamic_cast<Tag *> (constructor ());
+      NS_ASSERT (tag != 0);
+      item.GetTag (*tag);
+      copy->AddByteTag (*tag, item.GetStart (), item.GetEnd ());
+      delete tag;
+    }
+  Ptr<NixVector> nixVector = p->GetNixVector ();
+  if (nixVector != 0)
+    {
+      copy->SetNixVector (nixVector->Copy ());
+    }
+  return copy;
+}
+
+} // unnamed namespace
+
+/** A packet sent to another partition. */
+struct MultithreadedSimulatorImpl::Message
+{
+  uint64_t ts;              //!< Time stamp of the reception
+  uint32_t node;            //!< Destination node
+  MpiReceiver *receiver;    //!< Destination device
+  Ptr<Packet> packet;       //!< The packet
+};
+
+/**
+ * Unbounded queue of messages from one partition to another one.
+ *
+ * Push is only called by the thread of the source partition and Pop
+ * by the thread of the destination partition, so the only shared
+ * state is the count of pushed messages, which publishes them.
+ */
+class MultithreadedSimulatorImpl::MessageQueue
+{
+public:
+  MessageQueue ();
+  ~MessageQueue ();
+  /**
+   * Append a message.
+   * \param ts time stamp of the reception
+   * \param node destination node
+   * \param receiver destination device
+   * \param packet the packet
+   */
+  void Push (uint64_t ts, uint32_t node, MpiReceiver *receiver, Ptr<Packet> packet);
+  /**
+   * Remove the first message.
+   * \param [out] message the message
+   * \return false if the queue is empty
+   */
+  bool Pop (Message &message);
+
+private:
+  /** A block of messages, in a linked list. */
+  struct Block
+  {
+    Message messages[BLOCK_SIZE];   //!< The messages
+    Block *next;                    //!< The next block, if any
+  };
+
+  Block *m_head;                    // Consumer: block of the first message
+  uint32_t m_headIndex;             // Consumer: index of the first message
+  uint64_t m_nPopped;               // Consumer: number of popped messages
+  Block *m_tail;                    // Producer: block of the last message
+  uint32_t m_tailIndex;             // Producer: index after the last message
+  std::atomic<uint64_t> m_nPushed;  // Number of pushed messages
+};
+
+MultithreadedSimulatorImpl::MessageQueue::MessageQueue ()
+  : m_headIndex (0),
+    m_nPopped (0),
+    m_tailIndex (0),
+    m_nPushed (0)
+{
+  m_head = new Block;
+  m_head->next = 0;
+  m_tail = m_head;
+}
+
+MultithreadedSimulatorImpl::MessageQueue::~MessageQueue ()
+{
+  while (m_head != 0)
+    {
+      Block *next = m_head->next;
+      delete m_head;
+      m_head = next;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::MessageQueue::Push (uint64_t ts, uint32_t node, MpiReceiver *receiver, Ptr<Packet> packet)
+{
+  if (m_tailIndex == BLOCK_SIZE)
+    {
+      Block *block = new Block;
+      block->next = 0;
+      m_tail->next = block;
+      m_tail = block;
+      m_tailIndex = 0;
+    }
+  Message &message = m_tail->messages[m_tailIndex];
+  message.ts = ts;
+  message.node = node;
+  message.receiver = receiver;
+  message.packet = packet;
+  m_tailIndex++;
+  // publish the message, and its block
+  m_nPushed.store (m_nPushed.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool
+MultithreadedSimulatorImpl::MessageQueue::Pop (Message &message)
+{
+  if (m_nPopped == m_nPushed.load (std::memory_order_acquire))
+    {
+      return false;
+    }
+  if (m_headIndex == BLOCK_SIZE)
+    {
+      Block *next = m_head->next;
+      delete m_head;
+      m_head = next;
+      m_headIndex = 0;
+    }
+  Message &first = m_head->messages[m_headIndex];
+  message = first;
+  first.packet = 0;
+  m_headIndex++;
+  m_nPopped++;
+  return true;
+}
+
+/**
+ * Barrier between the threads of the partitions.
+ *
+ * The rounds are short, so the waiting threads spin for a while
+ * before yielding the processor.
+ */
+class MultithreadedSimulatorImpl::Barrier
+{
+public:
+  /**
+   * \param n number of threads
+   */
+  Barrier (uint32_t n);
+  /**
+   * Wait until all the threads reach the barrier.  The memory writes of
+   * every thread before the barrier are visible to all the threads
+   * after it.
+   */
+  void Wait (void);
+
+private:
+  uint32_t m_n;
+  std::atomic<uint32_t> m_count;
+  std::atomic<uint32_t> m_generation;
+};
+
+MultithreadedSimulatorImpl::Barrier::Barrier (uint32_t n)
+  : m_n (n),
+    m_count (0),
+    m_generation (0)
+{
+}
+
+void
+MultithreadedSimulatorImpl::Barrier::Wait (void)
+{
+  uint32_t generation = m_generation.load (std::memory_order_acquire);
+  if (m_count.fetch_add (1, std::memory_order_acq_rel) + 1 == m_n)
+    {
+      m_count.store (0, std::memory_order_relaxed);
+      m_generation.store (generation + 1, std::memory_order_release);
+      return;
+    }
+  uint32_t spins = 0;
+  while (m_generation.load (std::memory_order_acquire) == generation)
+    {
+      if (++spins > SPIN_COUNT)
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+/** A partition which sends packets to another one. */
+struct MultithreadedSimulatorImpl::Input
+{
+  uint32_t source;          //!< The sending partition
+  uint64_t lookAhead;       //!< Smallest delay of the links from it
+  MessageQueue *queue;      //!< The messages from it
+};
+
+/** The state of the simulation of a system id. */
+struct MultithreadedSimulatorImpl::Partition
+{
+  uint32_t index;                     //!< System id
+  Ptr<Scheduler> events;              //!< The event list
+  uint32_t uid;                       //!< Next event unique id, during Run ()
+  uint32_t currentUid;                //!< Unique id of the current event
+  uint64_t currentTs;                 //!< Timestamp of the current event
+  uint32_t currentContext;            //!< Execution context
+  int unscheduledEvents;              //!< Number of events in the event list
+  bool stop;                          //!< Flag calling for the end of the simulation
+  uint64_t stopTs;                    //!< Time stamp after which the partition stops
+  std::vector<Input> inputs;          //!< Partitions with links to this one
+  /** Partitions from which a chain of links leads to this one, this
+      one included if it is on a cycle, with the smallest sum of the
+      delays along such a chain */
+  std::vector<std::pair<uint32_t, uint64_t> > sources;
+  std::vector<MessageQueue *> outputs; //!< Queues to the other partitions, or 0
+  std::atomic<uint64_t> nextTs;       //!< Time stamp of the next event, published at each round
+};
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::g_partition = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Mpi")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_nThreads (1),
+    // uid 0 is "invalid" events
+    // uid 1 is "now" events
+    // uid 2 is "destroy" events
+    m_uid (4),
+    m_running (false),
+    m_lookAheadDone (false),
+    m_barrier (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t size = std::max (MpiInterface::GetSize (), 1u);
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      Partition *partition = new Partition ();
+      partition->index = i;
+      partition->uid = 4;
+      partition->currentUid = 0;
+      partition->currentTs = 0;
+      partition->currentContext = 0xffffffff;
+      partition->unscheduledEvents = 0;
+      partition->stop = false;
+      partition->stopTs = MAX_TS;
+      partition->outputs.resize (size, 0);
+      partition->nextTs.store (0);
+      m_partitions.push_back (partition);
+    }
+  m_nActive[0].store (0);
+  m_nActive[1].store (0);
+  m_stopTs.store (MAX_TS);
+  g_simulator = this;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  if (g_simulator == this)
+    {
+      g_simulator = 0;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *partition = *i;
+      while (partition->events != 0 && !partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      partition->events = 0;
+      for (std::vector<Input>::iterator j = partition->inputs.begin (); j != partition->inputs.end (); ++j)
+        {
+          delete j->queue;
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+
+  if (MpiInterface::IsEnabled ())
+    {
+      MpiInterface::Destroy ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookAhead (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t size = m_partitions.size ();
+  uint32_t nNodes = NodeList::GetNNodes ();
+  m_nodePartition.resize (nNodes);
+  m_receivers.resize (nNodes);
+  m_nThreads = 1;
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      uint32_t systemId = NodeList::GetNode (i)->GetSystemId ();
+      NS_ABORT_MSG_IF (systemId >= size, "Node " << i << " has system id " << systemId
+                       << " but there are only " << size << " threads; "
+                       "call MpiInterface::Enable and set the \"ThreadCount\" global value");
+      m_nodePartition[i] = systemId;
+      m_nThreads = std::max (m_nThreads, systemId + 1);
+    }
+
+  // the system ids may have been changed after events were scheduled
+  // for the nodes, e.g., by a topology partitioner: move these events
+  // to the partitions of their nodes, with their uid so that their
+  // EventIds stay valid
+  for (uint32_t p = 0; p < size; ++p)
+    {
+      Partition &partition = *m_partitions[p];
+      std::vector<Scheduler::Event> events;
+      while (!partition.events->IsEmpty ())
+        {
+          events.push_back (partition.events->RemoveNext ());
+        }
+      for (std::vector<Scheduler::Event>::iterator ev = events.begin (); ev != events.end (); ++ev)
+        {
+          uint32_t context = ev->key.m_context;
+          if (context < nNodes && m_nodePartition[context] != p)
+            {
+              Partition &destination = *m_partitions[m_nodePartition[context]];
+              partition.unscheduledEvents--;
+              destination.unscheduledEvents++;
+              destination.events->Insert (*ev);
+            }
+          else
+            {
+              partition.events->Insert (*ev);
+            }
+        }
+    }
+
+  // smallest delay of the links from partition q to partition p
+  std::vector<std::vector<uint64_t> > lookAhead (size, std::vector<uint64_t> (size, MAX_TS));
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      Ptr<Node> node = NodeList::GetNode (i);
+      uint32_t systemId = m_nodePartition[i];
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<NetDevice> device = node->GetDevice (j);
+          Ptr<MpiReceiver> receiver = device->GetObject<MpiReceiver> ();
+          if (receiver != 0)
+            {
+              std::vector<Receiver> &receivers = m_receivers[i];
+              if (receivers.size () <= device->GetIfIndex ())
+                {
+                  Receiver none = { systemId, 0 };
+                  receivers.resize (device->GetIfIndex () + 1, none);
+                }
+              receivers[device->GetIfIndex ()].receiver = PeekPointer (receiver);
+            }
+
+          Ptr<Channel> channel = device->GetChannel ();
+          if (!device->IsPointToPoint () || channel == 0 || channel->GetNDevices () != 2)
+            {
+              continue;
+            }
+          Ptr<NetDevice> remote = channel->GetDevice (0) == device ? channel->GetDevice (1) : channel->GetDevice (0);
+          uint32_t remoteSystemId = remote->GetNode ()->GetSystemId ();
+          if (remoteSystemId == systemId)
+            {
+              continue;
+            }
+          TimeValue delay;
+          if (!channel->GetAttributeFailSafe ("Delay", delay))
+            {
+              NS_LOG_WARN ("Channel " << channel << " has no delay, the lookahead will be 0");
+            }
+          uint64_t &l = lookAhead[remoteSystemId][systemId];
+          l = std::min (l, static_cast<uint64_t> (delay.Get ().GetTimeStep ()));
+        }
+    }
+
+  for (uint32_t p = 0; p < size; ++p)
+    {
+      for (uint32_t q = 0; q < size; ++q)
+        {
+          if (lookAhead[q][p] == MAX_TS)
+            {
+              continue;
+            }
+          NS_LOG_LOGIC ("lookahead from " << q << " to " << p << ": " << TimeStep (lookAhead[q][p]));
+          Input input = { q, lookAhead[q][p], new MessageQueue () };
+          m_partitions[p]->inputs.push_back (input);
+          m_partitions[q]->outputs[p] = input.queue;
+        }
+    }
+
+  // a partition without events may receive a packet and forward it,
+  // so the bound of a partition depends on every partition from which
+  // a chain of links leads to it, at the smallest sum of the delays
+  // along the chain (Floyd-Warshall)
+  std::vector<std::vector<uint64_t> > distance = lookAhead;
+  for (uint32_t k = 0; k < size; ++k)
+    {
+      for (uint32_t q = 0; q < size; ++q)
+        {
+          if (distance[q][k] == MAX_TS)
+            {
+              continue;
+            }
+          for (uint32_t p = 0; p < size; ++p)
+            {
+              if (distance[k][p] != MAX_TS)
+                {
+                  distance[q][p] = std::min (distance[q][p], distance[q][k] + distance[k][p]);
+                }
+            }
+        }
+    }
+  for (uint32_t p = 0; p < size; ++p)
+    {
+      for (uint32_t q = 0; q < size; ++q)
+        {
+          if (distance[q][p] != MAX_TS)
+            {
+              m_partitions[p]->sources.push_back (std::make_pair (q, distance[q][p]));
+            }
+        }
+    }
+  m_lookAheadDone = true;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_lookAheadDone)
+    {
+      CalculateLookAhead ();
+    }
+  // the uids of the partitions follow the ones allocated before
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      m_partitions[i]->stop = false;
+      m_partitions[i]->stopTs = MAX_TS;
+      m_partitions[i]->uid = m_uid;
+    }
+  m_stopTs.store (MAX_TS);
+  NS_LOG_LOGIC ("running " << m_nThreads << " threads");
+
+  m_running = true;
+  m_barrier = new Barrier (m_nThreads);
+  m_nActive[0].store (0);
+  m_nActive[1].store (0);
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < m_nThreads; ++i)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeBoundCallback (&MultithreadedSimulatorImpl::RunThread, this, i));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+  RunPartition (0);
+  for (std::vector<Ptr<SystemThread> >::iterator i = threads.begin (); i != threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  delete m_barrier;
+  m_barrier = 0;
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      m_uid = std::max (m_uid, m_partitions[i]->uid);
+    }
+  m_running = false;
+}
+
+void
+MultithreadedSimulatorImpl::RunThread (MultithreadedSimulatorImpl *simulator, uint32_t index)
+{
+  simulator->RunPartition (index);
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+
+  Partition &partition = *m_partitions[index];
+  g_partition = &partition;
+  uint32_t round = 0;
+  while (true)
+    {
+      // the stops requested by the partitions in the previous round,
+      // read while no partition executes events
+      partition.stopTs = std::min (partition.stopTs, m_stopTs.load (std::memory_order_relaxed));
+      ReceiveMessages (partition);
+      uint64_t nextTs = NextTs (partition);
+      partition.nextTs.store (nextTs, std::memory_order_relaxed);
+      if (nextTs != MAX_TS)
+        {
+          m_nActive[round & 1].fetch_add (1, std::memory_order_relaxed);
+        }
+      m_barrier->Wait ();
+
+      if (m_nActive[round & 1].load (std::memory_order_relaxed) == 0)
+        {
+          // no events, and so no messages, left
+          break;
+        }
+      if (index == 0)
+        {
+          // every thread has read the count of the previous round
+          m_nActive[(round + 1) & 1].store (0, std::memory_order_relaxed);
+        }
+      round++;
+
+      // no message can be received before this time stamp: the messages
+      // of the previous round are in the next time stamps, and the
+      // partitions without events only send packets caused by the
+      // events of the others
+      uint64_t bound = partition.stopTs;
+      for (std::vector<std::pair<uint32_t, uint64_t> >::const_iterator i = partition.sources.begin ();
+           i != partition.sources.end (); ++i)
+        {
+          uint64_t ts = m_partitions[i->first]->nextTs.load (std::memory_order_relaxed);
+          if (ts != MAX_TS)
+            {
+              bound = std::min (bound, ts + i->second);
+            }
+        }
+      while (!partition.stop && !partition.events->IsEmpty ()
+             && partition.events->PeekNext ().key.m_ts <= bound)
+        {
+          ProcessOneEvent (partition);
+        }
+      m_barrier->Wait ();
+    }
+  NS_LOG_LOGIC ("partition " << index << " done after " << round << " rounds");
+  if (partition.stopTs != MAX_TS)
+    {
+      partition.stop = true;
+    }
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  NS_ASSERT (!partition.events->IsEmpty () || partition.unscheduledEvents == 0);
+  g_partition = 0;
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveMessages (Partition &partition)
+{
+  Message message;
+  for (std::vector<Input>::const_iterator i = partition.inputs.begin (); i != partition.inputs.end (); ++i)
+    {
+      while (i->queue->Pop (message))
+        {
+          NS_ASSERT_MSG (message.ts >= partition.currentTs, "Causality error in partition " << partition.index);
+          Insert (partition, message.ts, message.node,
+                  MakeEvent (&MpiReceiver::Receive, message.receiver, message.packet));
+        }
+    }
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs (const Partition &partition) const
+{
+  if (partition.stop || partition.events->IsEmpty ()
+      || partition.events->PeekNext ().key.m_ts > partition.stopTs)
+    {
+      return MAX_TS;
+    }
+  return partition.events->PeekNext ().key.m_ts;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition &partition)
+{
+  Scheduler::Event next = partition.events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition.currentTs);
+  partition.unscheduledEvents--;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  partition.currentTs = next.key.m_ts;
+  partition.currentContext = next.key.m_context;
+  partition.currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  // before Run (), the uids are unique across the partitions, as events
+  // may then move to another partition
+  ev.key.m_uid = m_running ? partition.uid++ : m_uid++;
+  partition.unscheduledEvents++;
+  partition.events->Insert (ev);
+  return ev.key.m_uid;
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  return g_partition != 0 ? *g_partition : *m_partitions[0];
+}
+
+MultithreadedSimulatorImpl::Partition &
+MultithreadedSimulatorImpl::GetEventPartition (const EventId &id) const
+{
+  if (g_partition != 0)
+    {
+      return *g_partition;
+    }
+  if (id.GetContext () < m_nodePartition.size ())
+    {
+      return *m_partitions[m_nodePartition[id.GetContext ()]];
+    }
+  return *m_partitions[0];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNodePartition (uint32_t context)
+{
+  if (context >= m_nodePartition.size () && context < NodeList::GetNNodes ())
+    {
+      for (uint32_t i = m_nodePartition.size (); i <= context; ++i)
+        {
+          uint32_t systemId = NodeList::GetNode (i)->GetSystemId ();
+          NS_ABORT_MSG_IF (systemId >= m_partitions.size (), "Node " << i << " has system id " << systemId
+                           << " but there are only " << m_partitions.size () << " threads; "
+                           "call MpiInterface::Enable and set the \"ThreadCount\" global value");
+          m_nodePartition.push_back (systemId);
+        }
+    }
+  return context < m_nodePartition.size () ? m_nodePartition[context] : 0;
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      if ((*i)->events != 0)
+        {
+          while (!(*i)->events->IsEmpty ())
+            {
+              Scheduler::Event next = (*i)->events->RemoveNext ();
+              scheduler->Insert (next);
+            }
+        }
+      (*i)->events = scheduler;
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  for (uint32_t i = 0; i < m_nThreads; ++i)
+    {
+      if (!m_partitions[i]->stop && !m_partitions[i]->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId () const
+{
+  return g_partition != 0 ? g_partition->index : 0;
+}
+
+void
+MultithreadedSimulatorImpl::RequestStop (uint64_t ts)
+{
+  GetCurrentPartition ().stopTs = std::min (GetCurrentPartition ().stopTs, ts);
+  uint64_t current = m_stopTs.load (std::memory_order_relaxed);
+  while (ts < current
+         && !m_stopTs.compare_exchange_weak (current, ts, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Partition &partition = GetCurrentPartition ();
+  partition.stop = true;
+  if (m_running)
+    {
+      // the other partitions execute their events up to now
+      RequestStop (partition.currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+
+  if (m_running)
+    {
+      RequestStop (GetCurrentPartition ().currentTs + delay.GetTimeStep ());
+      return;
+    }
+  // stop every partition
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Insert (**i, (*i)->currentTs + delay.GetTimeStep (), 0xffffffff, MakeEvent (&Simulator::Stop));
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+
+  Partition &partition = GetCurrentPartition ();
+  Time tAbsolute = delay + TimeStep (partition.currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (partition.currentTs));
+  uint64_t ts = static_cast<uint64_t> (tAbsolute.GetTimeStep ());
+  uint32_t uid = Insert (partition, ts, partition.currentContext, event);
+  return EventId (event, ts, partition.currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+
+  // during Run, a partition only schedules events for its own nodes
+  Partition &partition = m_running ? GetCurrentPartition () : *m_partitions[GetNodePartition (context)];
+  Insert (partition, partition.currentTs + delay.GetTimeStep (), context, event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+
+  Partition &partition = GetCurrentPartition ();
+  uint32_t uid = Insert (partition, partition.currentTs, partition.currentContext, event);
+  return EventId (event, partition.currentTs, partition.currentContext, uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+
+  CriticalSection cs (m_destroyMutex);
+  EventId id (Ptr<EventImpl> (event, false), GetCurrentPartition ().currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  return TimeStep (GetCurrentPartition ().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetEventPartition (id).currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition &partition = GetEventPartition (id);
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition.events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (m_destroyMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  const Partition &partition = GetEventPartition (id);
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < partition.currentTs
+      || (id.GetTs () == partition.currentTs
+          && id.GetUid () <= partition.currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return GetCurrentPartition ().currentContext;
+}
+
+void
+MultithreadedSimulatorImpl::SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev)
+{
+  MultithreadedSimulatorImpl *simulator = g_simulator;
+  NS_ASSERT_MSG (simulator != 0 && g_partition != 0, "Packets can only be sent to other partitions during Run ()");
+  NS_ASSERT (node < simulator->m_receivers.size () && dev < simulator->m_receivers[node].size ());
+  const Receiver &receiver = simulator->m_receivers[node][dev];
+  NS_ASSERT (receiver.receiver != 0);
+
+  Partition &partition = *g_partition;
+  Ptr<Packet> copy = CopyPacket (p);
+  uint64_t ts = rxTime.GetTimeStep ();
+  if (receiver.partition == partition.index)
+    {
+      simulator->Insert (partition, ts, node, MakeEvent (&MpiReceiver::Receive, receiver.receiver, copy));
+    }
+  else
+    {
+      NS_ASSERT (partition.outputs[receiver.partition] != 0);
+      partition.outputs[receiver.partition]->Push (ts, node, receiver.receiver, copy);
+    }
+}
+
+} // namespace ns3
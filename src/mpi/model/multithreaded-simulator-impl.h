@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/system-mutex.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+class MpiReceiver;
+
+/**
+ * \ingroup simulator
+ * \ingroup mpi
+ *
+ * \brief Parallel simulator implementation using one thread per
+ * system id, on a single host
+ *
+ * The nodes are partitioned by system id, as for the
+ * DistributedSimulatorImpl, but all the partitions are simulated by
+ * the same process, each one by its own thread with its own event
+ * list.  Partition 0 is simulated by the thread which calls Run ().
+ * Select it with
+ *
+ * \code
+ *   GlobalValue::Bind ("SimulatorImplementationType",
+ *                      StringValue ("ns3::MultithreadedSimulatorImpl"));
+ *   MpiInterface::Enable (&argc, &argv);
+ * \endcode
+ *
+ * and unlike with MPI, install the applications of all the nodes.
+ *
+ * The synchronization is conservative and proceeds in rounds
+ * separated by barriers.  At each round, every partition receives the
+ * packets sent to it in the previous round and publishes the time
+ * stamp of its next event; a partition may then execute all its events
+ * up to the smallest sum, over the partitions from which a chain of
+ * point-to-point links leads to it, itself included if it is on a
+ * cycle, of their next time stamp and of the smallest sum of the link
+ * delays along such a chain.  A partition without events thus does not
+ * let its neighbours run ahead of the packets it may forward.  The
+ * lookahead is computed per pair of partitions, and partitions which
+ * are not connected do not constrain each other.
+ *
+ * Packets which cross partitions are put by the sending thread in a
+ * lock-free single producer, single consumer queue per pair of
+ * partitions, and are scheduled by the receiving thread at the start
+ * of the next round.  They are not serialized: the queue carries a
+ * Ptr<Packet> to a copy of the bytes and tags of the packet, which
+ * shares no reference-counted data with the original one.
+ *
+ * The simulation is deterministic: the events executed at each round
+ * only depend on the state at the start of the round.
+ *
+ * Simulator::Stop called by a partition during Run () stops all the
+ * partitions after their events up to the requested time.  The other
+ * partitions see the request at the next round: a partition which
+ * already went past the requested time in the current round stops at
+ * the end of it.
+ *
+ * Restrictions:
+ *  - the topology must not change once Run () has been called, but the
+ *    system ids of the nodes may be changed until then;
+ *  - the events of a node must be scheduled either with its context or
+ *    from another event of the same partition; events scheduled
+ *    without context before Run () go to partition 0;
+ *  - objects of a partition must not be accessed from another one,
+ *    e.g., by sharing a trace sink between nodes of different
+ *    partitions;
+ *  - the packet metadata (see Packet::EnablePrinting) is not carried
+ *    to other partitions.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  MultithreadedSimulatorImpl ();
+  ~MultithreadedSimulatorImpl ();
+
+  // virtual from SimulatorImpl
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &delay);
+  virtual EventId Schedule (Time const &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \param p packet to send
+   * \param rxTime received time at destination node
+   * \param node destination node
+   * \param dev destination device
+   *
+   * Copy a packet into the queue to the partition of the specified
+   * node.  Must be called from a thread running a partition.
+   */
+  static void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+
+private:
+  struct Message;
+  struct Input;
+  struct Partition;
+  class MessageQueue;
+  class Barrier;
+
+  /** The device of a node which receives packets from other partitions. */
+  struct Receiver
+  {
+    uint32_t partition;       //!< Partition of the node
+    MpiReceiver *receiver;    //!< MpiReceiver aggregated to the device
+  };
+
+  virtual void DoDispose (void);
+  /**
+   * Assign the nodes to partitions, and compute the lookahead and
+   * create the message queues between the partitions.
+   */
+  void CalculateLookAhead (void);
+  /**
+   * Entry point of the threads of the partitions other than 0.
+   * \param simulator this simulator
+   * \param index the partition
+   */
+  static void RunThread (MultithreadedSimulatorImpl *simulator, uint32_t index);
+  /**
+   * Simulate a partition until all of them are finished.
+   * \param index the partition
+   */
+  void RunPartition (uint32_t index);
+  /**
+   * Schedule the packets received from other partitions.
+   * \param partition the partition
+   */
+  void ReceiveMessages (Partition &partition);
+  /**
+   * \param partition the partition
+   * \return time stamp of the next event, or of the maximum simulation
+   * time if the partition is stopped or empty
+   */
+  uint64_t NextTs (const Partition &partition) const;
+  /**
+   * Execute the next event of a partition.
+   * \param partition the partition
+   */
+  void ProcessOneEvent (Partition &partition);
+  /**
+   * Insert an event in the event list of a partition.
+   * \param partition the partition
+   * \param ts the time stamp
+   * \param context the context
+   * \param event the event
+   * \return the uid of the event
+   */
+  uint32_t Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * \return the partition of the calling thread, or partition 0
+   * outside of Run ()
+   */
+  Partition &GetCurrentPartition (void) const;
+  /**
+   * \param id an event
+   * \return the partition in which the event was scheduled
+   */
+  Partition &GetEventPartition (const EventId &id) const;
+  /**
+   * \param context a context
+   * \return the partition of the node with this context, or 0 if
+   * the context is not a node
+   */
+  uint32_t GetNodePartition (uint32_t context);
+  /**
+   * Stop all the partitions after the events up to a time stamp, from
+   * a partition during Run ().  The other partitions see the request
+   * at the start of the next round, and stop then if they already
+   * went past the time stamp.
+   * \param ts the time stamp
+   */
+  void RequestStop (uint64_t ts);
+
+  typedef std::list<EventId> DestroyEvents;
+
+  DestroyEvents m_destroyEvents;
+  mutable SystemMutex m_destroyMutex;     // Protects m_destroyEvents
+  std::vector<Partition *> m_partitions;  // One per system id
+  std::vector<uint32_t> m_nodePartition;  // Partition of each node
+  std::vector<std::vector<Receiver> > m_receivers; // Indexed by node and device
+  uint32_t m_nThreads;                    // Number of partitions with nodes
+  uint32_t m_uid;                         // Next event unique id, outside of Run ()
+  bool m_running;
+  bool m_lookAheadDone;
+  Barrier *m_barrier;
+  std::atomic<uint32_t> m_nActive[2];     // Partitions with events, per round parity
+  std::atomic<uint64_t> m_stopTs;         // Smallest stop time stamp requested during Run ()
+
+  static thread_local Partition *g_partition;  // Partition of the current thread
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
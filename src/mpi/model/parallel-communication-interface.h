@@ -69,6 +69,17 @@ public:
    * \return true if parallel communication is enabled
    */
   virtual bool IsEnabled () = 0;
+  /**
+   * \param systemId system id of a node
+   * \return true if the nodes with this system id are simulated by
+   * this process
+   *
+   * By default, a process only simulates its own system id.
+   */
+  virtual bool IsLocal (uint32_t systemId)
+  {
+    return systemId == GetSystemId ();
+  }
   /**
    * \param pargc number of command line arguments
    * \param pargv command line arguments
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "shared-memory-interface.h"
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SharedMemoryInterface");
+
+/**
+ * \ingroup mpi
+ * Number of threads of the MultithreadedSimulatorImpl.
+ */
+static GlobalValue g_threadCount =
+  GlobalValue ("ThreadCount",
+               "The number of threads, and so of system ids, of ns3::MultithreadedSimulatorImpl; "
+               "0 for one per processor core",
+               UintegerValue (0),
+               MakeUintegerChecker<uint32_t> ());
+
+SharedMemoryInterface::SharedMemoryInterface ()
+  : m_size (1),
+    m_enabled (false)
+{
+}
+
+void
+SharedMemoryInterface::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+SharedMemoryInterface::GetSystemId ()
+{
+  return Simulator::GetSystemId ();
+}
+
+uint32_t
+SharedMemoryInterface::GetSize ()
+{
+  return m_size;
+}
+
+bool
+SharedMemoryInterface::IsEnabled ()
+{
+  return m_enabled;
+}
+
+bool
+SharedMemoryInterface::IsLocal (uint32_t systemId)
+{
+  return true;
+}
+
+void
+SharedMemoryInterface::Enable (int* pargc, char*** pargv)
+{
+  NS_LOG_FUNCTION (this << pargc << pargv);
+
+  UintegerValue threadCount;
+  g_threadCount.GetValue (threadCount);
+  m_size = threadCount.Get ();
+  if (m_size == 0)
+    {
+      m_size = std::max (std::thread::hardware_concurrency (), 1u);
+    }
+  m_enabled = true;
+  NS_LOG_LOGIC ("using up to " << m_size << " threads");
+}
+
+void
+SharedMemoryInterface::Disable ()
+{
+  NS_LOG_FUNCTION (this);
+  m_enabled = false;
+}
+
+void
+SharedMemoryInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev)
+{
+  MultithreadedSimulatorImpl::SendPacket (p, rxTime, node, dev);
+}
+
+} // namespace ns3
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_SHARED_MEMORY_INTERFACE_H
+#define NS3_SHARED_MEMORY_INTERFACE_H
+
+#include <stdint.h>
+
+#include "ns3/nstime.h"
+#include "parallel-communication-interface.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Interface between ns-3 and the threads of a
+ * MultithreadedSimulatorImpl
+ *
+ * All the system ids are simulated by the same process, one thread
+ * each, so no MPI installation is needed.  The number of system ids
+ * is set by the "ThreadCount" global value, which defaults to the
+ * number of processor cores.
+ *
+ * Packets sent over a PointToPointRemoteChannel are passed to the
+ * thread of the destination node through a queue in memory.
+ */
+class SharedMemoryInterface : public ParallelCommunicationInterface
+{
+public:
+  SharedMemoryInterface ();
+
+  /**
+   * Nothing to release: the queues belong to the simulator.
+   */
+  virtual void Destroy ();
+  /**
+   * \return system id of the calling thread, or 0 outside of
+   * Simulator::Run ()
+   */
+  virtual uint32_t GetSystemId ();
+  /**
+   * \return number of threads (system ids)
+   */
+  virtual uint32_t GetSize ();
+  /**
+   * \return true once enabled
+   */
+  virtual bool IsEnabled ();
+  /**
+   * \param systemId system id of a node
+   * \return true: all the system ids are simulated by this process
+   */
+  virtual bool IsLocal (uint32_t systemId);
+  /**
+   * \param pargc unused
+   * \param pargv unused
+   *
+   * Reads the number of threads from the "ThreadCount" global value
+   */
+  virtual void Enable (int* pargc, char*** pargv);
+  /**
+   * Resets m_enabled
+   */
+  virtual void Disable ();
+  /**
+   * \param p packet to send
+   * \param rxTime received time at destination node
+   * \param node destination node
+   * \param dev destination device
+   *
+   * Copy a packet into the queue to the thread of the specified node
+   */
+  virtual void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+
+private:
+  uint32_t m_size;
+  bool     m_enabled;
+};
+
+} // namespace ns3
+
+#endif /* NS3_SHARED_MEMORY_INTERFACE_H */
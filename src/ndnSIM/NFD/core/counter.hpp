@@ -86,6 +86,15 @@ public:
     return *this;
   }
   // postfix ++ operator is not provided because it's not needed
+
+  /** \brief increment the counter by the number of packets in a batch
+   */
+  PacketCounter&
+  operator+=(rep n)
+  {
+    m_value += n;
+    return *this;
+  }
 };
 
 /** \brief represents a counter of number of bytes
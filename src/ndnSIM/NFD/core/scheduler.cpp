@@ -28,16 +28,38 @@
 
 #include <boost/thread/tss.hpp>
 
+#include <mutex>
+
 namespace nfd {
 namespace scheduler {
 
-static boost::thread_specific_ptr<Scheduler> g_scheduler;
+static void
+keepScheduler(Scheduler*)
+{
+}
+
+// Under ns3::MultithreadedSimulatorImpl, each partition (system id) is simulated by its own
+// thread, and these threads end with each run while the events they scheduled may still be
+// pending.  The schedulers thus belong to the partitions, and a thread only caches the scheduler
+// of its partition, which it must not destroy when it ends.
+static std::vector<unique_ptr<Scheduler>> g_schedulers;
+static std::mutex g_schedulersMutex;
+static boost::thread_specific_ptr<Scheduler> g_scheduler(&keepScheduler);
 
 Scheduler&
 getGlobalScheduler()
 {
   if (g_scheduler.get() == nullptr) {
-    g_scheduler.reset(new Scheduler(*static_cast<boost::asio::io_service*>(nullptr)));
+    uint32_t systemId = ns3::Simulator::GetSystemId();
+
+    std::lock_guard<std::mutex> lock(g_schedulersMutex);
+    if (systemId >= g_schedulers.size()) {
+      g_schedulers.resize(systemId + 1);
+    }
+    if (g_schedulers[systemId] == nullptr) {
+      g_schedulers[systemId].reset(new Scheduler(*static_cast<boost::asio::io_service*>(nullptr)));
+    }
+    g_scheduler.reset(g_schedulers[systemId].get());
   }
 
   return *g_scheduler;
@@ -58,7 +80,10 @@ cancel(const EventId& eventId)
 void
 resetGlobalScheduler()
 {
+  // the threads of the partitions have ended with the run, together with their cached pointers
   g_scheduler.reset();
+  std::lock_guard<std::mutex> lock(g_schedulersMutex);
+  g_schedulers.clear();
 }
 
 ScopedEventId::ScopedEventId()
@@ -49,6 +49,11 @@ schedule(const time::nanoseconds& after, const Scheduler::Event& event);
 void
 cancel(const EventId& eventId);
 
+/** \brief get the scheduler of the current partition of the simulation
+ *
+ *  There is one scheduler per ns-3 system id, so that under ns3::MultithreadedSimulatorImpl
+ *  each partition uses its own scheduler, which outlives the threads running the partition.
+ */
 Scheduler&
 getGlobalScheduler();
 
@@ -138,6 +138,20 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt)
     BOOST_ASSERT(!frags.front().has<lp::FragCountField>());
   }
 
+  if (frags.size() == 1) {
+    Transport::Packet tp(frags.front().wireEncode());
+    if (mtu != MTU_UNLIMITED && tp.packet.size() > static_cast<size_t>(mtu)) {
+      ++this->nOutOverMtu;
+      NFD_LOG_FACE_WARN("attempt to send packet over MTU limit");
+      return;
+    }
+    this->sendPacket(std::move(tp));
+    return;
+  }
+
+  // fragments of the same packet are handed to the transport in one batch
+  std::vector<Transport::Packet> tps;
+  tps.reserve(frags.size());
   for (const lp::Packet& frag : frags) {
     Transport::Packet tp(frag.wireEncode());
     if (mtu != MTU_UNLIMITED && tp.packet.size() > static_cast<size_t>(mtu)) {
@@ -145,8 +159,9 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt)
       NFD_LOG_FACE_WARN("attempt to send packet over MTU limit");
       continue;
     }
-    this->sendPacket(std::move(tp));
+    tps.push_back(std::move(tp));
   }
+  this->sendPackets(std::move(tps));
 }
 
 void
@@ -166,30 +181,60 @@ GenericLinkService::doReceivePacket(Transport::Packet&& packet)
 {
   try {
     lp::Packet pkt(packet.packet);
+    this->receiveLpPacket(packet.remoteEndpoint, pkt);
+  }
+  catch (const tlv::Error& e) {
+    ++this->nInLpInvalid;
+    NFD_LOG_FACE_WARN("packet parse error (" << e.what() << "): DROP");
+  }
+}
 
-    if (!pkt.has<lp::FragmentField>()) {
-      NFD_LOG_FACE_TRACE("received IDLE packet: DROP");
-      return;
+void
+GenericLinkService::doReceivePackets(std::vector<Transport::Packet>&& packets)
+{
+  for (Transport::Packet& packet : packets) {
+    try {
+      lp::Packet pkt(packet.packet);
+
+      // a packet which is not a fragment carries the whole network-layer packet: decode it
+      // directly, without the reassembler copying the LpPacket
+      if (pkt.has<lp::FragmentField>() &&
+          !pkt.has<lp::FragIndexField>() && !pkt.has<lp::FragCountField>()) {
+        ndn::Buffer::const_iterator fragBegin, fragEnd;
+        std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
+        this->decodeNetPacket(Block(&*fragBegin, std::distance(fragBegin, fragEnd)), pkt);
+      }
+      else {
+        this->receiveLpPacket(packet.remoteEndpoint, pkt);
+      }
     }
-
-    if ((pkt.has<lp::FragIndexField>() || pkt.has<lp::FragCountField>()) &&
-        !m_options.allowReassembly) {
-      NFD_LOG_FACE_WARN("received fragment, but reassembly disabled: DROP");
-      return;
+    catch (const tlv::Error& e) {
+      ++this->nInLpInvalid;
+      NFD_LOG_FACE_WARN("packet parse error (" << e.what() << "): DROP");
     }
+  }
+}
 
-    bool isReassembled = false;
-    Block netPkt;
-    lp::Packet firstPkt;
-    std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(packet.remoteEndpoint,
-                                                                              pkt);
-    if (isReassembled) {
-      this->decodeNetPacket(netPkt, firstPkt);
-    }
+void
+GenericLinkService::receiveLpPacket(Transport::EndpointId remoteEndpoint, const lp::Packet& pkt)
+{
+  if (!pkt.has<lp::FragmentField>()) {
+    NFD_LOG_FACE_TRACE("received IDLE packet: DROP");
+    return;
   }
-  catch (const tlv::Error& e) {
-    ++this->nInLpInvalid;
-    NFD_LOG_FACE_WARN("packet parse error (" << e.what() << "): DROP");
+
+  if ((pkt.has<lp::FragIndexField>() || pkt.has<lp::FragCountField>()) &&
+      !m_options.allowReassembly) {
+    NFD_LOG_FACE_WARN("received fragment, but reassembly disabled: DROP");
+    return;
+  }
+
+  bool isReassembled = false;
+  Block netPkt;
+  lp::Packet firstPkt;
+  std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(remoteEndpoint, pkt);
+  if (isReassembled) {
+    this->decodeNetPacket(netPkt, firstPkt);
   }
 }
 
@@ -174,6 +174,19 @@ private: // receive path
   void
   doReceivePacket(Transport::Packet&& packet) override;
 
+  /** \brief receive a batch of Packets from Transport
+   *
+   *  The packets which are not fragments skip the reassembler.
+   */
+  void
+  doReceivePackets(std::vector<Transport::Packet>&& packets) override;
+
+  /** \brief process a decoded LpPacket, reassembling it if it is a fragment
+   *  \throw tlv::Error parse error in an LpHeader field
+   */
+  void
+  receiveLpPacket(Transport::EndpointId remoteEndpoint, const lp::Packet& pkt);
+
   /** \brief decode incoming network-layer packet
    *  \param netPkt reassembled network-layer packet
    *  \param firstPkt LpPacket of first fragment
@@ -44,17 +44,26 @@ InrppLinkService::InrppLinkService(const GenericLinkService::Options& options, s
 	m_adjustCapacityInterval = time::nanoseconds((int)timing) ;
 	m_bps = bps;
 	NFD_LOG_DEBUG("Time at " << timing);
-	m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,bind(&InrppLinkService::PullPacketFromCS, this));
+	m_pullTimer.SetFunction(&InrppLinkService::PullPacketFromCS, this);
+	m_pullTimer.Start(ns3::NanoSeconds(m_adjustCapacityInterval.count()));
 }
+
 void
+InrppLinkService::notifyQueuedData()
+{
+	m_pullTimer.Wake();
+}
+
+bool
 InrppLinkService::PullPacketFromCS()
 {
 	NFD_LOG_FACE_TRACE(this);
 	auto f = dynamic_cast<InrppForwarder*>(m_forwarder.get());
 	f->sendData(getFace()->getId(),m_bps);
-	NFD_LOG_DEBUG("Table packets "<< f->GetPackets(getFace()->getId()) << " "<<m_adjustCapacityInterval);
-	m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,bind(&InrppLinkService::PullPacketFromCS, this));
-
+	int nPackets = f->GetPackets(getFace()->getId());
+	NFD_LOG_DEBUG("Table packets "<< nPackets << " "<<m_adjustCapacityInterval);
+	// without queued Data, pulling would do nothing until the forwarder queues some
+	return nPackets > 0;
 }
 
 void
@@ -30,6 +30,8 @@
 #include "fw/forwarder.hpp"
 #include "core/scheduler.hpp"
 
+#include "ns3/periodic-timer.h"
+
 namespace nfd {
 namespace face {
 
@@ -48,8 +50,18 @@ public:
 
   signal::Signal<InrppLinkService, InrppState> afterChangeInrppState;
 
-private:
+  /** \brief notify that the forwarder queued Data to send on this face
+   *
+   *  Resumes pulling the queued Data from the CS, if it was suspended for lack of Data.
+   */
   void
+  notifyQueuedData();
+
+private:
+  /** \brief send the next queued Data
+   *  \return whether more Data is queued
+   */
+  bool
   PullPacketFromCS();
 
 
@@ -58,7 +70,10 @@ private:
 
   shared_ptr<nfd::Forwarder> m_forwarder;
   time::nanoseconds m_adjustCapacityInterval;
-  scheduler::EventId m_adjustCapacityEvent, m_faceStateEvent;
+  /** \brief pulls one Data per packet transmission time, shared with the faces of the same rate
+   */
+  ns3::PeriodicTimer m_pullTimer;
+  scheduler::EventId m_faceStateEvent;
   uint64_t m_bps;
   InrppState state;
 
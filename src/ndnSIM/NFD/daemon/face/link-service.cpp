@@ -119,6 +119,14 @@ LinkService::receiveNack(const ndn::lp::Nack& nack)
   afterReceiveNack(nack);
 }
 
+void
+LinkService::doReceivePackets(std::vector<Transport::Packet>&& packets)
+{
+  for (Transport::Packet& packet : packets) {
+    doReceivePacket(std::move(packet));
+  }
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LinkService>& flh)
 {
@@ -161,6 +161,13 @@ public: // lower interface to be invoked by Transport
   void
   receivePacket(Transport::Packet&& packet);
 
+  /** \brief performs LinkService specific operations to receive several lower-layer packets
+   *
+   *  Packets are processed in order, as if \p receivePacket were invoked on each of them.
+   */
+  void
+  receivePackets(std::vector<Transport::Packet>&& packets);
+
 protected: // upper interface to be invoked in subclass (receive path termination)
   /** \brief delivers received Interest to forwarding
    */
@@ -183,6 +190,11 @@ protected: // lower interface to be invoked in subclass (send path termination)
   void
   sendPacket(Transport::Packet&& packet);
 
+  /** \brief sends several lower-layer packets via Transport at once
+   */
+  void
+  sendPackets(std::vector<Transport::Packet>&& packets);
+
 private: // upper interface to be overridden in subclass (send path entrypoint)
   /** \brief performs LinkService specific operations to send an Interest
    */
@@ -203,6 +215,13 @@ private: // lower interface to be overridden in subclass
   virtual void
   doReceivePacket(Transport::Packet&& packet) = 0;
 
+  /** \brief performs LinkService specific operations to receive several lower-layer packets
+   *
+   *  The default implementation invokes \p doReceivePacket on each packet in order.
+   */
+  virtual void
+  doReceivePackets(std::vector<Transport::Packet>&& packets);
+
 protected:
   Face* m_face;
   Transport* m_transport;
@@ -238,12 +257,24 @@ LinkService::receivePacket(Transport::Packet&& packet)
   doReceivePacket(std::move(packet));
 }
 
+inline void
+LinkService::receivePackets(std::vector<Transport::Packet>&& packets)
+{
+  doReceivePackets(std::move(packets));
+}
+
 inline void
 LinkService::sendPacket(Transport::Packet&& packet)
 {
   m_transport->send(std::move(packet));
 }
 
+inline void
+LinkService::sendPackets(std::vector<Transport::Packet>&& packets)
+{
+  m_transport->sendBatch(std::move(packets));
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LinkService>& flh);
 
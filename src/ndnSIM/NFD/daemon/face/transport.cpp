@@ -115,6 +115,37 @@ Transport::send(Packet&& packet)
   this->doSend(std::move(packet));
 }
 
+void
+Transport::sendBatch(std::vector<Packet>&& packets)
+{
+  TransportState state = this->getState();
+  if (state != TransportState::UP && state != TransportState::DOWN) {
+    NFD_LOG_FACE_TRACE("sendBatch ignored in " << state << " state");
+    return;
+  }
+
+  if (state == TransportState::UP) {
+    size_t nBytes = 0;
+    for (const Packet& packet : packets) {
+      BOOST_ASSERT(this->getMtu() == MTU_UNLIMITED ||
+                   packet.packet.size() <= static_cast<size_t>(this->getMtu()));
+      nBytes += packet.packet.size();
+    }
+    this->nOutPackets += packets.size();
+    this->nOutBytes += nBytes;
+  }
+
+  this->doSendBatch(std::move(packets));
+}
+
+void
+Transport::doSendBatch(std::vector<Packet>&& packets)
+{
+  for (Packet& packet : packets) {
+    this->doSend(std::move(packet));
+  }
+}
+
 void
 Transport::receive(Packet&& packet)
 {
@@ -127,6 +158,21 @@ Transport::receive(Packet&& packet)
   m_service->receivePacket(std::move(packet));
 }
 
+void
+Transport::receive(std::vector<Packet>&& packets)
+{
+  size_t nBytes = 0;
+  for (const Packet& packet : packets) {
+    BOOST_ASSERT(this->getMtu() == MTU_UNLIMITED ||
+                 packet.packet.size() <= static_cast<size_t>(this->getMtu()));
+    nBytes += packet.packet.size();
+  }
+  this->nInPackets += packets.size();
+  this->nInBytes += nBytes;
+
+  m_service->receivePackets(std::move(packets));
+}
+
 void
 Transport::setPersistency(ndn::nfd::FacePersistency newPersistency)
 {
@@ -193,6 +193,16 @@ public: // upper interface
   void
   send(Packet&& packet);
 
+  /** \brief send several link-layer packets at once
+   *
+   *  This is equivalent to calling \p send on each packet in order,
+   *  but state check and counters are processed once per batch.
+   *  \note This operation has no effect if \p getState() is neither UP nor DOWN
+   *  \warning undefined behavior if any packet size exceeds MTU limit
+   */
+  void
+  sendBatch(std::vector<Packet>&& packets);
+
 protected: // upper interface to be invoked by subclass
   /** \brief receive a link-layer packet
    *  \warning undefined behavior if packet size exceeds MTU limit
@@ -200,6 +210,17 @@ protected: // upper interface to be invoked by subclass
   void
   receive(Packet&& packet);
 
+  /** \brief receive several link-layer packets at once
+   *
+   *  This is equivalent to calling \p receive on each packet in order,
+   *  but counters are updated and LinkService is invoked once per batch.
+   *  It is intended for transports that get several packets at the same time,
+   *  e.g., a burst arriving at the same simulated timestamp.
+   *  \warning undefined behavior if any packet size exceeds MTU limit
+   */
+  void
+  receive(std::vector<Packet>&& packets);
+
 public: // static properties
   /** \return a FaceUri representing local endpoint
    */
@@ -315,6 +336,15 @@ private: // to be overridden by subclass
   virtual void
   doSend(Packet&& packet) = 0;
 
+  /** \brief performs Transport specific operations to send several packets
+   *  \param packets the packets, each of which must be a well-formed TLV block
+   *  \pre state is either UP or DOWN
+   *
+   *  The default implementation invokes \p doSend on each packet in order.
+   */
+  virtual void
+  doSendBatch(std::vector<Packet>&& packets);
+
 private:
   Face* m_face;
   LinkService* m_service;
@@ -30,6 +30,7 @@
 #include "table/cleanup.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 #include "face/null-face.hpp"
+#include "face/inrpp-link-service.hpp"
 #include <boost/random/uniform_int_distribution.hpp>
 
 namespace nfd {
@@ -80,7 +81,11 @@ InrppForwarder::onOutgoingData(const Data& data, Face& inFace, Face& outFace)
 		  //auto interest = make_shared<ndn::Interest>(data.getName());
 		  NFD_LOG_DEBUG("Prefix outgoingdata face=" << outFace.getId() <<
 		 	                  " data=" << data.getName() << " size=" <<   data.getContent().size());
-		  m_outTable.insert(std::pair<FaceId,nameFace>(outFace.getId(),nameFace(data.getName(),inFace.getId())));
+		  m_outTable.insert(std::pair<FaceId,nameFace>(outFace.getId(),nameFace(ns3::ndn::InternedName(data.getName()),inFace.getId())));
+		  auto linkService = dynamic_cast<face::InrppLinkService*>(outFace.getLinkService());
+		  if (linkService != nullptr) {
+			  linkService->notifyQueuedData();
+		  }
 
 		  std::map<FaceId,uint32_t>::iterator it = m_bytes.find(outFace.getId());
 		  if(it != m_bytes.end())
@@ -198,7 +203,7 @@ InrppForwarder::sendData(FaceId id, uint64_t bps)
 		nameFace name = it->second;
 		NFD_LOG_DEBUG("Send=" << name.first << " " << m_cs.getLimit() << " " << m_cs.size());
 
-	    const ndn::Interest& interest(name.first);
+	    const ndn::Interest interest(name.first.toName());
 		m_cs.find(interest,
 		               bind(&InrppForwarder::onContentStoreHit, this,id, _1, _2),
 		               bind(&InrppForwarder::onContentStoreMiss, this,name.second, _1));
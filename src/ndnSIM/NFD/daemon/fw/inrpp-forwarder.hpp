@@ -28,6 +28,7 @@
 
 #include "forwarder.hpp"
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/ndn-interned-name.hpp"
 
 
 namespace nfd {
@@ -36,7 +37,12 @@ namespace fw {
 class Strategy;
 } // namespace fw
 
-typedef std::pair<Name,FaceId> nameFace;
+/** \brief queued Data name and its incoming face
+ *
+ *  The name is interned, since queued names share their prefixes and would otherwise each keep
+ *  a copy of the prefix and a reference to the whole Data packet buffer.
+ */
+typedef std::pair<ns3::ndn::InternedName,FaceId> nameFace;
 
 class Face;
 //typedef face::InrppState state;
@@ -172,8 +172,9 @@ BOOST_FIXTURE_TEST_CASE(ScopedEventIdMove, UnitTestTimeFixture)
   BOOST_CHECK_EQUAL(hit, 1);
 }
 
-BOOST_AUTO_TEST_CASE(ThreadLocalScheduler)
+BOOST_AUTO_TEST_CASE(PartitionScheduler)
 {
+  // the schedulers belong to the partitions of the simulation, not to the threads
   scheduler::Scheduler* s1 = &scheduler::getGlobalScheduler();
   scheduler::Scheduler* s2 = nullptr;
   boost::thread t([&s2] {
@@ -183,8 +184,7 @@ BOOST_AUTO_TEST_CASE(ThreadLocalScheduler)
   t.join();
 
   BOOST_CHECK(s1 != nullptr);
-  BOOST_CHECK(s2 != nullptr);
-  BOOST_CHECK(s1 != s2);
+  BOOST_CHECK(s1 == s2);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestScheduler
@@ -0,0 +1,432 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-pcon.hpp"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include "model/ndn-app-link-service.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerPcon");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerPcon);
+
+static const double MIN_SSTHRESH = 2.0;
+static const size_t INITIAL_BUFFER_SIZE = 64;
+
+TypeId
+ConsumerPcon::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerPcon")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<ConsumerPcon>()
+
+      .AddAttribute("Prefix", "Name of the Interest", StringValue("/"),
+                    MakeNameAccessor(&ConsumerPcon::m_interestName), MakeNameChecker())
+      .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
+                    MakeTimeAccessor(&ConsumerPcon::m_interestLifeTime), MakeTimeChecker())
+      .AddAttribute("MaxSeq", "Maximum sequence number to request",
+                    UintegerValue(std::numeric_limits<uint32_t>::max()),
+                    MakeUintegerAccessor(&ConsumerPcon::m_seqMax), MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("CcAlgorithm", "Algorithm adapting the window: AIMD, CUBIC or DELAY",
+                    EnumValue(AIMD), MakeEnumAccessor(&ConsumerPcon::m_ccAlgorithm),
+                    MakeEnumChecker(AIMD, "AIMD", CUBIC, "CUBIC", DELAY, "DELAY"))
+      .AddAttribute("InitialWindow", "Initial size of the window", DoubleValue(1.0),
+                    MakeDoubleAccessor(&ConsumerPcon::m_initialWindow),
+                    MakeDoubleChecker<double>(1.0))
+      .AddAttribute("Beta", "Multiplicative decrease of the window with AIMD and DELAY",
+                    DoubleValue(0.5), MakeDoubleAccessor(&ConsumerPcon::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("CubicBeta", "Multiplicative decrease of the window with CUBIC",
+                    DoubleValue(0.7), MakeDoubleAccessor(&ConsumerPcon::m_cubicBeta),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("CubicC", "Scaling constant of the cubic function", DoubleValue(0.4),
+                    MakeDoubleAccessor(&ConsumerPcon::m_cubicC), MakeDoubleChecker<double>(0.0))
+      .AddAttribute("DelayThreshold",
+                    "Excess of the round trip time over the minimum one which DELAY takes as "
+                    "a congestion signal",
+                    TimeValue(MilliSeconds(20)), MakeTimeAccessor(&ConsumerPcon::m_delayThreshold),
+                    MakeTimeChecker())
+      .AddAttribute("UseCwa", "Decrease the window at most once per round trip time",
+                    BooleanValue(true), MakeBooleanAccessor(&ConsumerPcon::m_useCwa),
+                    MakeBooleanChecker())
+      .AddAttribute("ReactToCongestionMarks", "Decrease the window for the Data with a congestion "
+                                              "mark",
+                    BooleanValue(true), MakeBooleanAccessor(&ConsumerPcon::m_reactToCongestionMarks),
+                    MakeBooleanChecker())
+      .AddAttribute("MinRto", "Minimum retransmission timeout", TimeValue(MilliSeconds(200)),
+                    MakeTimeAccessor(&ConsumerPcon::m_minRto), MakeTimeChecker())
+      .AddAttribute("MaxRto", "Maximum retransmission timeout", TimeValue(Seconds(4)),
+                    MakeTimeAccessor(&ConsumerPcon::m_maxRto), MakeTimeChecker())
+
+      .AddTraceSource("CongestionWindow", "Window of the outstanding Interests",
+                      MakeTraceSourceAccessor(&ConsumerPcon::m_window),
+                      "ns3::ndn::ConsumerPcon::WindowTraceCallback")
+      .AddTraceSource("InFlight", "Current number of outstanding interests",
+                      MakeTraceSourceAccessor(&ConsumerPcon::m_inFlight),
+                      "ns3::ndn::ConsumerPcon::WindowTraceCallback")
+
+      .AddTraceSource("LastRetransmittedInterestDataDelay",
+                      "Delay between last retransmitted Interest and received Data",
+                      MakeTraceSourceAccessor(&ConsumerPcon::m_lastRetransmittedInterestDataDelay),
+                      "ns3::ndn::Consumer::LastRetransmittedInterestDataDelayCallback")
+      .AddTraceSource("FirstInterestDataDelay",
+                      "Delay between first transmitted Interest and received Data",
+                      MakeTraceSourceAccessor(&ConsumerPcon::m_firstInterestDataDelay),
+                      "ns3::ndn::Consumer::FirstInterestDataDelayCallback");
+
+  return tid;
+}
+
+ConsumerPcon::ConsumerPcon()
+  : m_rand(CreateObject<UniformRandomVariable>())
+  , m_seqMax(std::numeric_limits<uint32_t>::max())
+  , m_lowSeq(0)
+  , m_seq(0)
+  , m_ssthresh(std::numeric_limits<double>::max())
+  , m_recoveryPoint(0)
+  , m_cubicWmax(0)
+  , m_srtt(-1)
+  , m_rttVar(0)
+  , m_minRtt(0)
+  , m_rto(Seconds(1))
+  , m_window(1.0)
+  , m_inFlight(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ConsumerPcon::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  App::StartApplication();
+
+  m_wheel = TimingWheel::GetWheel(GetNode());
+  if (m_states.empty()) {
+    m_states.resize(INITIAL_BUFFER_SIZE);
+    m_window = m_initialWindow;
+  }
+  SendPackets();
+}
+
+void
+ConsumerPcon::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  // the outstanding Interests are not retransmitted while stopped, but after a restart
+  m_wheel->RemoveClient(this);
+  for (uint32_t seq = m_lowSeq; seq != m_seq; seq++) {
+    if (GetState(seq).status == SENT) {
+      MarkLost(seq);
+    }
+  }
+
+  App::StopApplication();
+}
+
+void
+ConsumerPcon::DoDispose()
+{
+  if (m_wheel != 0) {
+    m_wheel->RemoveClient(this);
+    m_wheel = 0;
+  }
+
+  App::DoDispose();
+}
+
+ConsumerPcon::SeqState&
+ConsumerPcon::GetState(uint32_t seq)
+{
+  return m_states[seq & (m_states.size() - 1)];
+}
+
+void
+ConsumerPcon::GrowBuffer()
+{
+  std::vector<SeqState> states(2 * m_states.size());
+  for (uint32_t seq = m_lowSeq; seq != m_seq; seq++) {
+    states[seq & (states.size() - 1)] = GetState(seq);
+  }
+  m_states.swap(states);
+  NS_LOG_DEBUG("Ring buffer of " << m_states.size() << " sequence numbers");
+}
+
+void
+ConsumerPcon::SendPackets()
+{
+  if (!m_active)
+    return;
+
+  while (m_inFlight < static_cast<uint32_t>(m_window.Get())) {
+    uint32_t seq;
+    if (!m_retxQueue.empty()) {
+      seq = m_retxQueue.front();
+      m_retxQueue.pop_front();
+      if (seq < m_lowSeq || GetState(seq).status != LOST) {
+        continue; // Data received after the timeout
+      }
+    }
+    else if (m_seq < m_seqMax) {
+      if (m_seq - m_lowSeq == m_states.size()) {
+        GrowBuffer();
+      }
+      seq = m_seq++;
+      SeqState& state = GetState(seq);
+      state.seq = seq;
+      state.nTransmissions = 0;
+    }
+    else {
+      break; // all requested, waiting for the outstanding Data
+    }
+
+    SendInterest(seq);
+  }
+}
+
+void
+ConsumerPcon::SendInterest(uint32_t seq)
+{
+  Time now = Simulator::Now();
+  SeqState& state = GetState(seq);
+  if (state.nTransmissions == 0) {
+    state.firstSent = now;
+  }
+  state.lastSent = now;
+  state.nTransmissions++;
+  state.status = SENT;
+  m_inFlight++;
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(m_rand->GetValue(1, std::numeric_limits<uint32_t>::max()));
+  interest->setName(Name(m_interestName).appendSequenceNumber(seq));
+  interest->setInterestLifetime(time::milliseconds(m_interestLifeTime.GetMilliSeconds()));
+
+  NS_LOG_INFO("> Interest for " << seq << " (transmission " << state.nTransmissions << ")");
+
+  m_wheel->Schedule(m_rto, this, seq, state.nTransmissions);
+
+  m_transmittedInterests(interest, this, m_face);
+  m_appLink->onReceiveInterest(*interest);
+}
+
+void
+ConsumerPcon::MarkLost(uint32_t seq)
+{
+  GetState(seq).status = LOST;
+  m_inFlight--;
+  m_retxQueue.push_back(seq);
+}
+
+void
+ConsumerPcon::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  App::OnData(data); // tracing inside
+
+  uint32_t seq = data->getName().at(-1).toSequenceNumber();
+  if (seq < m_lowSeq || seq >= m_seq || GetState(seq).status == RECEIVED) {
+    NS_LOG_DEBUG("Duplicate DATA for " << seq);
+    return;
+  }
+  NS_LOG_INFO("< DATA for " << seq);
+
+  int hopCount = 0;
+  auto hopCountTag = data->getTag<lp::HopCountTag>();
+  if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
+    hopCount = *hopCountTag;
+  }
+
+  Time now = Simulator::Now();
+  SeqState& state = GetState(seq);
+  m_lastRetransmittedInterestDataDelay(this, seq, now - state.lastSent, hopCount);
+  m_firstInterestDataDelay(this, seq, now - state.firstSent, state.nTransmissions, hopCount);
+
+  if (state.status == SENT) {
+    m_inFlight--;
+  }
+  state.status = RECEIVED;
+
+  bool isCongested = false;
+  if (m_reactToCongestionMarks) {
+    auto congestionMarkTag = data->getTag<lp::CongestionMarkTag>();
+    isCongested = congestionMarkTag != nullptr && *congestionMarkTag > 0;
+  }
+  // Karn's algorithm: the Data of a retransmitted Interest may answer any transmission
+  if (state.nTransmissions == 1) {
+    double rtt = (now - state.lastSent).GetSeconds();
+    UpdateRtt(rtt);
+    if (m_ccAlgorithm == DELAY && rtt > m_minRtt + m_delayThreshold.GetSeconds()) {
+      isCongested = true;
+    }
+  }
+
+  if (isCongested) {
+    NS_LOG_DEBUG("Congestion signal for " << seq);
+    DecreaseWindow(seq);
+  }
+  else {
+    IncreaseWindow();
+  }
+
+  while (m_lowSeq != m_seq && GetState(m_lowSeq).status == RECEIVED) {
+    m_lowSeq++;
+  }
+
+  SendPackets();
+}
+
+void
+ConsumerPcon::OnNack(shared_ptr<const lp::Nack> nack)
+{
+  if (!m_active)
+    return;
+
+  App::OnNack(nack); // tracing inside
+
+  uint32_t seq = nack->getInterest().getName().at(-1).toSequenceNumber();
+  NS_LOG_INFO("NACK received for " << seq << ", reason: " << nack->getReason());
+
+  // without congestion, retransmitting right away would repeat the Nack; the timeout does it
+  if (nack->getReason() != lp::NackReason::CONGESTION || seq < m_lowSeq || seq >= m_seq
+      || GetState(seq).status != SENT) {
+    return;
+  }
+
+  MarkLost(seq);
+  DecreaseWindow(seq);
+  SendPackets();
+}
+
+void
+ConsumerPcon::OnTimerExpired(uint32_t seq, uint32_t nTransmissions)
+{
+  if (seq < m_lowSeq || seq >= m_seq) {
+    return;
+  }
+  SeqState& state = GetState(seq);
+  if (state.status != SENT || state.nTransmissions != nTransmissions) {
+    return; // answered, or retransmitted since
+  }
+  NS_LOG_INFO("Timeout for " << seq << ", RTO " << m_rto.GetSeconds() << "s");
+
+  // back off until the next sample
+  m_rto = std::min(m_rto * 2, m_maxRto);
+
+  MarkLost(seq);
+  DecreaseWindow(seq);
+  SendPackets();
+}
+
+void
+ConsumerPcon::UpdateRtt(double rtt)
+{
+  // RFC 6298
+  if (m_srtt < 0) {
+    m_srtt = rtt;
+    m_rttVar = rtt / 2;
+    m_minRtt = rtt;
+  }
+  else {
+    m_rttVar = 0.75 * m_rttVar + 0.25 * std::abs(m_srtt - rtt);
+    m_srtt = 0.875 * m_srtt + 0.125 * rtt;
+    m_minRtt = std::min(m_minRtt, rtt);
+  }
+  m_rto = std::max(m_minRto, std::min(Seconds(m_srtt + 4 * m_rttVar), m_maxRto));
+}
+
+void
+ConsumerPcon::IncreaseWindow()
+{
+  double window = m_window;
+  if (window < m_ssthresh) {
+    // slow start
+    m_window = window + 1.0;
+    return;
+  }
+
+  if (m_ccAlgorithm != CUBIC) {
+    m_window = window + 1.0 / window;
+    return;
+  }
+
+  // RFC 8312:  the target is the window of the cubic function one round trip time later
+  double rtt = std::max(m_srtt, 0.001);
+  double t = (Simulator::Now() - m_lastDecrease).GetSeconds() + rtt;
+  double k = std::cbrt(m_cubicWmax * (1 - m_cubicBeta) / m_cubicC);
+  double target = m_cubicC * std::pow(t - k, 3) + m_cubicWmax;
+  // not less than the window of AIMD with the same average rate (TCP-friendly region)
+  double aimdWindow =
+    m_cubicWmax * m_cubicBeta + 3 * (1 - m_cubicBeta) / (1 + m_cubicBeta) * t / rtt;
+  target = std::max(target, aimdWindow);
+
+  if (target > window) {
+    m_window = window + (target - window) / window;
+  }
+  else {
+    m_window = window + 0.01 / window;
+  }
+}
+
+void
+ConsumerPcon::DecreaseWindow(uint32_t seq)
+{
+  if (m_useCwa && seq < m_recoveryPoint) {
+    return; // sent before the last decrease
+  }
+  m_recoveryPoint = m_seq;
+
+  double window = m_window;
+  if (m_ccAlgorithm == CUBIC) {
+    // fast convergence:  release bandwidth to the flows which have started since
+    m_cubicWmax = window < m_cubicWmax ? window * (1 + m_cubicBeta) / 2 : window;
+    m_lastDecrease = Simulator::Now();
+    m_ssthresh = std::max(MIN_SSTHRESH, window * m_cubicBeta);
+  }
+  else {
+    m_ssthresh = std::max(MIN_SSTHRESH, window * m_beta);
+  }
+  m_window = m_ssthresh;
+  NS_LOG_DEBUG("Window " << window << " -> " << m_window);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_PCON_H
+#define NDN_CONSUMER_PCON_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+#include "ns3/ndnSIM/utils/ndn-timing-wheel.hpp"
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/traced-value.h"
+
+#include <deque>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Ndn application requesting a sequence of contents with a congestion window
+ *
+ * The window is adapted to the congestion signals, i.e., timeouts, Nacks with the Congestion
+ * reason and Data carrying a congestion mark, with one of the algorithms (CcAlgorithm attribute):
+ *
+ * - AIMD: slow start, then additive increase of one Interest per round trip time and
+ *   multiplicative decrease by Beta;
+ * - CUBIC: slow start, then the window follows the cubic function of the time since the last
+ *   decrease (RFC 8312), with a decrease by CubicBeta;
+ * - DELAY: like AIMD, but a round trip time exceeding the minimum one by DelayThreshold is also
+ *   a congestion signal.
+ *
+ * With UseCwa (conservative window adaptation), the window decreases at most once per round
+ * trip time, i.e., not again for the signals of the Interests sent before the last decrease.
+ *
+ * The state of the outstanding sequence numbers is kept in a ring buffer indexed by sequence
+ * number, from the lowest one without Data to the next one to send, and the Data received out
+ * of order are acknowledged individually.  Each Interest arms a timer on the TimingWheel of the
+ * node, and the retransmission timeout follows the round trip time estimation of RFC 6298.
+ *
+ * The app reports the delays of the Data with the FirstInterestDataDelay and
+ * LastRetransmittedInterestDataDelay trace sources of ndn::Consumer, which ndn::AppDelayTracer
+ * records.
+ */
+class ConsumerPcon : public App, private TimingWheel::Client {
+public:
+  static TypeId
+  GetTypeId();
+
+  enum CcAlgorithm {
+    AIMD,
+    CUBIC,
+    DELAY
+  };
+
+  ConsumerPcon();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+  virtual void
+  OnNack(shared_ptr<const lp::Nack> nack);
+
+public:
+  typedef void (*WindowTraceCallback)(double window);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+  virtual void
+  DoDispose();
+
+private:
+  // from TimingWheel::Client
+  virtual void
+  OnTimerExpired(uint32_t seq, uint32_t nTransmissions);
+
+  /// Send the retransmissions, then new Interests, while the window allows
+  void
+  SendPackets();
+
+  void
+  SendInterest(uint32_t seq);
+
+  /// The ring buffer entry of a sequence number
+  struct SeqState;
+
+  SeqState&
+  GetState(uint32_t seq);
+
+  /// Double the capacity of the ring buffer, keeping the entries of the outstanding window
+  void
+  GrowBuffer();
+
+  void
+  UpdateRtt(double rtt);
+
+  void
+  IncreaseWindow();
+
+  /// Decrease the window after a congestion signal for @p seq
+  void
+  DecreaseWindow(uint32_t seq);
+
+  /// Queue an outstanding sequence number for retransmission
+  void
+  MarkLost(uint32_t seq);
+
+private:
+  enum Status {
+    SENT,     ///< Interest outstanding
+    LOST,     ///< queued for retransmission
+    RECEIVED, ///< Data received
+  };
+
+  struct SeqState {
+    Time firstSent;
+    Time lastSent;
+    uint32_t seq;
+    uint32_t nTransmissions;
+    Status status;
+  };
+
+  Ptr<UniformRandomVariable> m_rand;
+  Ptr<TimingWheel> m_wheel;
+
+  Name m_interestName;
+  Time m_interestLifeTime;
+  uint32_t m_seqMax;
+
+  CcAlgorithm m_ccAlgorithm;
+  double m_initialWindow;
+  double m_beta;
+  double m_cubicBeta;
+  double m_cubicC;
+  Time m_delayThreshold;
+  bool m_useCwa;
+  bool m_reactToCongestionMarks;
+  Time m_minRto;
+  Time m_maxRto;
+
+  std::vector<SeqState> m_states; ///< ring buffer, with a power of two size
+  uint32_t m_lowSeq;              ///< lowest sequence number without Data
+  uint32_t m_seq;                 ///< next sequence number to send
+  std::deque<uint32_t> m_retxQueue;
+
+  double m_ssthresh;
+  uint32_t m_recoveryPoint; ///< first sequence number which may cause a decrease, with UseCwa
+  double m_cubicWmax;
+  Time m_lastDecrease;
+
+  // round trip time estimation, in seconds
+  double m_srtt;
+  double m_rttVar;
+  double m_minRtt;
+  Time m_rto;
+
+  TracedValue<double> m_window;
+  TracedValue<uint32_t> m_inFlight;
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
+    m_lastRetransmittedInterestDataDelay;
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
+                 uint32_t /*retx count*/, int32_t /*hop count*/> m_firstInterestDataDelay;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_PCON_H
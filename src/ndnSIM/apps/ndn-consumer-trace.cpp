@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-trace.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerTrace");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerTrace);
+
+TypeId
+ConsumerTrace::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerTrace")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<ConsumerTrace>()
+
+      .AddAttribute("TraceFile", "Binary request trace to replay", StringValue(""),
+                    MakeStringAccessor(&ConsumerTrace::m_traceFile), MakeStringChecker())
+      .AddAttribute("TraceNode",
+                    "Node of the trace whose requests are replayed (default: id of the node)",
+                    UintegerValue(std::numeric_limits<uint32_t>::max()),
+                    MakeUintegerAccessor(&ConsumerTrace::m_traceNode),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("BatchSize", "Number of records decoded at once", UintegerValue(1024),
+                    MakeUintegerAccessor(&ConsumerTrace::m_batchSize),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
+                    MakeTimeAccessor(&ConsumerTrace::m_interestLifeTime), MakeTimeChecker())
+
+      .AddTraceSource("DataDelay", "Delay between the Interest of a record and its Data",
+                      MakeTraceSourceAccessor(&ConsumerTrace::m_dataDelay),
+                      "ns3::ndn::ConsumerTrace::DataDelayCallback");
+
+  return tid;
+}
+
+ConsumerTrace::ConsumerTrace()
+  : m_rand(CreateObject<UniformRandomVariable>())
+  , m_next(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+ConsumerTrace::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  App::StartApplication();
+
+  try {
+    m_trace = RequestTrace::Open(m_traceFile);
+  }
+  catch (const std::runtime_error& error) {
+    NS_FATAL_ERROR(error.what());
+  }
+
+  uint32_t node = m_traceNode;
+  if (node == std::numeric_limits<uint32_t>::max()) {
+    node = GetNode()->GetId();
+  }
+  m_cursor.reset(new RequestTrace::Cursor(m_trace->getCursor(node)));
+  NS_LOG_INFO("Replaying " << m_cursor->getNRemaining() << " requests of node " << node);
+
+  m_records.clear();
+  m_next = 0;
+  m_start = Simulator::Now();
+  ScheduleNextRequest();
+}
+
+void
+ConsumerTrace::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  Simulator::Cancel(m_sendEvent);
+
+  m_cursor.reset();
+  m_trace.reset();
+  m_records.clear();
+  m_pending.clear();
+
+  App::StopApplication();
+}
+
+void
+ConsumerTrace::ScheduleNextRequest()
+{
+  if (m_next == m_records.size()) {
+    size_t nRecords = 0;
+    try {
+      nRecords = m_cursor->read(m_records, m_batchSize);
+    }
+    catch (const std::runtime_error& error) {
+      NS_FATAL_ERROR(error.what());
+    }
+    if (nRecords == 0) {
+      NS_LOG_INFO("End of the trace");
+      return;
+    }
+    m_next = 0;
+
+    // forget the Interests which expired without Data
+    for (auto entry = m_pending.begin(); entry != m_pending.end();) {
+      ForgetExpired(entry->second);
+      if (entry->second.empty()) {
+        entry = m_pending.erase(entry);
+      }
+      else {
+        ++entry;
+      }
+    }
+  }
+
+  Time delay = std::max(m_start + m_records[m_next].time - Simulator::Now(), Seconds(0));
+  m_sendEvent = Simulator::Schedule(delay, &ConsumerTrace::SendRequest, this);
+}
+
+void
+ConsumerTrace::SendRequest()
+{
+  if (!m_active)
+    return;
+
+  const RequestTrace::Record& record = m_records[m_next++];
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(m_rand->GetValue(1, std::numeric_limits<uint32_t>::max()));
+  interest->setName(record.name);
+  interest->setInterestLifetime(time::milliseconds(m_interestLifeTime.GetMilliSeconds()));
+
+  NS_LOG_INFO("> Interest for " << record.name);
+  m_pending[record.name].push_back(Simulator::Now());
+
+  m_transmittedInterests(interest, this, m_face);
+  m_appLink->onReceiveInterest(*interest);
+
+  ScheduleNextRequest();
+}
+
+void
+ConsumerTrace::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  App::OnData(data); // tracing inside
+
+  NS_LOG_INFO("< DATA for " << data->getName());
+
+  auto entry = m_pending.find(data->getName());
+  if (entry == m_pending.end()) {
+    return;
+  }
+
+  int hopCount = 0;
+  auto hopCountTag = data->getTag<lp::HopCountTag>();
+  if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
+    hopCount = *hopCountTag;
+  }
+
+  // the Interests of the same name are aggregated by the forwarder, so the Data answers all the
+  // requests still pending
+  ForgetExpired(entry->second);
+  for (const Time& sendTime : entry->second) {
+    m_dataDelay(this, data->getName(), Simulator::Now() - sendTime, hopCount);
+  }
+  m_pending.erase(entry);
+}
+
+void
+ConsumerTrace::ForgetExpired(std::vector<Time>& sendTimes) const
+{
+  auto expired = std::find_if(sendTimes.begin(), sendTimes.end(), [this] (const Time& sendTime) {
+      return sendTime + m_interestLifeTime >= Simulator::Now();
+    });
+  sendTimes.erase(sendTimes.begin(), expired);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_TRACE_H
+#define NDN_CONSUMER_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN application replaying the requests of a trace
+ *
+ * The application sends an Interest for each record of its node in a binary request trace (see
+ * RequestTrace), at the time of the record counted from the start of the application.  Interests
+ * are not retransmitted: the trace already contains the retransmissions, if any.
+ *
+ * The records are decoded in batches, ahead of the simulation time, so the memory used does not
+ * depend on the length of the trace.  All the applications replaying the same file share one
+ * memory mapping of it.
+ */
+class ConsumerTrace : public App {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerTrace();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+public:
+  typedef void (*DataDelayCallback)(Ptr<App> app, const Name& name, Time delay, int32_t hopCount);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+private:
+  /**
+   * @brief Schedule the Interest of the next record, decoding the next batch if needed
+   */
+  void
+  ScheduleNextRequest();
+
+  void
+  SendRequest();
+
+  /**
+   * @brief Remove the send times of the Interests which expired, the oldest first in the list
+   */
+  void
+  ForgetExpired(std::vector<Time>& sendTimes) const;
+
+private:
+  std::string m_traceFile;
+  uint32_t m_traceNode;
+  uint32_t m_batchSize;
+  Time m_interestLifeTime;
+  Ptr<UniformRandomVariable> m_rand;
+
+  shared_ptr<RequestTrace> m_trace;
+  std::unique_ptr<RequestTrace::Cursor> m_cursor;
+  std::vector<RequestTrace::Record> m_records; ///< @brief current batch
+  size_t m_next;                               ///< @brief next record of the batch
+  Time m_start;
+  EventId m_sendEvent;
+
+  /// @brief send times of the pending Interests, in order, as a name may be requested again
+  ///        before its Data
+  std::unordered_map<Name, std::vector<Time>> m_pending;
+
+  TracedCallback<Ptr<App>, const Name&, Time, int32_t> m_dataDelay;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_TRACE_H
@@ -21,7 +21,8 @@
 
 #include "ndn-consumer-zipf-mandelbrot.hpp"
 
-#include <math.h>
+#include <algorithm>
+#include <cmath>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
@@ -30,6 +31,26 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED(ConsumerZipfMandelbrot);
 
+// log1p(x) / x, accurate near 0
+static double
+log1pOverX(double x)
+{
+  if (std::abs(x) > 1e-8)
+    return std::log1p(x) / x;
+  else
+    return 1 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+// expm1(x) / x, accurate near 0
+static double
+expm1OverX(double x)
+{
+  if (std::abs(x) > 1e-8)
+    return std::expm1(x) / x;
+  else
+    return 1 + x * 0.5 * (1 + x * (1.0 / 3.0) * (1 + 0.25 * x));
+}
+
 TypeId
 ConsumerZipfMandelbrot::GetTypeId(void)
 {
@@ -44,15 +65,16 @@ ConsumerZipfMandelbrot::GetTypeId(void)
                                          &ConsumerZipfMandelbrot::GetNumberOfContents),
                     MakeUintegerChecker<uint32_t>())
 
+      // rejection-inversion requires q > -0.5 and s >= 0
       .AddAttribute("q", "parameter of improve rank", StringValue("0.7"),
                     MakeDoubleAccessor(&ConsumerZipfMandelbrot::SetQ,
                                        &ConsumerZipfMandelbrot::GetQ),
-                    MakeDoubleChecker<double>())
+                    MakeDoubleChecker<double>(std::nextafter(-0.5, 0.0)))
 
       .AddAttribute("s", "parameter of power", StringValue("0.7"),
                     MakeDoubleAccessor(&ConsumerZipfMandelbrot::SetS,
                                        &ConsumerZipfMandelbrot::GetS),
-                    MakeDoubleChecker<double>());
+                    MakeDoubleChecker<double>(0.0));
 
   return tid;
 }
@@ -77,17 +99,9 @@ ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_hIntegralX1 = HIntegral(1.5) - H(1);
+  m_hIntegralN = HIntegral(m_N + 0.5);
+  m_threshold = 2 - HIntegralInverse(HIntegral(2.5) - H(2));
 }
 
 uint32_t
@@ -176,18 +190,8 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
 
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -195,27 +199,44 @@ ConsumerZipfMandelbrot::SendPacket()
   ConsumerZipfMandelbrot::ScheduleNextPacket();
 }
 
+double
+ConsumerZipfMandelbrot::H(double x) const
+{
+  return std::exp(-m_s * std::log(x + m_q));
+}
+
+double
+ConsumerZipfMandelbrot::HIntegral(double x) const
+{
+  // ((x+q)^(1-s) - 1) / (1-s), or log(x+q) if s = 1
+  double logX = std::log(x + m_q);
+  return expm1OverX((1 - m_s) * logX) * logX;
+}
+
+double
+ConsumerZipfMandelbrot::HIntegralInverse(double x) const
+{
+  double t = std::max(x * (1 - m_s), -1.0);
+  return std::exp(log1pOverX(t) * x) - m_q;
+}
+
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
-  double p_random = m_seqRng->GetValue();
-  while (p_random == 0) {
-    p_random = m_seqRng->GetValue();
-  }
-  // if (p_random == 0)
-  NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
+  // Rejection-inversion: x follows the density h over [0.5, N + 0.5], with the interval of the
+  // first content cut to the area H(1), and its nearest content k is accepted if x falls within
+  // an area H(k) of the interval of k
+  while (m_N > 1) {
+    double u = m_hIntegralN + m_seqRng->GetValue() * (m_hIntegralX1 - m_hIntegralN);
+    double x = HIntegralInverse(u);
+    double k = std::min(std::max(std::floor(x + 0.5), 1.0), static_cast<double>(m_N));
+    if (k - x <= m_threshold || u >= HIntegral(k + 0.5) - H(k)) {
+      content_index = static_cast<uint32_t>(k);
       break;
-    } // if
-  }   // for
-  // content_index = 1;
+    }
+  }
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
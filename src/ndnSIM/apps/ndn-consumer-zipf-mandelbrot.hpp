@@ -47,6 +47,11 @@ namespace ndn {
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution:
  *http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * The contents are drawn with the rejection-inversion method of W. Hormann and G. Derflinger
+ * ("Rejection-inversion to generate variates from monotone discrete distributions", 1996), in
+ * constant time and memory whatever the number of contents, e.g., 10^8.  The method requires
+ * s >= 0 and q > -0.5.
  */
 class ConsumerZipfMandelbrot : public ConsumerCbr {
 public:
@@ -90,11 +95,24 @@ private:
   double
   GetS() const;
 
+  // h(x) = (x+q)^-s, the unnormalized probability of content x
+  double
+  H(double x) const;
+
+  // integral of h, up to a constant
+  double
+  HIntegral(double x) const;
+
+  double
+  HIntegralInverse(double x) const;
+
 private:
-  uint32_t m_N;               // number of the contents
-  double m_q;                 // q in (k+q)^s
-  double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  uint32_t m_N;         // number of the contents
+  double m_q;           // q in (k+q)^s
+  double m_s;           // s in (k+q)^s
+  double m_hIntegralX1; // HIntegral(1.5) - H(1): start of the hat function area
+  double m_hIntegralN;  // HIntegral(N + 0.5): end of the hat function area
+  double m_threshold;   // contents k with k - x <= threshold are accepted without test
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
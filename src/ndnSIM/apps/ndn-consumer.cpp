@@ -34,6 +34,8 @@
 
 #include <ndn-cxx/lp/tags.hpp>
 
+#include <algorithm>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
 
@@ -44,6 +46,8 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED(Consumer);
 
+static const uint32_t INITIAL_SEQ_STATES_BITS = 4;
+
 TypeId
 Consumer::GetTypeId(void)
 {
@@ -60,7 +64,7 @@ Consumer::GetTypeId(void)
                     MakeTimeAccessor(&Consumer::m_interestLifeTime), MakeTimeChecker())
 
       .AddAttribute("RetxTimer",
-                    "Timeout defining how frequent retransmission timeouts should be checked",
+                    "Precision of the retransmission timeouts: maximum delay of their check",
                     StringValue("50ms"),
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
@@ -82,6 +86,9 @@ Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_seqMax(0) // don't request anything
+  , m_seqStates(1 << INITIAL_SEQ_STATES_BITS)
+  , m_nSeqStates(0)
+  , m_seqStatesBits(INITIAL_SEQ_STATES_BITS)
 {
   NS_LOG_FUNCTION_NOARGS();
 
@@ -92,13 +99,6 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
-  if (m_retxEvent.IsRunning()) {
-    // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-    Simulator::Remove(m_retxEvent); // slower, but better for memory
-  }
-
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
 }
 
 Time
@@ -107,6 +107,33 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
+void
+Consumer::ScheduleRetxCheck()
+{
+  // skip the transmissions retransmitted or answered since
+  while (!m_seqTimeouts.empty()) {
+    const SeqTimeout& entry = m_seqTimeouts.front();
+    SeqState* state = FindSeqState(entry.seq);
+    if (state != nullptr && state->isOutstanding && state->lastSent == entry.time) {
+      break;
+    }
+    m_seqTimeouts.pop_front();
+  }
+  if (m_seqTimeouts.empty()) {
+    return; // armed again by the next transmission
+  }
+
+  Time now = Simulator::Now();
+  Time timeout = std::max(m_seqTimeouts.front().time + m_rtt->RetransmitTimeout(), now);
+  if (m_retxEvent.IsRunning()) {
+    if (TimeStep(m_retxEvent.GetTs()) <= timeout + m_retxTimer) {
+      return;
+    }
+    Simulator::Cancel(m_retxEvent);
+  }
+  m_retxEvent = Simulator::Schedule(timeout - now, &Consumer::CheckRetxTimeout, this);
+}
+
 void
 Consumer::CheckRetxTimeout()
 {
@@ -116,19 +143,22 @@ Consumer::CheckRetxTimeout()
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
   while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
+    SeqTimeout entry = m_seqTimeouts.front();
+    SeqState* state = FindSeqState(entry.seq);
+    if (state == nullptr || !state->isOutstanding || state->lastSent != entry.time) {
+      m_seqTimeouts.pop_front(); // retransmitted or answered since
+    }
+    else if (entry.time + rto <= now) // timeout expired?
     {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
+      m_seqTimeouts.pop_front();
+      state->isOutstanding = false;
+      OnTimeout(entry.seq);
     }
     else
       break; // nothing else to do. All later packets need not be retransmitted
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
 }
 
 // Application Methods
@@ -150,6 +180,7 @@ Consumer::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
 
   // cleanup base stuff
   App::StopApplication();
@@ -231,24 +262,20 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
+  SeqState* state = FindSeqState(seq);
+  if (state != nullptr) {
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - state->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - state->firstSent, state->retxCount,
+                             hopCount);
+    // its transmissions left in m_seqTimeouts are skipped
+    EraseSeqState(seq);
   }
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
-  }
-
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
+  // the retransmission timeout may have decreased
+  ScheduleRetxCheck();
 }
 
 void
@@ -279,17 +306,99 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_nSeqStates << " items");
+
+  SeqState& state = InsertSeqState(sequenceNumber);
+  if (state.retxCount == 0) {
+    state.firstSent = Simulator::Now();
+  }
+  state.lastSent = Simulator::Now();
+  state.retxCount++;
+  state.isOutstanding = true;
+  m_seqTimeouts.push_back(SeqTimeout(sequenceNumber, Simulator::Now()));
+
+  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  if (!m_retxEvent.IsRunning()) {
+    ScheduleRetxCheck();
+  }
+}
 
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+static inline size_t
+seqHome(uint32_t seq, uint32_t bits)
+{
+  // Fibonacci hashing, spreading consecutive sequence numbers
+  return static_cast<size_t>((seq * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - bits));
+}
 
-  m_seqRetxCounts[sequenceNumber]++;
+Consumer::SeqState*
+Consumer::FindSeqState(uint32_t seq)
+{
+  size_t mask = m_seqStates.size() - 1;
+  for (size_t i = seqHome(seq, m_seqStatesBits); m_seqStates[i].isUsed; i = (i + 1) & mask) {
+    if (m_seqStates[i].seq == seq) {
+      return &m_seqStates[i];
+    }
+  }
+  return nullptr;
+}
 
-  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+Consumer::SeqState&
+Consumer::InsertSeqState(uint32_t seq)
+{
+  SeqState* state = FindSeqState(seq);
+  if (state != nullptr) {
+    return *state;
+  }
+
+  // at most half full
+  if (2 * (m_nSeqStates + 1) > m_seqStates.size()) {
+    std::vector<SeqState> states(2 * m_seqStates.size());
+    states.swap(m_seqStates);
+    m_seqStatesBits++;
+    for (const SeqState& old : states) {
+      if (old.isUsed) {
+        size_t i = seqHome(old.seq, m_seqStatesBits);
+        while (m_seqStates[i].isUsed) {
+          i = (i + 1) & (m_seqStates.size() - 1);
+        }
+        m_seqStates[i] = old;
+      }
+    }
+  }
+
+  size_t i = seqHome(seq, m_seqStatesBits);
+  while (m_seqStates[i].isUsed) {
+    i = (i + 1) & (m_seqStates.size() - 1);
+  }
+  m_seqStates[i] = SeqState();
+  m_seqStates[i].seq = seq;
+  m_seqStates[i].isUsed = true;
+  m_nSeqStates++;
+  return m_seqStates[i];
+}
+
+void
+Consumer::EraseSeqState(uint32_t seq)
+{
+  SeqState* state = FindSeqState(seq);
+  if (state == nullptr) {
+    return;
+  }
+
+  // backward shift deletion:  move up the following entries which cannot be found anymore
+  size_t mask = m_seqStates.size() - 1;
+  size_t hole = state - &m_seqStates[0];
+  for (size_t i = (hole + 1) & mask; m_seqStates[i].isUsed; i = (i + 1) & mask) {
+    size_t home = seqHome(m_seqStates[i].seq, m_seqStatesBits);
+    bool isReachable = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+    if (!isReachable) {
+      m_seqStates[hole] = m_seqStates[i];
+      hole = i;
+    }
+  }
+  m_seqStates[hole].isUsed = false;
+  m_nSeqStates--;
 }
 
 } // namespace ndn
@@ -31,13 +31,9 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 
+#include <deque>
 #include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -118,27 +114,59 @@ protected:
   CheckRetxTimeout();
 
   /**
-   * \brief Modifies the frequency of checking the retransmission timeouts
-   * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Arms the retransmission event for the earliest timeout of the outstanding Interests
+   *
+   * The event is kept if it expires no later than RetxTimer after the earliest timeout, so that
+   * it is not moved for every small decrease of the estimated retransmission timeout.  An event
+   * expiring too early, e.g., for an Interest answered since, only re-arms itself.
+   */
+  void
+  ScheduleRetxCheck();
+
+  /**
+   * \brief Modifies the precision of the retransmission timeouts
+   * \param retxTimer Maximum delay of the check of a retransmission timeout
    */
   void
   SetRetxTimer(Time retxTimer);
 
   /**
-   * \brief Returns the frequency of checking the retransmission timeouts
-   * \return Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Returns the precision of the retransmission timeouts
+   * \return Maximum delay of the check of a retransmission timeout
    */
   Time
   GetRetxTimer() const;
 
+  /// @cond include_hidden
+  struct SeqState;
+  /// @endcond
+
+  /**
+   * \brief Returns the state of a sequence number, or 0 if it has none
+   */
+  SeqState*
+  FindSeqState(uint32_t seq);
+
+  /**
+   * \brief Returns the state of a sequence number, created if needed
+   */
+  SeqState&
+  InsertSeqState(uint32_t seq);
+
+  /**
+   * \brief Removes the state of a sequence number
+   */
+  void
+  EraseSeqState(uint32_t seq);
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
   uint32_t m_seq;      ///< @brief currently requested sequence number
   uint32_t m_seqMax;   ///< @brief maximum number of sequence number
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
-  Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
-  EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  Time m_retxTimer;    ///< @brief Precision of the retransmission timeouts
+  EventId m_retxEvent; ///< @brief Event to check the earliest retransmission timeout
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
 
@@ -156,7 +184,7 @@ protected:
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
   /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
+   * \struct This struct contains a pair of packet sequence number and its transmission time
    */
   struct SeqTimeout {
     SeqTimeout(uint32_t _seq, Time _time)
@@ -168,42 +196,29 @@ protected:
     uint32_t seq;
     Time time;
   };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
 
-  /// @cond include_hidden
   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
+   * \struct This struct contains the state of a requested sequence number, until its Data
    */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
+  struct SeqState {
+    uint32_t seq;
+    uint32_t retxCount; ///< number of transmissions
+    Time firstSent;     ///< time of the first transmission
+    Time lastSent;      ///< time of the last transmission
+    bool isUsed;        ///< whether the slot holds a sequence number
+    bool isOutstanding; ///< whether the last transmission has not timed out yet
   };
+  /// @endcond
 
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+  /// \brief transmissions in time order, including the ones retransmitted or answered since
+  std::deque<SeqTimeout> m_seqTimeouts;
 
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  /// \brief states of the sequence numbers, in a flat hash table with linear probing
+  std::vector<SeqState> m_seqStates;
+  size_t m_nSeqStates;      ///< \brief number of used slots of m_seqStates
+  uint32_t m_seqStatesBits; ///< \brief log2 of the size of m_seqStates
 
+  /// @cond include_hidden
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
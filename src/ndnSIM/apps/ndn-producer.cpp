@@ -51,19 +51,22 @@ Producer::GetTypeId(void)
          "Postfix that is added to the output data (e.g., for adding producer-uniqueness)",
          StringValue("/"), MakeNameAccessor(&Producer::m_postfix), MakeNameChecker())
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
-                    MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
+                    MakeUintegerAccessor(&Producer::GetPayloadSize, &Producer::SetPayloadSize),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
-                    TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
+                    TimeValue(Seconds(0)),
+                    MakeTimeAccessor(&Producer::GetFreshness, &Producer::SetFreshness),
                     MakeTimeChecker())
       .AddAttribute(
          "Signature",
          "Fake signature, 0 valid signature (default), other values application-specific",
-         UintegerValue(0), MakeUintegerAccessor(&Producer::m_signature),
+         UintegerValue(0), MakeUintegerAccessor(&Producer::GetSignature, &Producer::SetSignature),
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(),
+                    MakeNameAccessor(&Producer::GetKeyLocator, &Producer::SetKeyLocator),
+                    MakeNameChecker());
   return tid;
 }
 
@@ -91,24 +94,12 @@ Producer::StopApplication()
 }
 
 void
-Producer::OnInterest(shared_ptr<const Interest> interest)
+Producer::PrepareDataTemplate()
 {
-  App::OnInterest(interest); // tracing inside
-
-  NS_LOG_FUNCTION(this << interest);
-
-  if (!m_active)
-    return;
+  Data data;
+  data.setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
-
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  data.setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -120,12 +111,94 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   signature.setInfo(signatureInfo);
   signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
 
-  data->setSignature(signature);
+  data.setSignature(signature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+  // strip Data TLV header and the (empty) Name
+  const Block& wire = data.wireEncode();
+  wire.parse();
+  const Block& name = wire.get(::ndn::tlv::Name);
+  m_dataTail = make_shared< ::ndn::Buffer>(name.end(), wire.end());
+}
+
+void
+Producer::SetPayloadSize(uint32_t payloadSize)
+{
+  m_virtualPayloadSize = payloadSize;
+  m_dataTail = nullptr;
+}
+
+uint32_t
+Producer::GetPayloadSize() const
+{
+  return m_virtualPayloadSize;
+}
+
+void
+Producer::SetFreshness(Time freshness)
+{
+  m_freshness = freshness;
+  m_dataTail = nullptr;
+}
+
+Time
+Producer::GetFreshness() const
+{
+  return m_freshness;
+}
 
-  // to create real wire encoding
-  data->wireEncode();
+void
+Producer::SetSignature(uint32_t signature)
+{
+  m_signature = signature;
+  m_dataTail = nullptr;
+}
+
+uint32_t
+Producer::GetSignature() const
+{
+  return m_signature;
+}
+
+void
+Producer::SetKeyLocator(Name keyLocator)
+{
+  m_keyLocator = keyLocator;
+  m_dataTail = nullptr;
+}
+
+Name
+Producer::GetKeyLocator() const
+{
+  return m_keyLocator;
+}
+
+void
+Producer::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  if (m_dataTail == nullptr) {
+    PrepareDataTemplate();
+  }
+
+  const Block& nameWire = interest->getName().wireEncode();
+  size_t dataLength = nameWire.size() + m_dataTail->size();
+
+  // Data ::= DATA-TLV TLV-LENGTH Name <pre-encoded tail>
+  ::ndn::EncodingBuffer encoder(dataLength + 1 + ::ndn::tlv::sizeOfVarNumber(dataLength), 0);
+  encoder.prependByteArray(m_dataTail->buf(), m_dataTail->size());
+  encoder.prependByteArray(nameWire.wire(), nameWire.size());
+  encoder.prependVarNumber(dataLength);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  auto data = make_shared<Data>(encoder.block());
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
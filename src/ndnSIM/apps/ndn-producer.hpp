@@ -59,6 +59,43 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Pre-encode the part of Data packets that does not depend on the Interest
+   *
+   * Everything after the Name (MetaInfo, Content, SignatureInfo and SignatureValue) is the same
+   * for all Data packets of the producer, so it is encoded once and each Data packet is
+   * assembled by copying the Interest name and this tail into a single buffer.
+   */
+  void
+  PrepareDataTemplate();
+
+  // the setters of the attributes of the Data packets drop the template, which is encoded again
+  // with the new values at the next Interest
+  void
+  SetPayloadSize(uint32_t payloadSize);
+
+  uint32_t
+  GetPayloadSize() const;
+
+  void
+  SetFreshness(Time freshness);
+
+  Time
+  GetFreshness() const;
+
+  void
+  SetSignature(uint32_t signature);
+
+  uint32_t
+  GetSignature() const;
+
+  void
+  SetKeyLocator(Name keyLocator);
+
+  Name
+  GetKeyLocator() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +104,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  ::ndn::ConstBufferPtr m_dataTail;
 };
 
 } // namespace ndn
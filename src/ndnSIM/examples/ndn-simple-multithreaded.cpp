@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-simple-multithreaded.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/mpi-interface.h"
+
+namespace ns3 {
+
+/**
+ * This scenario simulates the topology of ndn-simple-mpi.cpp, with each node
+ * simulated by its own thread of the same process:
+ *
+ *
+ *      +----------+     1 Mbps     +----------+
+ *      | consumer | <------------> | producer |
+ *      +----------+      10ms      +----------+
+ *
+ *
+ * Consumer requests data from producer with frequency 100 interests per second
+ * (interests contain constantly increasing sequence number).
+ *
+ * For every received interest, producer replies with a data packet, containing
+ * 1024 bytes of virtual payload.
+ *
+ * The MultithreadedSimulatorImpl runs one thread per system id and passes the packets
+ * crossing the link between the two nodes through shared memory, so no MPI installation
+ * is needed.  Unlike with MPI, the applications of all the nodes are installed, and each
+ * node writes its own trace file.
+ *
+ * To run scenario and see what is happening, use the following command:
+ *
+ *     NS_LOG=ndn.Consumer:ndn.Producer ./waf --run=ndn-simple-multithreaded
+ *
+ * To compare with the sequential simulator, use:
+ *
+ *     ./waf --run="ndn-simple-multithreaded --threads=1"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+  uint32_t threads = 2;
+
+  // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  CommandLine cmd;
+  cmd.AddValue("threads", "Number of threads (1 to use the default sequential simulator)", threads);
+  cmd.Parse(argc, argv);
+
+  if (threads > 1) {
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    GlobalValue::Bind("ThreadCount", UintegerValue(threads));
+
+    // Enable parallel simulator, with one system id per thread
+    MpiInterface::Enable(&argc, &argv);
+  }
+
+  uint32_t systemCount = threads > 1 ? MpiInterface::GetSize() : 1;
+
+  // Creating nodes
+
+  // consumer node is associated with system id 0
+  Ptr<Node> node1 = CreateObject<Node>(0);
+
+  // producer node is associated with system id 1 (or 0 when running on single thread)
+  Ptr<Node> node2 = CreateObject<Node>(systemCount >= 2 ? 1 : 0);
+
+  // Connecting nodes using a link
+  PointToPointHelper p2p;
+  p2p.Install(node1, node2);
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::AddRoute(node1, "/prefix/1", node2, 1);
+  ndn::FibHelper::AddRoute(node2, "/prefix/2", node1, 1);
+
+  // Installing applications
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetAttribute("Frequency", StringValue("100")); // 100 interests a second
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+
+  // All the applications are installed: each one runs in the thread of its node
+  consumerHelper.SetPrefix("/prefix/1"); // request /prefix/1/*
+  consumerHelper.Install(node1);
+
+  producerHelper.SetPrefix("/prefix/2"); // serve /prefix/2/*
+  producerHelper.Install(node1);
+
+  consumerHelper.SetPrefix("/prefix/2"); // request /prefix/2/*
+  consumerHelper.Install(node2);
+
+  producerHelper.SetPrefix("/prefix/1"); // serve /prefix/1/*
+  producerHelper.Install(node2);
+
+  // one output file per node, as the tracers of different threads cannot share a stream
+  ndn::L3RateTracer::Install(node1, "node1.txt", Seconds(0.5));
+  ndn::L3RateTracer::Install(node2, "node2.txt", Seconds(0.5));
+
+  Simulator::Stop(Seconds(400.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  if (threads > 1) {
+    MpiInterface::Disable();
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
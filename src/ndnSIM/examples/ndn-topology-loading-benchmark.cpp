@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-topology-loading-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * This program measures the wall-clock time to start a simulation as the size of the topology
+ * grows: reading an annotated topology file with AnnotatedTopologyReader, then installing the
+ * NDN stack on all its nodes.
+ *
+ * The topologies are generated in a temporary file: a ring of nodes, each also linked to the
+ * nodes 7 and 31 positions ahead, so that a node has 6 neighbors.
+ *
+ * To run the benchmark:
+ *
+ *     ./waf --run="ndn-topology-loading-benchmark --maxNodes=100000"
+ *
+ * The times depend on the machine: to measure a change to the readers, run the benchmark with
+ * an optimized build before and after the change, on the same machine.
+ */
+
+static uint32_t
+WriteTopology(const std::string& file, uint32_t nNodes)
+{
+  std::ofstream os(file.c_str(), std::ios::trunc);
+  os << "router\n";
+  for (uint32_t node = 0; node < nNodes; node++) {
+    os << "Node" << node << "\tNA\t" << 1 + node / 100 << "\t" << 1 + node % 100 << "\n";
+  }
+
+  uint32_t nLinks = 0;
+  os << "link\n";
+  for (uint32_t node = 0; node < nNodes; node++) {
+    for (uint32_t offset : {1, 7, 31}) {
+      if (2 * offset >= nNodes)
+        continue; // in a small ring, the link would be a duplicate
+
+      os << "Node" << node << "\tNode" << (node + offset) % nNodes << "\t1Mbps\t1\t10ms\t20\n";
+      nLinks++;
+    }
+  }
+  return nLinks;
+}
+
+static void
+RunOnce(const std::string& file, int64_t& readMs, int64_t& installMs)
+{
+  SystemWallClockMs clock;
+
+  clock.Start();
+  AnnotatedTopologyReader topologyReader("", 1);
+  topologyReader.SetFileName(file);
+  topologyReader.Read();
+  readMs = clock.End();
+
+  clock.Start();
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+  installMs = clock.End();
+
+  Simulator::Destroy();
+  Names::Clear();
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t minNodes = 100;
+  uint32_t maxNodes = 10000;
+  std::string file = "ndn-topology-loading-benchmark.txt";
+
+  CommandLine cmd;
+  cmd.AddValue("minNodes", "smallest number of nodes", minNodes);
+  cmd.AddValue("maxNodes", "largest number of nodes", maxNodes);
+  cmd.AddValue("file", "temporary file of the generated topologies", file);
+  cmd.Parse(argc, argv);
+
+  std::cout << "nodes\tlinks\tread ms\tinstall ms" << std::endl;
+  for (uint64_t nNodes = minNodes; nNodes <= maxNodes; nNodes *= 10) {
+    uint32_t nLinks = WriteTopology(file, nNodes);
+
+    int64_t readMs = 0, installMs = 0;
+    RunOnce(file, readMs, installMs);
+    std::cout << nNodes << "\t" << nLinks << "\t" << readMs << "\t" << installMs << std::endl;
+  }
+  std::remove(file.c_str());
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
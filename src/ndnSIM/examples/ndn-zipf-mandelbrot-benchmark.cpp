@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-zipf-mandelbrot-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * This program measures how many Interests per second of wall-clock time a
+ * ConsumerZipfMandelbrot sends as the number of contents grows.
+ *
+ * The consumer and the producer run on the same node, so that the cost of the content
+ * selection is not hidden by link transmissions:
+ *
+ *     (consumer + producer)
+ *
+ * To run the benchmark:
+ *
+ *     ./waf --run="ndn-zipf-mandelbrot-benchmark --maxContents=100000000"
+ */
+
+static double
+RunOnce(uint32_t nContents, double frequency, double duration)
+{
+  NodeContainer nodes;
+  nodes.Create(1);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(nodes);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+  consumerHelper.SetAttribute("NumberOfContents", UintegerValue(nContents));
+  ApplicationContainer consumer = consumerHelper.Install(nodes);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("100"));
+  producerHelper.Install(nodes);
+
+  SystemWallClockMs clock;
+  clock.Start();
+  Simulator::Stop(Seconds(duration));
+  Simulator::Run();
+  int64_t ms = clock.End();
+
+  IntegerValue nInterests;
+  consumer.Get(0)->GetAttribute("StartSeq", nInterests);
+  Simulator::Destroy();
+
+  return nInterests.Get() * 1000.0 / std::max<int64_t>(ms, 1);
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t minContents = 100;
+  uint32_t maxContents = 100000000;
+  double frequency = 100000;
+  double duration = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue("minContents", "smallest number of contents", minContents);
+  cmd.AddValue("maxContents", "largest number of contents", maxContents);
+  cmd.AddValue("frequency", "Interests per second of simulated time", frequency);
+  cmd.AddValue("duration", "simulated time of each run, in seconds", duration);
+  cmd.Parse(argc, argv);
+
+  std::cout << "contents\tinterests/s" << std::endl;
+  for (uint64_t nContents = minContents; nContents <= maxContents; nContents *= 10) {
+    std::cout << nContents << "\t" << RunOnce(nContents, frequency, duration) << std::endl;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -53,6 +53,7 @@ InrppStackHelper::InrppStackHelper()
   , m_isStrategyChoiceManagerDisabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(1000)
+  , m_isReceiveBatchingEnabled(false)
 {
   setCustomNdnCxxClocks();
 
@@ -137,6 +138,12 @@ InrppStackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+InrppStackHelper::setReceiveBatching(bool isEnabled)
+{
+  m_isReceiveBatchingEnabled = isEnabled;
+}
+
 void
 InrppStackHelper::setPolicy(const std::string& policy)
 {
@@ -288,6 +295,7 @@ InrppStackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<InrppL3Protocol>
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    "netdev://[ff:ff:ff:ff:ff:ff]");
+  transport->SetReceiveBatching(m_isReceiveBatchingEnabled);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
@@ -331,6 +339,7 @@ InrppStackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<InrppL3Proto
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    constructFaceUri(remoteNetDevice));
+  transport->SetReceiveBatching(m_isReceiveBatchingEnabled);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
@@ -80,6 +80,15 @@ public:
   void
   setCsSize(size_t maxSize);
 
+  /**
+   * @brief Enable delivery of packets received at the same simulated time in one batch
+   *
+   * Affects faces created on NetDevices after the call.
+   * @sa NetDeviceTransport::SetReceiveBatching
+   */
+  void
+  setReceiveBatching(bool isEnabled);
+
   /**
    * @brief Set the cache replacement policy for NFD's Content Store
    */
@@ -276,6 +285,7 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  bool m_isReceiveBatchingEnabled;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-checkpoint-helper.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/raw-text-config.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CheckpointHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'C', 'K', 'P', 'T', '\0'};
+const uint32_t VERSION = 1;
+
+/// Write an unsigned integer, in little-endian order
+template<typename T>
+void
+writeNumber(std::ostream& os, T value)
+{
+  for (size_t i = 0; i < sizeof(T); i++) {
+    os.put(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+template<typename T>
+T
+readNumber(std::istream& is)
+{
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    int byte = is.get();
+    if (byte == std::char_traits<char>::eof()) {
+      NS_FATAL_ERROR("Truncated checkpoint");
+    }
+    value |= static_cast<T>(byte) << (8 * i);
+  }
+  return value;
+}
+
+void
+writeBlock(std::ostream& os, const Block& block)
+{
+  writeNumber<uint32_t>(os, block.size());
+  os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+}
+
+Block
+readBlock(std::istream& is)
+{
+  uint32_t size = readNumber<uint32_t>(is);
+  std::vector<uint8_t> buffer(size);
+  if (!is.read(reinterpret_cast<char*>(buffer.data()), size)) {
+    NS_FATAL_ERROR("Truncated checkpoint");
+  }
+  return Block(buffer.data(), buffer.size());
+}
+
+/// Set the attribute of the objects of a path, if its value differs
+void
+restoreAttribute(const std::string& path, const std::string& value)
+{
+  std::string::size_type slash = path.rfind('/');
+  std::string name = path.substr(slash + 1);
+  Config::MatchContainer objects = Config::LookupMatches(path.substr(0, slash));
+  if (objects.GetN() == 0) {
+    NS_LOG_WARN("No object for " << path);
+  }
+
+  for (Config::MatchContainer::Iterator object = objects.Begin(); object != objects.End();
+       object++) {
+    StringValue current;
+    if ((*object)->GetAttributeFailSafe(name, current) && current.Get() == value) {
+      continue;
+    }
+    NS_LOG_DEBUG(path << " = " << value);
+    if (!(*object)->SetAttributeFailSafe(name, StringValue(value))) {
+      NS_LOG_WARN("Cannot restore " << path << " = " << value);
+    }
+  }
+}
+
+void
+restoreAttributes(const std::string& filename)
+{
+  std::ifstream is(filename.c_str());
+  if (!is) {
+    NS_FATAL_ERROR("Cannot open " << filename);
+  }
+
+  // value <path> "<value>", where the value may contain spaces
+  std::string line;
+  while (std::getline(is, line)) {
+    std::string::size_type pathStart = line.find(' ');
+    std::string::size_type pathEnd = line.find(' ', pathStart + 1);
+    std::string::size_type valueStart = line.find('"', pathEnd);
+    std::string::size_type valueEnd = line.rfind('"');
+    if (line.compare(0, pathStart, "value") != 0 || valueStart == std::string::npos
+        || valueEnd == valueStart) {
+      continue;
+    }
+    restoreAttribute(line.substr(pathStart + 1, pathEnd - pathStart - 1),
+                     line.substr(valueStart + 1, valueEnd - valueStart - 1));
+  }
+}
+
+void
+saveNode(std::ostream& os, Ptr<Node> node, Ptr<L3Protocol> l3)
+{
+  writeNumber<uint32_t>(os, node->GetId());
+
+  const nfd::Fib& fib = l3->getForwarder()->getFib();
+  writeNumber<uint32_t>(os, fib.size());
+  for (const nfd::fib::Entry& entry : fib) {
+    writeBlock(os, entry.getPrefix().wireEncode());
+    writeNumber<uint32_t>(os, entry.getNextHops().size());
+    for (const nfd::fib::NextHop& nextHop : entry.getNextHops()) {
+      writeNumber<uint64_t>(os, nextHop.getFace().getId());
+      writeNumber<uint64_t>(os, nextHop.getCost());
+    }
+  }
+
+  const nfd::Cs& cs = l3->getForwarder()->getCs();
+  writeNumber<uint32_t>(os, cs.size());
+  for (const nfd::cs::Entry& entry : cs) {
+    os.put(entry.isUnsolicited() ? 1 : 0);
+    writeBlock(os, entry.getData().wireEncode());
+  }
+
+  std::vector<shared_ptr<const Data>> contents;
+  Ptr<ContentStore> contentStore = node->GetObject<ContentStore>();
+  if (contentStore != 0) {
+    for (Ptr<cs::Entry> entry = contentStore->Begin(); entry != contentStore->End();
+         entry = contentStore->Next(entry)) {
+      contents.push_back(entry->GetData());
+    }
+  }
+  writeNumber<uint32_t>(os, contents.size());
+  for (const auto& data : contents) {
+    writeBlock(os, data->wireEncode());
+  }
+}
+
+void
+restoreNode(std::istream& is)
+{
+  uint32_t nodeId = readNumber<uint32_t>(is);
+  if (nodeId >= NodeList::GetNNodes() || NodeList::GetNode(nodeId)->GetObject<L3Protocol>() == 0) {
+    NS_FATAL_ERROR("Node " << nodeId << " of the checkpoint has no NDN stack");
+  }
+  Ptr<Node> node = NodeList::GetNode(nodeId);
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+
+  // the faces of the applications do not exist before they start, and they add their own routes
+  nfd::Fib& fib = l3->getForwarder()->getFib();
+  uint32_t nEntries = readNumber<uint32_t>(is);
+  for (uint32_t i = 0; i < nEntries; i++) {
+    Name prefix(readBlock(is));
+    uint32_t nNextHops = readNumber<uint32_t>(is);
+    for (uint32_t j = 0; j < nNextHops; j++) {
+      uint64_t faceId = readNumber<uint64_t>(is);
+      uint64_t cost = readNumber<uint64_t>(is);
+      shared_ptr<Face> face = l3->getFaceById(faceId);
+      if (face == nullptr) {
+        NS_LOG_DEBUG("Node " << nodeId << ": no face " << faceId << " for " << prefix);
+        continue;
+      }
+      fib.insert(prefix).first->addNextHop(*face, cost);
+    }
+  }
+
+  nfd::Cs& cs = l3->getForwarder()->getCs();
+  uint32_t nData = readNumber<uint32_t>(is);
+  for (uint32_t i = 0; i < nData; i++) {
+    bool isUnsolicited = is.get() != 0;
+    cs.insert(*make_shared<Data>(readBlock(is)), isUnsolicited);
+  }
+
+  Ptr<ContentStore> contentStore = node->GetObject<ContentStore>();
+  nData = readNumber<uint32_t>(is);
+  for (uint32_t i = 0; i < nData; i++) {
+    auto data = make_shared<Data>(readBlock(is));
+    if (contentStore != 0) {
+      contentStore->Add(data);
+    }
+  }
+  NS_LOG_DEBUG("Node " << nodeId << ": " << nEntries << " FIB entries, " << cs.size()
+                       << " Data in CS");
+}
+
+} // namespace
+
+void
+CheckpointHelper::Save(const std::string& filename)
+{
+  NS_LOG_FUNCTION(filename << Simulator::Now());
+
+  {
+    RawTextConfigSave attributes;
+    attributes.SetFilename(filename + ".attributes");
+    attributes.Default();
+    attributes.Global();
+    attributes.Attributes();
+  }
+
+  std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!os) {
+    NS_FATAL_ERROR("Cannot open " << filename);
+  }
+  os.write(MAGIC, sizeof(MAGIC));
+  writeNumber<uint32_t>(os, VERSION);
+  writeNumber<uint64_t>(os, Simulator::Now().GetTimeStep());
+
+  // the components of the states are integers below 2^32
+  std::vector<RandomVariableStream::RngState> states = RandomVariableStream::GetRngStates();
+  writeNumber<uint32_t>(os, states.size());
+  for (const auto& state : states) {
+    writeNumber<uint64_t>(os, state.stream);
+    for (int i = 0; i < 6; i++) {
+      writeNumber<uint64_t>(os, static_cast<uint64_t>(state.state[i]));
+    }
+  }
+
+  std::vector<Ptr<Node>> nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if ((*node)->GetObject<L3Protocol>() != 0) {
+      nodes.push_back(*node);
+    }
+  }
+  writeNumber<uint32_t>(os, nodes.size());
+  for (Ptr<Node> node : nodes) {
+    saveNode(os, node, node->GetObject<L3Protocol>());
+  }
+
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write " << filename);
+  }
+}
+
+void
+CheckpointHelper::RestoreDefaults(const std::string& filename)
+{
+  NS_LOG_FUNCTION(filename);
+  RawTextConfigLoad attributes;
+  attributes.SetFilename(filename + ".attributes");
+  attributes.Default();
+  attributes.Global();
+}
+
+Time
+CheckpointHelper::Restore(const std::string& filename)
+{
+  NS_LOG_FUNCTION(filename);
+  restoreAttributes(filename + ".attributes");
+
+  std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(MAGIC)];
+  if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+    NS_FATAL_ERROR(filename << " is not a checkpoint");
+  }
+  uint32_t version = readNumber<uint32_t>(is);
+  if (version != VERSION) {
+    NS_FATAL_ERROR("Unsupported checkpoint version " << version);
+  }
+  Time time = TimeStep(static_cast<int64_t>(readNumber<uint64_t>(is)));
+
+  std::vector<RandomVariableStream::RngState> states(readNumber<uint32_t>(is));
+  for (auto& state : states) {
+    state.stream = readNumber<uint64_t>(is);
+    for (int i = 0; i < 6; i++) {
+      state.state[i] = static_cast<double>(readNumber<uint64_t>(is));
+    }
+  }
+  uint32_t nRestored = RandomVariableStream::SetRngStates(states);
+  if (nRestored != states.size()) {
+    NS_LOG_WARN("Restored " << nRestored << " of " << states.size() << " random variable streams");
+  }
+
+  uint32_t nNodes = readNumber<uint32_t>(is);
+  for (uint32_t i = 0; i < nNodes; i++) {
+    restoreNode(is);
+  }
+
+  NS_LOG_INFO("Restored the checkpoint of " << time.GetSeconds() << "s from " << filename);
+  return time;
+}
+
+} // namespace ndn
+} // namespace ns3
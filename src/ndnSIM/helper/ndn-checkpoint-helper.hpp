@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CHECKPOINT_HELPER_H
+#define NDN_CHECKPOINT_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to checkpoint the warmed-up state of a simulation and restore it in a later run
+ *
+ * Long runs often spend most of their time warming up caches before the interesting part of the
+ * experiment.  The helper saves, at a given time of a run, the state which the warm-up builds:
+ *
+ * - the attributes of all the objects and the default and global values, with ConfigStore in the
+ *   raw text format (`<filename>.attributes`), which includes the sequence numbers of the
+ *   consumer applications (StartSeq attribute);
+ * - in a compact binary file (`<filename>`), the positions of all the random variable streams,
+ *   and for each node the FIB entries and the contents of the NFD content store or of the ndnSIM
+ *   content store.
+ *
+ * A later run of the same scenario script restores the checkpoint instead of warming up:
+ *
+ * @code
+ *   ndn::CheckpointHelper::RestoreDefaults("warm.ckpt"); // before creating the topology
+ *   // ... create the topology, install the stack, the routes and the applications ...
+ *   ndn::CheckpointHelper::Restore("warm.ckpt");         // just before Simulator::Run
+ * @endcode
+ *
+ * The restored run starts at time 0, with the warmed-up tables and streams.  Scheduled events,
+ * the PIT and the measurements of the strategies are not saved: they are transient, and the
+ * events are arbitrary callbacks.  The objects are matched by their configuration paths and the
+ * random variable streams by their stream numbers and creation order, so the scenario must create
+ * the same objects in the same order as the run which saved the checkpoint.  The cached Data keep
+ * their freshness period, counted from the restore.
+ */
+class CheckpointHelper {
+public:
+  /**
+   * @brief Save the state of the simulation, e.g., from an event scheduled at the end of the
+   *        warm-up
+   * @param filename name of the binary file, with the attributes in `<filename>.attributes`
+   */
+  static void
+  Save(const std::string& filename);
+
+  /**
+   * @brief Restore the default and global values of a checkpoint
+   *
+   * Must be called before the objects of the scenario are created.
+   */
+  static void
+  RestoreDefaults(const std::string& filename);
+
+  /**
+   * @brief Restore the attributes, random variable streams, FIB and content stores of a
+   *        checkpoint
+   *
+   * Must be called after the scenario is set up, before the simulation runs.  Only the attributes
+   * whose value differs from the checkpoint are set, so that setting them has no side effect,
+   * e.g., on the random variable streams of the applications.
+   *
+   * @return the simulation time at which the checkpoint was saved
+   */
+  static Time
+  Restore(const std::string& filename);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHECKPOINT_HELPER_H
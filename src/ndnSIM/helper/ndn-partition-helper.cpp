@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-partition-helper.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <numeric>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PartitionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+Time
+PartitionHelper::GetLookahead()
+{
+  Time lookahead = Time::Max();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (uint32_t i = 0; i < (*node)->GetNDevices(); i++) {
+      Ptr<PointToPointChannel> channel =
+        DynamicCast<PointToPointChannel>((*node)->GetDevice(i)->GetChannel());
+      if (channel == nullptr || channel->GetNDevices() != 2) {
+        continue;
+      }
+
+      if (channel->GetDevice(0)->GetNode()->GetSystemId()
+          != channel->GetDevice(1)->GetNode()->GetSystemId()) {
+        TimeValue delay;
+        channel->GetAttribute("Delay", delay);
+        lookahead = std::min(lookahead, delay.Get());
+      }
+    }
+  }
+  return lookahead;
+}
+
+std::vector<double>
+PartitionHelper::GetLoads()
+{
+  std::vector<double> loads;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    uint32_t systemId = (*node)->GetSystemId();
+    if (loads.size() <= systemId) {
+      loads.resize(systemId + 1, 0.0);
+    }
+    loads[systemId] += GetNodeLoad(*node);
+  }
+  return loads;
+}
+
+double
+PartitionHelper::GetNodeLoad(Ptr<Node> node)
+{
+  return 1 + node->GetNDevices() + node->GetNApplications();
+}
+
+void
+PartitionHelper::Report(std::ostream& os)
+{
+  std::vector<double> loads = GetLoads();
+  std::vector<uint32_t> nNodes(loads.size(), 0);
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nNodes[(*node)->GetSystemId()]++;
+  }
+
+  Time lookahead = GetLookahead();
+  os << "Lookahead: ";
+  if (lookahead == Time::Max()) {
+    os << "unlimited";
+  }
+  else {
+    os << lookahead.As(Time::MS);
+  }
+  os << "\n";
+
+  double average = std::accumulate(loads.begin(), loads.end(), 0.0) / loads.size();
+  for (uint32_t systemId = 0; systemId < loads.size(); systemId++) {
+    os << "System id " << systemId << ": " << nNodes[systemId] << " nodes, load " << loads[systemId]
+       << "\n";
+  }
+  if (!loads.empty() && average > 0) {
+    os << "Imbalance: " << *std::max_element(loads.begin(), loads.end()) / average << "\n";
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PARTITION_HELPER_H
+#define NDN_PARTITION_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+
+#include <iostream>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper class to report how the nodes are partitioned between system ids for
+ *        parallel simulations
+ *
+ * The report gives the lookahead of the parallel simulators, i.e., the smallest delay of the
+ * point-to-point links between nodes of different system ids, and the expected event load of each
+ * system id, estimated from the numbers of devices and applications of its nodes.
+ *
+ * @see AnnotatedTopologyReader::EnableAutomaticPartitioning
+ */
+class PartitionHelper {
+public:
+  /**
+   * @brief Get the smallest delay of the point-to-point links between different system ids
+   * @return the smallest delay, or the maximum simulation time if there is no such link
+   */
+  static Time
+  GetLookahead();
+
+  /**
+   * @brief Get the expected event load of each system id
+   */
+  static std::vector<double>
+  GetLoads();
+
+  /**
+   * @brief Get the expected event load of a node: 1 + number of devices + number of applications
+   */
+  static double
+  GetNodeLoad(Ptr<Node> node);
+
+  /**
+   * @brief Print the lookahead, and the number of nodes and the load of each system id
+   */
+  static void
+  Report(std::ostream& os = std::cout);
+}; // PartitionHelper
+
+} // ndn
+} // ns3
+
+#endif // NDN_PARTITION_HELPER_H
@@ -52,6 +52,7 @@ StackHelper::StackHelper()
   , m_isStrategyChoiceManagerDisabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_isReceiveBatchingEnabled(false)
 {
   setCustomNdnCxxClocks();
 
@@ -136,6 +137,12 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setReceiveBatching(bool isEnabled)
+{
+  m_isReceiveBatchingEnabled = isEnabled;
+}
+
 void
 StackHelper::setPolicy(const std::string& policy)
 {
@@ -286,6 +293,7 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
 		  	  	  	  	  	  	  	  	  	  	  netdev,
                                                    "netdev://[ff:ff:ff:ff:ff:ff]");
+  transport->SetReceiveBatching(m_isReceiveBatchingEnabled);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
@@ -324,6 +332,7 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    constructFaceUri(remoteNetDevice));
+  transport->SetReceiveBatching(m_isReceiveBatchingEnabled);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
@@ -33,6 +33,7 @@
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "cs/ndn-content-store.hpp"
+#include "../utils/tracers/ndn-packet-event-recorder.hpp"
 
 #include <boost/property_tree/info_parser.hpp>
 
@@ -440,6 +441,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_inInterests(interest, *face);
+        NDN_RECORD_PACKET_EVENT(this->m_packetEvents, IN_INTEREST, interest, *face);
       }
     });
 
@@ -447,6 +449,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_inData(data, *face);
+        NDN_RECORD_PACKET_EVENT(this->m_packetEvents, IN_DATA, data, *face);
       }
     });
 
@@ -454,6 +457,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_inNack(nack, *face);
+        NDN_RECORD_PACKET_EVENT(this->m_packetEvents, IN_NACK, nack, *face);
       }
     });
 
@@ -463,6 +467,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_outInterests(interest, *face);
+        NDN_RECORD_PACKET_EVENT(this->m_packetEvents, OUT_INTEREST, interest, *face);
       }
     });
 
@@ -470,6 +475,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_outData(data, *face);
+        NDN_RECORD_PACKET_EVENT(this->m_packetEvents, OUT_DATA, data, *face);
       }
     });
 
@@ -478,6 +484,7 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_outNack(nack, *face);
+        NDN_RECORD_PACKET_EVENT(this->m_packetEvents, OUT_NACK, nack, *face);
       }
     });
 
@@ -510,6 +517,18 @@ L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice) const
   return nullptr;
 }
 
+void
+L3Protocol::setPacketEventRecorder(shared_ptr<PacketEventRecorder> recorder)
+{
+  m_packetEvents = recorder;
+}
+
+shared_ptr<PacketEventRecorder>
+L3Protocol::getPacketEventRecorder() const
+{
+  return m_packetEvents;
+}
+
 Ptr<L3Protocol>
 L3Protocol::getL3Protocol(Ptr<Object> node)
 {
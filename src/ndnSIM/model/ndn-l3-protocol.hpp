@@ -53,6 +53,8 @@ class Header;
 
 namespace ndn {
 
+class PacketEventRecorder;
+
 /**
  * \defgroup ndn ndnSIM: NDN simulation module
  *
@@ -146,6 +148,20 @@ public:
   shared_ptr<Face>
   getFaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
+  /**
+   * \brief Set the recorder of the sampled packet events of the faces, or nullptr for none
+   *
+   * Unlike the trace sources, which are called with each packet, the recorder stores a compact
+   * record of only the sampled packets.
+   *
+   * \see L3SamplingTracer
+   */
+  void
+  setPacketEventRecorder(shared_ptr<PacketEventRecorder> recorder);
+
+  shared_ptr<PacketEventRecorder>
+  getPacketEventRecorder() const;
+
   /**
    * \brief Get NFD config (boost::property_tree)
    */
@@ -219,6 +235,8 @@ protected:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+
+  shared_ptr<PacketEventRecorder> m_packetEvents; ///< @brief recorder of sampled packet events
 };
 
 } // namespace ndn
@@ -23,6 +23,8 @@
 #include "ndn-block-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
+#include "ns3/simulator.h"
+
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
@@ -41,6 +43,7 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        ::ndn::nfd::LinkType linkType)
   : m_netDevice(netDevice)
   , m_node(node)
+  , m_isReceiveBatchingEnabled(false)
 {
   this->setLocalUri(FaceUri(localUri));
   this->setRemoteUri(FaceUri(remoteUri));
@@ -62,6 +65,7 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+  Simulator::Cancel(m_flushEvent);
 }
 
 void
@@ -99,6 +103,23 @@ NetDeviceTransport::doSend(Packet&& packet)
                     L3Protocol::ETHERNET_FRAME_TYPE);
 }
 
+void
+NetDeviceTransport::doSendBatch(std::vector<Packet>&& packets)
+{
+  NS_LOG_FUNCTION(this << "Sending" << packets.size() << "packets from netDevice with URI"
+                  << this->getLocalUri());
+
+  const Address broadcast = m_netDevice->GetBroadcast();
+  for (const Packet& packet : packets) {
+    BlockHeader header(packet);
+
+    Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(header);
+
+    m_netDevice->Send(ns3Packet, broadcast, L3Protocol::ETHERNET_FRAME_TYPE);
+  }
+}
+
 // callback
 void
 NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
@@ -107,17 +128,54 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
                                       const Address& from, const Address& to,
                                       NetDevice::PacketType packetType)
 {
-  NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
-
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
+  if (!m_isReceiveBatchingEnabled) {
+    NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
+  }
 
+  // Convert NS3 packet to NFD packet; the block is copied out of the packet, so there is no
+  // need to copy the packet itself
   BlockHeader header;
-  packet->RemoveHeader(header);
+  p->PeekHeader(header);
 
   auto nfdPacket = Packet(std::move(header.getBlock()));
 
-  this->receive(std::move(nfdPacket));
+  if (!m_isReceiveBatchingEnabled) {
+    this->receive(std::move(nfdPacket));
+    return;
+  }
+
+  // the flush event is scheduled after all events already pending for the current time,
+  // including deliveries of the other packets of the same burst
+  if (m_receiveBatch.empty()) {
+    m_flushEvent = Simulator::ScheduleNow(&NetDeviceTransport::flushReceiveBatch, this);
+  }
+  m_receiveBatch.push_back(std::move(nfdPacket));
+}
+
+void
+NetDeviceTransport::flushReceiveBatch()
+{
+  NS_LOG_FUNCTION(this << m_receiveBatch.size());
+
+  std::vector<Packet> batch;
+  batch.swap(m_receiveBatch);
+
+  if (batch.size() == 1) {
+    this->receive(std::move(batch.front()));
+  }
+  else {
+    this->receive(std::move(batch));
+  }
+}
+
+void
+NetDeviceTransport::SetReceiveBatching(bool isEnabled)
+{
+  if (!isEnabled && !m_receiveBatch.empty()) {
+    Simulator::Cancel(m_flushEvent);
+    flushReceiveBatch();
+  }
+  m_isReceiveBatchingEnabled = isEnabled;
 }
 
 Ptr<NetDevice>
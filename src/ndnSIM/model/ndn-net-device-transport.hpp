@@ -28,6 +28,7 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/event-id.h"
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
@@ -54,6 +55,21 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Enable or disable batched delivery of received packets
+   *
+   * When enabled, packets arriving from the NetDevice at the same simulated time are
+   * accumulated and passed to the LinkService in one batch, after all events already
+   * scheduled for that time have been processed.  The order of packets is preserved and
+   * the simulation stays deterministic, but processing of a burst is deferred to the end
+   * of the current timestamp.  Disabled by default.
+   *
+   * The effect on the run time has not been measured; tests/other/ndn-burst-test.cpp compares
+   * the Interests processed per real second with and without batching.
+   */
+  void
+  SetReceiveBatching(bool isEnabled);
+
 private:
   virtual void
   beforeChangePersistency(::ndn::nfd::FacePersistency newPersistency) override;
@@ -64,6 +80,9 @@ private:
   virtual void
   doSend(Packet&& packet) override;
 
+  virtual void
+  doSendBatch(std::vector<Packet>&& packets) override;
+
   void
   receiveFromNetDevice(Ptr<NetDevice> device,
                        Ptr<const ns3::Packet> p,
@@ -71,8 +90,15 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  void
+  flushReceiveBatch();
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+
+  bool m_isReceiveBatchingEnabled;
+  std::vector<Packet> m_receiveBatch; ///< \brief packets received at the current timestamp
+  EventId m_flushEvent;
 };
 
 } // namespace ndn
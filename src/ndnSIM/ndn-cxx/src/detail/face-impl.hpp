@@ -26,6 +26,7 @@
 #include "../face.hpp"
 
 #include "registered-prefix.hpp"
+#include "interest-filter-table.hpp"
 #include "pending-interest.hpp"
 #include "container-with-on-empty-signal.hpp"
 
@@ -52,7 +53,6 @@ class Face::Impl : noncopyable
 {
 public:
   typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord>> InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   explicit
@@ -151,27 +151,20 @@ public: // producer
   void
   asyncSetInterestFilter(shared_ptr<InterestFilterRecord> interestFilterRecord)
   {
-    m_interestFilterTable.push_back(interestFilterRecord);
+    m_interestFilterTable.insert(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end()) {
-      m_interestFilterTable.erase(i);
-    }
+    m_interestFilterTable.erase(interestFilterId);
   }
 
   void
   processInterestFilters(Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatches(interest.getName())) {
+      filter->invokeInterestCallback(interest);
     }
   }
 
@@ -214,7 +207,7 @@ public: // prefix registration
 
     if (registeredPrefix->getFilter() != nullptr) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (onSuccess != nullptr) {
@@ -236,7 +229,7 @@ public: // prefix registration
 
       if (filter != nullptr) {
         // it was a combined operation
-        m_interestFilterTable.remove(filter);
+        m_interestFilterTable.erase(filter);
       }
 
       nfd::ControlParameters params;
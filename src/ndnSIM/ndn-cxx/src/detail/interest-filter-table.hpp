@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "../face.hpp"
+
+#include "interest-filter-record.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief table of InterestFilterRecords indexed by filter prefix
+ *
+ * Records are kept in a name trie keyed by the prefix of their InterestFilter, so finding the
+ * filters matching an Interest takes one child lookup per Interest name component, regardless
+ * of the number of registered filters.  Regex filters are stored at their prefix node and the
+ * regex is evaluated only for Interests under that prefix.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  InterestFilterTable()
+    : m_nextSeq(0)
+  {
+  }
+
+  void
+  insert(const shared_ptr<InterestFilterRecord>& record)
+  {
+    const Name& prefix = record->getFilter().getPrefix();
+    Node* node = &m_root;
+    for (const name::Component& component : prefix) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+    node->records.push_back(std::make_pair(m_nextSeq++, record));
+    m_index[record.get()] = record;
+  }
+
+  /**
+   * @brief remove the record
+   * @return whether the record was found
+   */
+  bool
+  erase(const shared_ptr<InterestFilterRecord>& record)
+  {
+    return erase(reinterpret_cast<const InterestFilterId*>(record.get()));
+  }
+
+  /**
+   * @brief remove the record with the specified id
+   * @return whether the record was found
+   */
+  bool
+  erase(const InterestFilterId* interestFilterId)
+  {
+    auto it = m_index.find(reinterpret_cast<const InterestFilterRecord*>(interestFilterId));
+    if (it == m_index.end()) {
+      return false;
+    }
+    shared_ptr<InterestFilterRecord> record = it->second;
+    m_index.erase(it);
+
+    eraseFromNode(m_root, record->getFilter().getPrefix(), 0, record.get());
+    return true;
+  }
+
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_index.empty();
+  }
+
+  /**
+   * @brief collect records matching @p name, in the order the records were inserted
+   *
+   * Records are returned by value, so it is safe to modify the table while invoking them.
+   */
+  std::vector<shared_ptr<InterestFilterRecord>>
+  findMatches(const Name& name) const
+  {
+    std::vector<Entry> matches;
+
+    const Node* node = &m_root;
+    size_t depth = 0;
+    while (true) {
+      for (const auto& entry : node->records) {
+        if (!entry.second->getFilter().hasRegexFilter() || entry.second->doesMatch(name)) {
+          matches.push_back(entry);
+        }
+      }
+
+      if (depth == name.size()) {
+        break;
+      }
+      auto child = node->children.find(name.get(depth));
+      if (child == node->children.end()) {
+        break;
+      }
+      node = child->second.get();
+      ++depth;
+    }
+
+    if (matches.size() > 1) {
+      std::sort(matches.begin(), matches.end(),
+                [] (const Entry& a, const Entry& b) { return a.first < b.first; });
+    }
+
+    std::vector<shared_ptr<InterestFilterRecord>> records;
+    records.reserve(matches.size());
+    for (const auto& match : matches) {
+      records.push_back(match.second);
+    }
+    return records;
+  }
+
+private:
+  /** \brief record with its insertion sequence number
+   */
+  typedef std::pair<uint64_t, shared_ptr<InterestFilterRecord>> Entry;
+
+  struct Node
+  {
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<Entry> records;
+  };
+
+  /**
+   * @return whether @p node has become empty and can be removed by the caller
+   */
+  static bool
+  eraseFromNode(Node& node, const Name& prefix, size_t depth, const InterestFilterRecord* record)
+  {
+    if (depth == prefix.size()) {
+      auto it = std::find_if(node.records.begin(), node.records.end(),
+                             [record] (const Entry& entry) { return entry.second.get() == record; });
+      if (it != node.records.end()) {
+        node.records.erase(it);
+      }
+    }
+    else {
+      auto child = node.children.find(prefix.get(depth));
+      if (child != node.children.end() &&
+          eraseFromNode(*child->second, prefix, depth + 1, record)) {
+        node.children.erase(child);
+      }
+    }
+
+    return node.records.empty() && node.children.empty();
+  }
+
+private:
+  Node m_root;
+  uint64_t m_nextSeq;
+  std::unordered_map<const InterestFilterRecord*, shared_ptr<InterestFilterRecord>> m_index;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
@@ -327,17 +327,49 @@ Block::parse() const
   Buffer::const_iterator begin = value_begin();
   Buffer::const_iterator end = value_end();
 
+  // First pass only locates element boundaries, so that m_subBlocks can be allocated once.
+  // Most elements (e.g., name components) have one-octet type and length, which is
+  // decoded inline without going through the generic VAR-NUMBER readers.
+  size_t nElements = 0;
+  for (Buffer::const_iterator i = begin; i != end; ++nElements)
+    {
+      uint64_t length = 0;
+      if (end - i >= 2 && i[0] < 253 && i[1] < 253)
+        {
+          length = i[1];
+          i += 2;
+        }
+      else
+        {
+          tlv::readType(i, end);
+          length = tlv::readVarNumber(i, end);
+        }
+
+      if (length > static_cast<uint64_t>(end - i))
+        {
+          BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+        }
+      i += length;
+    }
+
+  m_subBlocks.reserve(nElements);
+
   while (begin != end)
     {
       Buffer::const_iterator element_begin = begin;
 
-      uint32_t type = tlv::readType(begin, end);
-      uint64_t length = tlv::readVarNumber(begin, end);
-
-      if (length > static_cast<uint64_t>(end - begin))
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (begin[0] < 253 && begin[1] < 253)
         {
-          m_subBlocks.clear();
-          BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+          type = begin[0];
+          length = begin[1];
+          begin += 2;
+        }
+      else
+        {
+          type = tlv::readType(begin, end);
+          length = tlv::readVarNumber(begin, end);
         }
       Buffer::const_iterator element_end = begin + length;
 
@@ -469,9 +469,17 @@ Face::onReceiveElement(const Block& blockFromDaemon)
   lp::Packet lpPacket(blockFromDaemon); // bare Interest/Data is a valid lp::Packet,
                                         // no need to distinguish
 
-  Buffer::const_iterator begin, end;
-  std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
-  Block netPacket(&*begin, std::distance(begin, end));
+  Block netPacket;
+  if (blockFromDaemon.type() == tlv::Interest || blockFromDaemon.type() == tlv::Data) {
+    netPacket = blockFromDaemon;
+  }
+  else {
+    // the fragment is a part of blockFromDaemon, so it can share the buffer instead of
+    // being copied out
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
+    netPacket = Block(blockFromDaemon.getBuffer(), begin, end);
+  }
   switch (netPacket.type()) {
     case tlv::Interest: {
       auto interest = make_shared<Interest>(netPacket);
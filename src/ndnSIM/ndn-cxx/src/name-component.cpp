@@ -385,6 +385,12 @@ Component::fromImplicitSha256Digest(const uint8_t* digest, size_t digestSize)
 bool
 Component::equals(const Component& other) const
 {
+  if (this->hasWire() && other.hasWire()) {
+    // see Component::compare
+    return size() == other.size() &&
+           std::memcmp(wire(), other.wire(), size()) == 0;
+  }
+
   return type() == other.type() &&
          value_size() == other.value_size() &&
          (empty() || // needed on OSX 10.9 due to STL bug
@@ -296,8 +296,16 @@ Name::equals(const Name& name) const
   if (size() != name.size())
     return false;
 
+  if (hasWire() && name.hasWire()) {
+    // TLV is self-delimiting, so the names are equal iff their component sequences are
+    // byte-wise equal (see also Component::compare)
+    return m_nameBlock.value_size() == name.m_nameBlock.value_size() &&
+           (empty() ||
+            std::memcmp(m_nameBlock.value(), name.m_nameBlock.value(), m_nameBlock.value_size()) == 0);
+  }
+
   for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
+    if (get(i) != name.get(i))
       return false;
   }
 
@@ -311,9 +319,17 @@ Name::isPrefixOf(const Name& name) const
   if (size() > name.size())
     return false;
 
+  if (hasWire() && name.hasWire()) {
+    // The first size() components of the given name start at the same offset and, TLV being
+    // self-delimiting, match this name iff the component bytes match.
+    return m_nameBlock.value_size() <= name.m_nameBlock.value_size() &&
+           (empty() ||
+            std::memcmp(m_nameBlock.value(), name.m_nameBlock.value(), m_nameBlock.value_size()) == 0);
+  }
+
   // Check if at least one of given components doesn't match.
   for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
+    if (get(i) != name.get(i))
       return false;
   }
 
@@ -327,8 +343,26 @@ Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t
   count2 = std::min(count2, other.size() - pos2);
   size_t count = std::min(count1, count2);
 
+  if (pos1 == 0 && count1 == this->size() && pos2 == 0 && count2 == other.size() &&
+      this->hasWire() && other.hasWire()) {
+    // Whole-name comparison: the first differing octet of the concatenated component TLVs
+    // falls into the first differing component, and ordering of TLV encoding is the same
+    // as canonical order of components (see Component::compare).  If no octet differs,
+    // one name is a prefix of the other.
+    size_t valueSize1 = m_nameBlock.value_size();
+    size_t valueSize2 = other.m_nameBlock.value_size();
+    size_t valueSize = std::min(valueSize1, valueSize2);
+    if (valueSize > 0) {
+      int comp = std::memcmp(m_nameBlock.value(), other.m_nameBlock.value(), valueSize);
+      if (comp != 0) {
+        return comp;
+      }
+    }
+    return count1 - count2;
+  }
+
   for (size_t i = 0; i < count; ++i) {
-    int comp = this->at(pos1 + i).compare(other.at(pos2 + i));
+    int comp = this->get(pos1 + i).compare(other.get(pos2 + i));
     if (comp != 0) { // i-th component differs
       return comp;
     }
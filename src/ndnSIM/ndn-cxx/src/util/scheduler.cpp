@@ -20,32 +20,115 @@
  */
 
 #include "scheduler.hpp"
-#include <boost/scope_exit.hpp>
 
-namespace ns3 {
+namespace ndn {
+namespace util {
+namespace scheduler {
 
-/// @cond include_hidden
+/**
+ * \brief ns-3 event carrying the callback of a scheduled event
+ *
+ * Pending events of a Scheduler are linked into an intrusive doubly-linked list, so that
+ * the event can be unlinked in constant time when it is executed or cancelled, and
+ * Scheduler::cancelAllEvents can find the events still pending.  Apart from the ns-3 EventId
+ * returned to the caller, this is the only allocation made per scheduled event.
+ *
+ * An event is executed and cancelled by the thread of the partition which owns it, but under
+ * ns3::MultithreadedSimulatorImpl the list can be shared with events of other partitions, e.g.,
+ * when a node cancels an event scheduled before the simulation started.  The list is therefore
+ * guarded by the mutex of the scheduler, which is never held while a callback is called or
+ * released.
+ */
+class Scheduler::PendingEvent : public ns3::EventImpl
+{
+public:
+  PendingEvent(Scheduler& scheduler, const Event& callback)
+    : m_callback(callback)
+    , m_scheduler(&scheduler)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+  {
+    std::lock_guard<std::mutex> lock(scheduler.m_mutex);
+    m_next = scheduler.m_pendingEvents;
+    if (m_next != nullptr) {
+      m_next->m_prev = this;
+    }
+    scheduler.m_pendingEvents = this;
+  }
 
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
+  virtual
+  ~PendingEvent()
   {
-    return p;
+    // the event may still be linked if ns-3 simulator is destroyed before the scheduler
+    unlink();
   }
-};
 
-/// @endcond
+  bool
+  isPending() const
+  {
+    return m_scheduler != nullptr;
+  }
 
-} // namespace ns3
+  /** \brief mark the event cancelled and release the callback
+   *  \pre isPending()
+   */
+  void
+  cancel()
+  {
+    unlink();
+    Cancel();
+    m_callback = nullptr;
+  }
 
-namespace ndn {
-namespace util {
-namespace scheduler {
+  /** \brief unlink the event from the list of the scheduler
+   *  \pre the mutex of the scheduler is held
+   */
+  void
+  unlinkLocked()
+  {
+    if (m_prev != nullptr) {
+      m_prev->m_next = m_next;
+    }
+    else {
+      m_scheduler->m_pendingEvents = m_next;
+    }
+    if (m_next != nullptr) {
+      m_next->m_prev = m_prev;
+    }
+
+    m_scheduler = nullptr;
+    m_prev = m_next = nullptr;
+  }
+
+protected:
+  virtual void
+  Notify() override
+  {
+    unlink();
+    m_callback();
+  }
+
+private:
+  void
+  unlink()
+  {
+    if (m_scheduler == nullptr) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_scheduler->m_mutex);
+    unlinkLocked();
+  }
+
+private:
+  Event m_callback;
+  Scheduler* m_scheduler;
+  PendingEvent* m_prev;
+  PendingEvent* m_next;
+};
 
 Scheduler::Scheduler(boost::asio::io_service& ioService)
-  : m_scheduledEvent(m_events.end())
+  : m_pendingEvents(nullptr)
 {
 }
 
@@ -57,47 +140,43 @@ Scheduler::~Scheduler()
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after, const Event& event)
 {
-  EventId eventId = std::make_shared<ns3::EventId>();
-  weak_ptr<ns3::EventId> eventWeak = eventId;
-  std::function<void()> eventWithCleanup = [this, event, eventWeak] () {
-    event();
-    shared_ptr<ns3::EventId> eventId = eventWeak.lock();
-    if (eventId != nullptr) {
-      this->m_events.erase(eventId); // remove the event from the set after it is executed
-    }
-  };
-
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), eventWithCleanup);
-  *eventId = std::move(id);
-  m_events.insert(eventId);
+  ns3::Ptr<ns3::EventImpl> impl(new PendingEvent(*this, event), false);
 
-  return eventId;
+  return std::make_shared<ns3::EventId>(ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
+                                                                 impl));
 }
 
 void
 Scheduler::cancelEvent(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    const_cast<EventId&>(eventId).reset();
-    m_events.erase(eventId);
+  if (eventId == nullptr) {
+    return;
+  }
+
+  // all events with non-null EventId were scheduled by a Scheduler
+  auto event = static_cast<PendingEvent*>(eventId->PeekEventImpl());
+  if (event != nullptr && event->isPending()) {
+    event->cancel();
   }
+  const_cast<EventId&>(eventId).reset();
 }
 
 void
 Scheduler::cancelAllEvents()
 {
-  for (auto i = m_events.begin(); i != m_events.end(); ) {
-    auto next = i;
-    ++next; // ns3::Simulator::Remove can call cancelEvent
-    if ((*i) != nullptr) {
-      ns3::Simulator::Remove((**i));
-      const_cast<EventId&>(*i).reset();
+  while (true) {
+    // the callback may cancel other events when released, so it is released after unlocking
+    ns3::Ptr<PendingEvent> event;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_pendingEvents == nullptr) {
+        break;
+      }
+      event = m_pendingEvents;
+      event->unlinkLocked();
     }
-    i = next;
+    event->cancel();
   }
-  m_events.clear();
 }
 
 } // namespace scheduler
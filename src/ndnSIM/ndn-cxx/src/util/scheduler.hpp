@@ -27,7 +27,7 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
+#include <mutex>
 
 namespace ndn {
 namespace util {
@@ -40,6 +40,11 @@ typedef std::shared_ptr<ns3::EventId> EventId;
 
 /**
  * \brief Generic scheduler
+ *
+ * Events are scheduled directly in ns-3 simulator.  Cancellation uses ns-3 Simulator::Cancel
+ * semantics: the event is marked as cancelled and stays in the simulator queue until its
+ * scheduled time, when it is discarded without being executed.  Unlike
+ * ns3::Simulator::Remove, this takes constant time regardless of the number of pending events.
  */
 class Scheduler : noncopyable
 {
@@ -74,36 +79,15 @@ public:
   cancelAllEvents();
 
 private:
-  struct EventInfo
-  {
-    EventInfo(const time::nanoseconds& after, const Event& event);
-
-    EventInfo(const time::steady_clock::TimePoint& when, const EventInfo& previousEvent);
-
-    bool
-    operator <=(const EventInfo& other) const
-    {
-      return this->m_scheduledTime <= other.m_scheduledTime;
-    }
-
-    bool
-    operator <(const EventInfo& other) const
-    {
-      return this->m_scheduledTime < other.m_scheduledTime;
-    }
+  class PendingEvent;
 
-    time::nanoseconds
-    expiresFromNow() const;
-
-    time::steady_clock::TimePoint m_scheduledTime;
-    Event m_event;
-    mutable EventId m_eventId;
-  };
-
-  typedef std::multiset<EventId> EventQueue;
+  /** \brief head of the intrusive list of events scheduled and not yet executed or cancelled
+   */
+  PendingEvent* m_pendingEvents;
 
-  EventQueue m_events;
-  EventQueue::iterator m_scheduledEvent;
+  /** \brief guards the list, which the partitions of a parallel simulation may share
+   */
+  std::mutex m_mutex;
 };
 
 } // namespace scheduler
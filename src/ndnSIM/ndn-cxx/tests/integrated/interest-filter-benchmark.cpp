@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE InterestFilter Benchmark
+
+#include "detail/interest-filter-table.hpp"
+#include "util/time.hpp"
+
+#include "boost-test.hpp"
+
+#include <list>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(Dispatch)
+{
+  // one node running many producers, each with its own prefix
+  const size_t nFilters = 1000;
+  const size_t nInterests = 100000;
+
+  std::vector<size_t> nInvoked(nFilters + 1, 0);
+  std::list<shared_ptr<InterestFilterRecord>> list;
+  InterestFilterTable table;
+  for (size_t i = 0; i <= nFilters; ++i) {
+    // the last filter catches everything under /producer with a regex
+    InterestFilter filter = i < nFilters ?
+                            InterestFilter("/producer/" + to_string(i)) :
+                            InterestFilter("/producer", "<>*<%FE%00>");
+    auto record = make_shared<InterestFilterRecord>(filter,
+                    [&nInvoked, i] (const InterestFilter&, const Interest&) { ++nInvoked[i]; });
+    list.push_back(record);
+    table.insert(record);
+  }
+
+  std::vector<Interest> interests;
+  interests.reserve(nInterests);
+  for (size_t i = 0; i < nInterests; ++i) {
+    Name name("/producer/" + to_string(i % nFilters));
+    name.appendSequenceNumber(i % 10);
+    interests.push_back(Interest(Name(name.wireEncode())));
+  }
+
+  // linear scan over all filters, as in Face before InterestFilterTable was introduced
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (const Interest& interest : interests) {
+    for (const auto& record : list) {
+      if (record->doesMatch(interest.getName())) {
+        record->invokeInterestCallback(interest);
+      }
+    }
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  std::vector<size_t> nInvokedByList = nInvoked;
+  std::fill(nInvoked.begin(), nInvoked.end(), 0);
+
+  for (const Interest& interest : interests) {
+    for (const auto& record : table.findMatches(interest.getName())) {
+      record->invokeInterestCallback(interest);
+    }
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_CHECK(nInvoked == nInvokedByList);
+  BOOST_CHECK_EQUAL(nInvoked[nFilters], nInterests / 10);
+  BOOST_TEST_MESSAGE("dispatch " << nInterests << " Interests to " << nFilters << " filters, "
+                     "linear scan: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("dispatch " << nInterests << " Interests to " << nFilters << " filters, "
+                     "InterestFilterTable: " << (t3 - t2));
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE Name Benchmark
+
+#include "name.hpp"
+#include "util/time.hpp"
+
+#include "boost-test.hpp"
+
+#include <set>
+
+namespace ndn {
+namespace tests {
+
+/** \brief generates names of 5 to 10 components sharing a few common prefixes,
+ *         similar to names requested by ndnSIM consumer applications
+ */
+static std::vector<Name>
+makeNames(size_t nNames)
+{
+  std::vector<Name> names;
+  names.reserve(nNames);
+  for (size_t i = 0; i < nNames; ++i) {
+    Name name("/ndn/edu/ucla/cs");
+    for (size_t j = 0; j < i % 5; ++j) {
+      name.append("dir" + to_string(j));
+    }
+    name.appendSequenceNumber(i);
+    // names used by NFD tables are decoded from packets and always carry the wire encoding
+    names.push_back(Name(name.wireEncode()));
+  }
+  return names;
+}
+
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  const size_t nNames = 1000000;
+  std::vector<Name> names = makeNames(nNames);
+
+  std::vector<Block> blocks;
+  blocks.reserve(nNames);
+  for (const Name& name : names) {
+    blocks.push_back(Block(name.wireEncode().getBuffer(),
+                           name.wireEncode().begin(), name.wireEncode().end()));
+  }
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  size_t nComponents = 0;
+  for (Block& block : blocks) {
+    block.parse();
+    nComponents += block.elements_size();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  BOOST_TEST_MESSAGE("parse " << nNames << " names (" << nComponents << " components): "
+                     << (t2 - t1));
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  const size_t nNames = 1000000;
+  std::vector<Name> names = makeNames(nNames);
+  Name prefix("/ndn/edu/ucla/cs/dir0");
+  prefix = Name(prefix.wireEncode());
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  std::set<Name> set(names.begin(), names.end());
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  size_t nFound = 0;
+  for (const Name& name : names) {
+    nFound += set.count(name);
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+  size_t nPrefixOf = 0;
+  for (const Name& name : names) {
+    nPrefixOf += prefix.isPrefixOf(name);
+  }
+  time::steady_clock::TimePoint t4 = time::steady_clock::now();
+
+  BOOST_REQUIRE_EQUAL(nFound, nNames);
+  BOOST_TEST_MESSAGE("std::set<Name> insert " << nNames << " names: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("std::set<Name> find " << nNames << " names: " << (t3 - t2));
+  BOOST_TEST_MESSAGE("isPrefixOf " << nNames << " names (" << nPrefixOf << " matches): "
+                     << (t4 - t3));
+}
+
+} // namespace tests
+} // namespace ndn
@@ -418,6 +418,31 @@ BOOST_AUTO_TEST_CASE(Compare)
   BOOST_CHECK_GT   (Name("/Z/A/C/Y").compare(1, 2, Name("/X/A"),   1), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CompareWireEncoded)
+{
+  // wire-encoded names are compared octet-wise, which must agree with component-wise comparison
+  std::vector<std::string> uris = {"/", "/A", "/A/B", "/A/B/C", "/AA", "/AA/B", "/B", "/A/BB",
+                                   "/prefix/%FE%00", "/prefix/%FE%01", "/prefix/%FE%00/x",
+                                   "/A/sha256digest=0101010101010101010101010101010101010101"
+                                   "010101010101010101010101"};
+
+  for (const std::string& uriA : uris) {
+    for (const std::string& uriB : uris) {
+      Name a(uriA), b(uriB);
+      Name wireA(Name(uriA).wireEncode()), wireB(Name(uriB).wireEncode());
+      BOOST_REQUIRE(!a.hasWire() && !b.hasWire());
+      BOOST_REQUIRE(wireA.hasWire() && wireB.hasWire());
+
+      int expected = a.compare(b);
+      int actual = wireA.compare(wireB);
+      BOOST_CHECK_EQUAL(expected < 0, actual < 0);
+      BOOST_CHECK_EQUAL(expected == 0, actual == 0);
+      BOOST_CHECK_EQUAL(a.equals(b), wireA.equals(wireB));
+      BOOST_CHECK_EQUAL(a.isPrefixOf(b), wireA.isPrefixOf(wireB));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(NameWithSpaces)
 {
   Name name("/ hello\t/\tworld \r\n");
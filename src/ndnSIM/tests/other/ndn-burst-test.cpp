@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-burst-test.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * This scenario measures the real time needed to process bursts of packets arriving at the same
+ * simulated time, with and without batched receive in NetDeviceTransport:
+ *
+ *
+ *      +----------+   1000000Gbps   +----------+
+ *      | consumer |  <------------> | producer |
+ *      +----------+       10ms      +----------+
+ *
+ * Every consumer app on the consumer node sends an Interest at the same time, and the link is
+ * fast enough for the whole burst to arrive at the producer at the same simulated time.
+ *
+ *     ./waf --run "ndn-burst-test --batching=1 --consumers=100"
+ */
+
+static double
+getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+main(int argc, char* argv[])
+{
+  bool isBatchingEnabled = false;
+  uint32_t nConsumers = 100;
+  double interestRate = 100;
+  Time simulationTime = Seconds(100);
+
+  CommandLine cmd;
+  cmd.AddValue("batching", "Deliver packets received at the same time in one batch",
+               isBatchingEnabled);
+  cmd.AddValue("consumers", "Number of consumer apps (i.e., size of the burst)", nConsumers);
+  cmd.AddValue("rate", "Interest rate of each consumer app", interestRate);
+  cmd.AddValue("sim-time", "Simulation time", simulationTime);
+  cmd.Parse(argc, argv);
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1000000Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue(std::to_string(2 * nConsumers)));
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setReceiveBatching(isBatchingEnabled);
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/prefix", nodes.Get(1), 1);
+
+  // consumers use different prefixes, so their Interests are not aggregated in the PIT
+  for (uint32_t i = 0; i < nConsumers; ++i) {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix/" + std::to_string(i));
+    consumerHelper.SetAttribute("Frequency", DoubleValue(interestRate));
+    consumerHelper.Install(nodes.Get(0));
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(1));
+
+  Simulator::Stop(simulationTime);
+
+  double beginRealTime = getRealTime();
+  Simulator::Run();
+  double realTime = getRealTime() - beginRealTime;
+
+  auto face = nodes.Get(1)->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(nodes.Get(1)->GetDevice(0));
+  uint64_t nInterests = face->getCounters().nInInterests;
+
+  std::cout << "Batching: " << (isBatchingEnabled ? "enabled" : "disabled") << "\n"
+            << "Interests received by producer: " << nInterests << "\n"
+            << "Real time: " << realTime << "s\n"
+            << "Interests per real second: " << nInterests / realTime << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
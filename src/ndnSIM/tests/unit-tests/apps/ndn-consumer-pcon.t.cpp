@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-pcon.hpp"
+
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerPconFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerPconFixture()
+    : maxWindow(0)
+  {
+    // a bottleneck with a queue shorter than the window of slow start
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+  }
+
+  void
+  run(const std::string& algorithm)
+  {
+    addApps({
+        {"1", "ns3::ndn::ConsumerPcon",
+            {{"Prefix", "/prefix"}, {"MaxSeq", "500"}, {"CcAlgorithm", algorithm}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerPcon/"
+                                  "FirstInterestDataDelay",
+                                  MakeCallback(&ConsumerPconFixture::onData, this));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerPcon/"
+                                  "CongestionWindow",
+                                  MakeCallback(&ConsumerPconFixture::onWindow, this));
+
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+  }
+
+  void
+  onData(Ptr<App> app, uint32_t seq, Time delay, uint32_t nTransmissions, int32_t hopCount)
+  {
+    BOOST_CHECK(receivedSeqs.insert(seq).second);
+  }
+
+  void
+  onWindow(double oldWindow, double newWindow)
+  {
+    maxWindow = std::max(maxWindow, newWindow);
+  }
+
+  void
+  checkTransfer()
+  {
+    // every content received once, with retransmissions of the dropped Interests or Data
+    BOOST_CHECK_EQUAL(receivedSeqs.size(), 500);
+    BOOST_CHECK_EQUAL(*receivedSeqs.rbegin(), 499);
+    BOOST_CHECK_GE(getFace("1", "2")->getCounters().nOutInterests, 500);
+    BOOST_CHECK_GT(maxWindow, 2);
+
+    // no timer left on the wheel of the consumer
+    BOOST_CHECK_EQUAL(getNode("1")->GetObject<TimingWheel>()->GetNTimers(), 0);
+  }
+
+public:
+  std::set<uint32_t> receivedSeqs;
+  double maxWindow;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerPcon, ConsumerPconFixture)
+
+BOOST_AUTO_TEST_CASE(Aimd)
+{
+  run("AIMD");
+  checkTransfer();
+}
+
+BOOST_AUTO_TEST_CASE(Cubic)
+{
+  run("CUBIC");
+  checkTransfer();
+}
+
+BOOST_AUTO_TEST_CASE(Delay)
+{
+  run("DELAY");
+  checkTransfer();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
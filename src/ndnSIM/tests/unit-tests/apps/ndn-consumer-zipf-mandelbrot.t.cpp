@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerZipfMandelbrot, CleanupFixture)
+
+/// Chi-square statistic of the contents drawn by a consumer, against the Zipf-Mandelbrot pmf
+static double
+drawChiSquare(uint32_t nContents, double q, double s, uint32_t nDraws)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", UintegerValue(nContents));
+  consumer->SetAttribute("q", DoubleValue(q));
+  consumer->SetAttribute("s", DoubleValue(s));
+
+  std::vector<uint32_t> counts(nContents + 1, 0);
+  for (uint32_t i = 0; i < nDraws; i++) {
+    uint32_t content = consumer->GetNextSeq();
+    BOOST_REQUIRE_GE(content, 1);
+    BOOST_REQUIRE_LE(content, nContents);
+    counts[content]++;
+  }
+
+  double sum = 0;
+  for (uint32_t k = 1; k <= nContents; k++) {
+    sum += std::pow(k + q, -s);
+  }
+  double chiSquare = 0;
+  for (uint32_t k = 1; k <= nContents; k++) {
+    double expected = nDraws * std::pow(k + q, -s) / sum;
+    chiSquare += (counts[k] - expected) * (counts[k] - expected) / expected;
+  }
+  return chiSquare;
+}
+
+BOOST_AUTO_TEST_CASE(Frequencies)
+{
+  // 19 degrees of freedom:  the 0.999 quantile is 43.8
+  BOOST_CHECK_LT(drawChiSquare(20, 0.7, 0.7, 100000), 43.8);
+  BOOST_CHECK_LT(drawChiSquare(20, 0.0, 1.0, 100000), 43.8);
+  BOOST_CHECK_LT(drawChiSquare(20, 5.0, 2.5, 100000), 43.8);
+  BOOST_CHECK_LT(drawChiSquare(20, -0.4, 0.0, 100000), 43.8);
+}
+
+BOOST_AUTO_TEST_CASE(SingleContent)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", UintegerValue(1));
+  BOOST_CHECK_EQUAL(consumer->GetNextSeq(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidParameters)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  BOOST_CHECK(!consumer->SetAttributeFailSafe("q", DoubleValue(-0.5)));
+  BOOST_CHECK(!consumer->SetAttributeFailSafe("s", DoubleValue(-0.1)));
+  BOOST_CHECK(consumer->SetAttributeFailSafe("q", DoubleValue(-0.49)));
+  BOOST_CHECK(consumer->SetAttributeFailSafe("s", DoubleValue(0.0)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer.hpp"
+
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+  }
+
+  void
+  onData(Ptr<App> app, uint32_t seq, Time delay, uint32_t nTransmissions, int32_t hopCount)
+  {
+    BOOST_CHECK(transmissions.insert(std::make_pair(seq, nTransmissions)).second);
+  }
+
+public:
+  std::map<uint32_t, uint32_t> transmissions;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumer, ConsumerFixture)
+
+BOOST_AUTO_TEST_CASE(Retransmissions)
+{
+  // the Interests sent before the producer starts time out and are retransmitted
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"MaxSeq", "20"}},
+          "0s", "20s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "1s", "20s"}
+    });
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::Consumer/"
+                                "FirstInterestDataDelay",
+                                MakeCallback(&ConsumerFixture::onData, this));
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(transmissions.size(), 20);
+  BOOST_CHECK_GT(transmissions[0], 1);
+  BOOST_CHECK_EQUAL(transmissions[19], 1);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nOutData, 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
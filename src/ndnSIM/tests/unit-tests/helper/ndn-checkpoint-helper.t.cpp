@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-checkpoint-helper.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/application.h"
+
+#include "../tests-common.hpp"
+
+#include <cstdio>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnCheckpointHelper, CleanupFixture)
+
+static const std::string CHECKPOINT = "ndn-checkpoint-helper.ckpt";
+
+static void
+createScenario(ScenarioHelper& scenario)
+{
+  scenario.createTopology({
+      {"1", "2"}
+    });
+
+  scenario.addRoutes({
+      {"1", "2", "/prefix", 1}
+    });
+
+  scenario.addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+}
+
+static int64_t
+getSeq(ScenarioHelper& scenario)
+{
+  IntegerValue seq;
+  scenario.getNode("1")->GetApplication(0)->GetAttribute("StartSeq", seq);
+  return seq.Get();
+}
+
+BOOST_AUTO_TEST_CASE(SaveRestore)
+{
+  size_t csSize = 0;
+  int64_t seq = 0;
+  double value = 0;
+  {
+    ScenarioHelper scenario;
+    createScenario(scenario);
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    for (int i = 0; i < 5; i++) {
+      random->GetValue();
+    }
+
+    Simulator::Schedule(Seconds(2.05), &CheckpointHelper::Save, CHECKPOINT);
+    Simulator::Stop(Seconds(2.1));
+    Simulator::Run();
+
+    csSize = scenario.getNode("1")->GetObject<L3Protocol>()->getForwarder()->getCs().size();
+    seq = getSeq(scenario);
+    value = random->GetValue();
+
+    Simulator::Destroy();
+    Names::Clear();
+    GlobalRouter::clear();
+  }
+  BOOST_CHECK_GT(csSize, 0);
+  BOOST_CHECK_GT(seq, 0);
+
+  ScenarioHelper scenario;
+  createScenario(scenario);
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+  BOOST_CHECK_EQUAL(getSeq(scenario), 0);
+
+  BOOST_CHECK_EQUAL(CheckpointHelper::Restore(CHECKPOINT), Seconds(2.05));
+  std::remove(CHECKPOINT.c_str());
+  std::remove((CHECKPOINT + ".attributes").c_str());
+
+  BOOST_CHECK_EQUAL(scenario.getNode("1")->GetObject<L3Protocol>()->getForwarder()->getCs().size(),
+                    csSize);
+  BOOST_CHECK_EQUAL(getSeq(scenario), seq);
+  BOOST_CHECK_EQUAL(random->GetValue(), value);
+
+  // the restored Data are served from the cache of the consumer node, so only the Interests of
+  // the restored consumer reach the producer
+  scenario.addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.99s"}
+    });
+  Simulator::Stop(Seconds(1.001));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(scenario.getFace("2", "1")->getCounters().nInInterests,
+                    static_cast<uint64_t>(getSeq(scenario) - seq));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class BurstFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  run(bool isReceiveBatchingEnabled)
+  {
+    // the link is fast enough for a burst of Interests to arrive at the same simulated time
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1000000Gbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+    getStackHelper().setReceiveBatching(isReceiveBatchingEnabled);
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    // consumers use different prefixes, so their Interests are not aggregated on node 1
+    for (int i = 0; i < 5; ++i) {
+      addApps({
+          {"1", "ns3::ndn::ConsumerCbr",
+              {{"Prefix", "/prefix/" + std::to_string(i)}, {"Frequency", "10"}},
+              "0s", "100s"},
+        });
+    }
+    addApps({
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    Simulator::Stop(Seconds(1.05));
+    Simulator::Run();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, BurstFixture)
+
+BOOST_AUTO_TEST_CASE(Unbatched)
+{
+  run(false);
+
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInPackets, 55);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 55);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 55);
+}
+
+BOOST_AUTO_TEST_CASE(Batched)
+{
+  run(true);
+
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInPackets, 55);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 55);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 55);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+#include "NFD/core/scheduler.hpp"
+
+#include "ns3/mpi-interface.h"
+#include "ns3/node.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class NdnCxxSchedulerFixture : public CleanupFixture
+{
+public:
+  NdnCxxSchedulerFixture()
+    : scheduler(*static_cast<boost::asio::io_service*>(nullptr))
+    , nFired(0)
+  {
+  }
+
+  /** \brief schedule events in the shared scheduler, cancelling half of them
+   */
+  void
+  scheduleInPartition(uint32_t partition)
+  {
+    for (int i = 0; i < 1000; ++i) {
+      ::ndn::EventId id = scheduler.scheduleEvent(::ndn::time::milliseconds(1 + i % 10),
+                                                  [this, partition] { ++nPartitionFired[partition]; });
+      if (i % 2 == 1) {
+        scheduler.cancelEvent(id);
+      }
+    }
+  }
+
+  /** \brief schedule an event after the end of the first run in the scheduler of the partition
+   */
+  void
+  scheduleLate()
+  {
+    nfd::scheduler::schedule(::ndn::time::milliseconds(100), [this] { nFired += 1; });
+  }
+
+protected:
+  ::ndn::Scheduler scheduler;
+  int nFired;
+  std::vector<int> nPartitionFired; ///< events executed per partition, each one touched by its thread
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxScheduler, NdnCxxSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  ::ndn::EventId i1 = scheduler.scheduleEvent(::ndn::time::milliseconds(10), [this] { nFired += 1; });
+  ::ndn::EventId i2 = scheduler.scheduleEvent(::ndn::time::milliseconds(20), [this] { nFired += 10; });
+  ::ndn::EventId i3 = scheduler.scheduleEvent(::ndn::time::milliseconds(30), [this] { nFired += 100; });
+  ::ndn::EventId i4;
+  i4 = scheduler.scheduleEvent(::ndn::time::milliseconds(5), [&] {
+      nFired += 1000;
+      scheduler.cancelEvent(i2);
+      scheduler.cancelEvent(i4); // cancelling the event being executed has no effect
+    });
+
+  ::ndn::EventId i3copy = i3;
+  scheduler.cancelEvent(i3);
+  BOOST_CHECK(i3 == nullptr);
+  scheduler.cancelEvent(i3copy); // cancelling twice has no effect
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(nFired, 1001);
+
+  scheduler.cancelEvent(i1); // cancelling an executed event has no effect
+}
+
+BOOST_AUTO_TEST_CASE(CancelAll)
+{
+  for (int i = 0; i < 10; ++i) {
+    scheduler.scheduleEvent(::ndn::time::milliseconds(i), [this] { nFired += 1; });
+  }
+  scheduler.scheduleEvent(::ndn::time::milliseconds(20), [this] { scheduler.cancelAllEvents(); });
+  scheduler.scheduleEvent(::ndn::time::milliseconds(30), [this] { nFired += 10; });
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(nFired, 10);
+}
+
+BOOST_AUTO_TEST_CASE(MultithreadedSimulator)
+{
+  GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::MultithreadedSimulatorImpl"));
+  GlobalValue::Bind("ThreadCount", UintegerValue(2));
+  MpiInterface::Enable(0, 0);
+
+  Ptr<Node> node0 = CreateObject<Node>(0);
+  Ptr<Node> node1 = CreateObject<Node>(1);
+  nPartitionFired.assign(2, 0);
+
+  // both partitions schedule, execute and cancel events of the same scheduler concurrently
+  Simulator::ScheduleWithContext(node0->GetId(), Seconds(0),
+                                 &NdnCxxSchedulerFixture::scheduleInPartition, this, 0);
+  Simulator::ScheduleWithContext(node1->GetId(), Seconds(0),
+                                 &NdnCxxSchedulerFixture::scheduleInPartition, this, 1);
+
+  // the thread of partition 1 ends with the first run, while its event is pending
+  Simulator::ScheduleWithContext(node1->GetId(), Seconds(0),
+                                 &NdnCxxSchedulerFixture::scheduleLate, this);
+  Simulator::Stop(MilliSeconds(50));
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(nPartitionFired[0], 500);
+  BOOST_CHECK_EQUAL(nPartitionFired[1], 500);
+  BOOST_CHECK_EQUAL(nFired, 0);
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(nFired, 1);
+
+  Simulator::Destroy();
+  MpiInterface::Disable();
+  GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-interned-name.hpp"
+
+#include <map>
+#include <thread>
+#include <unordered_set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnInternedName)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  for (const char* uri : {"/", "/a", "/a/b", "/prefix/%FE%00", "/prefix/%FE%01/c"}) {
+    InternedName name{Name(uri)};
+    BOOST_CHECK_EQUAL(name.toName(), Name(uri));
+    BOOST_CHECK_EQUAL(name.empty(), Name(uri).empty());
+  }
+
+  InternedName seq(Name("/prefix").appendSequenceNumber(10));
+  BOOST_CHECK_EQUAL(seq.getPrefix(), Name("/prefix"));
+  BOOST_CHECK_EQUAL(seq.getLastComponent().toSequenceNumber(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(SharedPrefix)
+{
+  size_t nPrefixes = InternedName::GetNPrefixes();
+  {
+    std::vector<InternedName> names;
+    for (uint64_t seq = 0; seq < 100; ++seq) {
+      names.push_back(InternedName(Name("/shared/prefix").appendSequenceNumber(seq)));
+    }
+    BOOST_CHECK_EQUAL(InternedName::GetNPrefixes(), nPrefixes + 1);
+    BOOST_CHECK_EQUAL(names.front().getPrefixId(), names.back().getPrefixId());
+    BOOST_CHECK(names.front() != names.back());
+
+    InternedName other(Name("/other/prefix/x"));
+    BOOST_CHECK_EQUAL(InternedName::GetNPrefixes(), nPrefixes + 2);
+    BOOST_CHECK_NE(other.getPrefixId(), names.front().getPrefixId());
+
+    other = names[5];
+    BOOST_CHECK_EQUAL(InternedName::GetNPrefixes(), nPrefixes + 1);
+    BOOST_CHECK_EQUAL(other, names[5]);
+  }
+  BOOST_CHECK_EQUAL(InternedName::GetNPrefixes(), nPrefixes);
+}
+
+BOOST_AUTO_TEST_CASE(Containers)
+{
+  std::map<InternedName, int> map;
+  std::unordered_set<InternedName> set;
+  for (int i = 0; i < 10; ++i) {
+    Name name = Name("/prefix").appendSequenceNumber(i % 5);
+    map[InternedName(name)]++;
+    set.insert(InternedName(name));
+  }
+
+  BOOST_CHECK_EQUAL(map.size(), 5);
+  BOOST_CHECK_EQUAL(set.size(), 5);
+  BOOST_CHECK_EQUAL(map[InternedName(Name("/prefix").appendSequenceNumber(3))], 2);
+  BOOST_CHECK_EQUAL(set.count(InternedName(Name("/prefix").appendSequenceNumber(4))), 1);
+  BOOST_CHECK_EQUAL(set.count(InternedName(Name("/prefix").appendSequenceNumber(5))), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent)
+{
+  // the partitions of a parallel simulation intern names from their own threads
+  size_t nPrefixes = InternedName::GetNPrefixes();
+  std::vector<std::thread> threads;
+  std::vector<size_t> nErrors(4, 0);
+  for (size_t i = 0; i < nErrors.size(); ++i) {
+    threads.emplace_back([i, &nErrors] {
+      Name own = Name("/own").appendNumber(i);
+      for (uint64_t seq = 0; seq < 1000; ++seq) {
+        InternedName shared(Name("/shared").appendSequenceNumber(seq));
+        InternedName copy = shared;
+        InternedName other(Name(own).appendSequenceNumber(seq));
+        if (copy.toName() != Name("/shared").appendSequenceNumber(seq) || other.getPrefix() != own) {
+          ++nErrors[i];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < nErrors.size(); ++i) {
+    BOOST_CHECK_EQUAL(nErrors[i], 0);
+  }
+  BOOST_CHECK_EQUAL(InternedName::GetNPrefixes(), nPrefixes);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
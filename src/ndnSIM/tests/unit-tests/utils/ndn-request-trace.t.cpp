@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-request-trace.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnRequestTrace)
+
+static const std::string TRACE = "ndn-request-trace.bin";
+
+template<typename T>
+static void
+writeNumber(std::ostream& os, T value)
+{
+  for (size_t i = 0; i < sizeof(T); i++) {
+    os.put(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+// requests of node 1 at 0s, 1s, ..., and of node 5 at 0.5s, 1.5s, ...
+static void
+writeTrace(uint64_t nRecords)
+{
+  std::vector<std::string> records[2];
+  for (uint64_t i = 0; i < nRecords; i++) {
+    for (int node = 0; node < 2; node++) {
+      std::ostringstream record;
+      Block name = Name("/prefix").append(std::to_string(node)).appendSequenceNumber(i).wireEncode();
+      writeNumber<uint64_t>(record, i * 1000000000 + node * 500000000);
+      writeNumber<uint32_t>(record, 1024);
+      writeNumber<uint16_t>(record, name.size());
+      record.write(reinterpret_cast<const char*>(name.wire()), name.size());
+      records[node].push_back(record.str());
+    }
+  }
+
+  std::ofstream os(TRACE.c_str(), std::ios::binary);
+  os.write("NDNRQTRC", 8);
+  writeNumber<uint32_t>(os, 1);
+  writeNumber<uint32_t>(os, 2);
+  uint64_t offset = 16 + 2 * 24;
+  for (int node = 0; node < 2; node++) {
+    writeNumber<uint32_t>(os, node == 0 ? 1 : 5);
+    writeNumber<uint32_t>(os, 0);
+    writeNumber<uint64_t>(os, offset);
+    writeNumber<uint64_t>(os, nRecords);
+    for (const auto& record : records[node]) {
+      offset += record.size();
+    }
+  }
+  for (int node = 0; node < 2; node++) {
+    for (const auto& record : records[node]) {
+      os << record;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Read)
+{
+  writeTrace(100);
+  shared_ptr<RequestTrace> trace = RequestTrace::Open(TRACE);
+  BOOST_CHECK(RequestTrace::Open(TRACE) == trace);
+  std::remove(TRACE.c_str());
+
+  BOOST_CHECK(trace->getNodeIds() == std::vector<uint32_t>({1, 5}));
+  BOOST_CHECK_EQUAL(trace->getCursor(0).getNRemaining(), 0);
+  BOOST_CHECK_EQUAL(trace->getCursor(3).getNRemaining(), 0);
+  BOOST_CHECK_EQUAL(trace->getCursor(7).getNRemaining(), 0);
+
+  RequestTrace::Cursor cursor = trace->getCursor(5);
+  BOOST_CHECK_EQUAL(cursor.getNRemaining(), 100);
+
+  std::vector<RequestTrace::Record> records;
+  uint64_t i = 0;
+  while (cursor.read(records, 30) > 0) {
+    BOOST_CHECK_EQUAL(records.size(), std::min<uint64_t>(30, 100 - i));
+    for (const auto& record : records) {
+      BOOST_CHECK_EQUAL(record.time, Seconds(i + 0.5));
+      BOOST_CHECK_EQUAL(record.size, 1024);
+      BOOST_CHECK_EQUAL(record.name, Name("/prefix/1").appendSequenceNumber(i));
+      i++;
+    }
+  }
+  BOOST_CHECK_EQUAL(i, 100);
+  BOOST_CHECK_EQUAL(cursor.getNRemaining(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  writeTrace(10);
+  std::ifstream is(TRACE.c_str(), std::ios::binary | std::ios::ate);
+  BOOST_REQUIRE_EQUAL(::truncate(TRACE.c_str(), static_cast<off_t>(is.tellg()) - 4), 0);
+  shared_ptr<RequestTrace> trace = RequestTrace::Open(TRACE);
+  std::remove(TRACE.c_str());
+
+  // the records of node 1 are complete, the last record of node 5 is not
+  std::vector<RequestTrace::Record> records;
+  RequestTrace::Cursor cursor1 = trace->getCursor(1);
+  BOOST_CHECK_EQUAL(cursor1.read(records, 10), 10);
+  RequestTrace::Cursor cursor5 = trace->getCursor(5);
+  BOOST_CHECK_EQUAL(cursor5.read(records, 9), 9);
+  BOOST_CHECK_THROW(cursor5.read(records, 1), std::runtime_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(ConsumerTrace, ScenarioHelperWithCleanupFixture)
+{
+  writeTrace(10);
+
+  createTopology({
+      {"1", "2"}
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1}
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerTrace",
+          {{"TraceFile", TRACE}, {"TraceNode", "5"}, {"BatchSize", "3"}},
+          "1s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(6.001));
+  Simulator::Run();
+  std::remove(TRACE.c_str());
+
+  // the requests at 0.5s, 1.5s, ... of the trace are sent at 1.5s, 2.5s, ..., 5.5s
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 5);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-timing-wheel.hpp"
+
+#include <functional>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class TimingWheelClient : public TimingWheel::Client
+{
+public:
+  virtual void
+  OnTimerExpired(uint32_t id, uint32_t cookie)
+  {
+    expirations.push_back(std::make_pair(id, Simulator::Now()));
+    if (onExpired) {
+      onExpired(id);
+    }
+  }
+
+public:
+  std::vector<std::pair<uint32_t, Time>> expirations;
+  std::function<void(uint32_t)> onExpired;
+};
+
+class TimingWheelFixture : public CleanupFixture
+{
+public:
+  TimingWheelFixture()
+  {
+    wheel = CreateObject<TimingWheel>();
+    wheel->SetAttribute("Granularity", TimeValue(MilliSeconds(10)));
+    wheel->SetAttribute("Slots", UintegerValue(4));
+  }
+
+  void
+  schedule(const Time& at, const Time& delay, TimingWheelClient* client, uint32_t id)
+  {
+    Simulator::Schedule(at, &TimingWheel::Schedule, wheel, delay, client, id, 0);
+  }
+
+public:
+  Ptr<TimingWheel> wheel;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnTimingWheel, TimingWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  TimingWheelClient client;
+  schedule(MilliSeconds(0), MilliSeconds(20), &client, 1);
+  schedule(MilliSeconds(0), MilliSeconds(25), &client, 2);
+  // more than a turn of the wheel
+  schedule(MilliSeconds(0), MilliSeconds(100), &client, 3);
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(client.expirations.size(), 3);
+  BOOST_CHECK_EQUAL(client.expirations[0].first, 1);
+  BOOST_CHECK_EQUAL(client.expirations[0].second, MilliSeconds(20));
+  BOOST_CHECK_EQUAL(client.expirations[1].first, 2);
+  BOOST_CHECK_EQUAL(client.expirations[1].second, MilliSeconds(30));
+  BOOST_CHECK_EQUAL(client.expirations[2].first, 3);
+  BOOST_CHECK_EQUAL(client.expirations[2].second, MilliSeconds(100));
+  BOOST_CHECK_EQUAL(wheel->GetNTimers(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveClientWhileExpiring)
+{
+  TimingWheelClient client;
+  TimingWheelClient other;
+  client.onExpired = [this, &client] (uint32_t) { wheel->RemoveClient(&client); };
+
+  // in the same slot: in the next turn, expiring now, and after the removal
+  schedule(MilliSeconds(0), MilliSeconds(50), &client, 2);
+  schedule(MilliSeconds(0), MilliSeconds(10), &client, 1);
+  schedule(MilliSeconds(0), MilliSeconds(10), &other, 3);
+  schedule(MilliSeconds(0), MilliSeconds(10), &client, 4);
+  schedule(MilliSeconds(0), MilliSeconds(50), &other, 5);
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(client.expirations.size(), 1);
+  BOOST_CHECK_EQUAL(client.expirations[0].first, 1);
+  BOOST_REQUIRE_EQUAL(other.expirations.size(), 2);
+  BOOST_CHECK_EQUAL(other.expirations[0].first, 3);
+  BOOST_CHECK_EQUAL(other.expirations[1].first, 5);
+  BOOST_CHECK_EQUAL(wheel->GetNTimers(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
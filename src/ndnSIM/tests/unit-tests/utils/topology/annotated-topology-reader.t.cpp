@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/annotated-topology-reader.hpp"
+#include "utils/topology/mapped-text-file.hpp"
+
+#include "ns3/data-rate.h"
+#include "ns3/mobility-model.h"
+#include "ns3/queue.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPOLOGY = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+
+class AnnotatedTopologyReaderFixture : public CleanupFixture
+{
+public:
+  AnnotatedTopologyReaderFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~AnnotatedTopologyReaderFixture()
+  {
+    boost::filesystem::remove(TEST_TOPOLOGY);
+  }
+
+  void
+  writeTopology(const std::string& content)
+  {
+    std::ofstream os(TEST_TOPOLOGY.string().c_str(), std::ios_base::binary);
+    os << content;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyAnnotatedTopologyReader, AnnotatedTopologyReaderFixture)
+
+BOOST_AUTO_TEST_CASE(Tokens)
+{
+  writeTopology("first  line\t 12.5\r\n\n 42 4294967296 -1");
+
+  MappedTextFile file(TEST_TOPOLOGY.string());
+  BOOST_REQUIRE(file.IsOpen());
+
+  MappedTextFile::Token line, token;
+  BOOST_REQUIRE(file.NextLine(line));
+  BOOST_CHECK_EQUAL(line.str(), "first  line\t 12.5");
+  BOOST_REQUIRE(MappedTextFile::NextToken(line, token));
+  BOOST_CHECK(token == "first");
+  BOOST_REQUIRE(MappedTextFile::NextToken(line, token));
+  BOOST_CHECK(token == "line");
+  BOOST_REQUIRE(MappedTextFile::NextToken(line, token));
+  double value = 0;
+  BOOST_CHECK(MappedTextFile::ParseDouble(token, value));
+  BOOST_CHECK_EQUAL(value, 12.5);
+  BOOST_CHECK(!MappedTextFile::NextToken(line, token));
+
+  BOOST_REQUIRE(file.NextLine(line));
+  BOOST_CHECK(line.empty());
+
+  BOOST_REQUIRE(file.NextLine(line));
+  uint32_t number = 0;
+  BOOST_REQUIRE(MappedTextFile::NextToken(line, token));
+  BOOST_CHECK(MappedTextFile::ParseUint32(token, number));
+  BOOST_CHECK_EQUAL(number, 42);
+  BOOST_REQUIRE(MappedTextFile::NextToken(line, token));
+  BOOST_CHECK(!MappedTextFile::ParseUint32(token, number)); // does not fit in 32 bits
+  BOOST_REQUIRE(MappedTextFile::NextToken(line, token));
+  BOOST_CHECK(!MappedTextFile::ParseUint32(token, number));
+
+  BOOST_CHECK(!file.NextLine(line));
+
+  MappedTextFile missing(TEST_TOPOLOGY.string() + ".missing");
+  BOOST_CHECK(!missing.IsOpen());
+}
+
+BOOST_AUTO_TEST_CASE(Read)
+{
+  writeTopology("# comment\r\n"
+                "router\r\n"
+                "# node  comment  yPos  xPos\r\n"
+                "A  NA  1  3\r\n"
+                "B  NA  2  5\r\n"
+                "C  NA  3  7\r\n"
+                "link\r\n"
+                "A  B  10Mbps  1  10ms  20\r\n"
+                "\r\n"
+                "B  C  1Mbps  2  5ms  30\r\n"
+                "C  B  1Mbps  2  5ms  30\r\n"); // duplicated link
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName(TEST_TOPOLOGY.string());
+  NodeContainer nodes = reader.Read();
+
+  BOOST_REQUIRE_EQUAL(nodes.GetN(), 3);
+  BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(0)), "A");
+  BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(2)), "C");
+  BOOST_CHECK_EQUAL(nodes.Get(1)->GetObject<MobilityModel>()->GetPosition().x, 5);
+  BOOST_CHECK_EQUAL(nodes.Get(1)->GetObject<MobilityModel>()->GetPosition().y, -2);
+
+  const std::list<TopologyReader::Link>& links = reader.GetLinks();
+  BOOST_REQUIRE_EQUAL(links.size(), 2);
+
+  const TopologyReader::Link& link = links.back();
+  BOOST_CHECK_EQUAL(link.GetFromNodeName(), "B");
+  BOOST_CHECK_EQUAL(link.GetToNodeName(), "C");
+  BOOST_CHECK_EQUAL(link.GetAttribute("OSPF"), "2");
+
+  Ptr<PointToPointNetDevice> device = DynamicCast<PointToPointNetDevice>(link.GetFromNetDevice());
+  BOOST_REQUIRE(device != nullptr);
+  DataRateValue dataRate;
+  device->GetAttribute("DataRate", dataRate);
+  BOOST_CHECK_EQUAL(dataRate.Get(), DataRate("1Mbps"));
+
+  TimeValue delay;
+  device->GetChannel()->GetAttribute("Delay", delay);
+  BOOST_CHECK_EQUAL(delay.Get(), MilliSeconds(5));
+
+  UintegerValue maxPackets;
+  device->GetQueue()->GetAttribute("MaxPackets", maxPackets);
+  BOOST_CHECK_EQUAL(maxPackets.Get(), 30);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
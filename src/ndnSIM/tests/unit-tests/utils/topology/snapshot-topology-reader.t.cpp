@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/snapshot-topology-reader.hpp"
+
+#include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "ns3/channel.h"
+#include "ns3/data-rate.h"
+#include "ns3/mobility-model.h"
+#include "ns3/net-device.h"
+#include "ns3/point-to-point-net-device.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_SNAPSHOT_TOPOLOGY =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "snapshot-topo.txt";
+const boost::filesystem::path TEST_SNAPSHOT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "snapshot-topo.snapshot";
+
+class SnapshotTopologyReaderFixture : public CleanupFixture
+{
+public:
+  SnapshotTopologyReaderFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+    writeTopology("A1  NA  1  1\n"
+                  "B1  NA  80 -40\n"
+                  "C1  NA  0  0\n",
+                  "A1  B1  10Mbps  100  1ms  100\n"
+                  "A1  C1  10Mbps  50   2ms  100\n"
+                  "B1  C1  10Mbps  1    1ms  100\n");
+  }
+
+  ~SnapshotTopologyReaderFixture()
+  {
+    boost::filesystem::remove(TEST_SNAPSHOT_TOPOLOGY);
+    boost::filesystem::remove(TEST_SNAPSHOT);
+  }
+
+  void
+  writeTopology(const std::string& routers, const std::string& links)
+  {
+    std::ofstream os(TEST_SNAPSHOT_TOPOLOGY.string().c_str());
+    os << "router\n" << routers << "link\n" << links;
+  }
+
+  /// Read the topology, install the stack, and compute the routes if not read from the snapshot
+  bool
+  setUpScenario()
+  {
+    SnapshotTopologyReader topologyReader("", 10);
+    topologyReader.SetFileName(TEST_SNAPSHOT_TOPOLOGY.string());
+    topologyReader.SetSnapshotFileName(TEST_SNAPSHOT.string());
+    topologyReader.Read();
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+    topologyReader.ApplyOspfMetric();
+
+    if (topologyReader.IsSnapshotRead()) {
+      topologyReader.InstallRoutes();
+      return true;
+    }
+
+    GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+    ndnGlobalRoutingHelper.AddOrigins("/test/prefix", Names::Find<Node>("C1"));
+    GlobalRoutingHelper::CalculateRoutes();
+    topologyReader.SaveSnapshot();
+    return false;
+  }
+
+  /// Get the next hops of /test/prefix on a node, as the names of the neighbors and the costs
+  std::map<std::string, uint64_t>
+  getNextHops(const std::string& node)
+  {
+    std::map<std::string, uint64_t> nextHops;
+    auto ndn = Names::Find<Node>(node)->GetObject<L3Protocol>();
+    nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch(Name("/test/prefix"));
+    if (entry == nullptr) {
+      return nextHops;
+    }
+
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      BOOST_REQUIRE(transport != nullptr);
+      Ptr<NetDevice> device = transport->GetNetDevice();
+      Ptr<Channel> channel = device->GetChannel();
+      Ptr<NetDevice> otherDevice = channel->GetDevice(channel->GetDevice(0) == device ? 1 : 0);
+      nextHops[Names::FindName(otherDevice->GetNode())] = nextHop.getCost();
+    }
+    return nextHops;
+  }
+
+  void
+  cleanUp()
+  {
+    Simulator::Destroy();
+    Names::Clear();
+    GlobalRouter::clear();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologySnapshotTopologyReader, SnapshotTopologyReaderFixture)
+
+BOOST_AUTO_TEST_CASE(SaveAndRead)
+{
+  BOOST_CHECK_EQUAL(setUpScenario(), false);
+  BOOST_CHECK(boost::filesystem::exists(TEST_SNAPSHOT));
+  std::map<std::string, uint64_t> computedA = getNextHops("A1");
+  std::map<std::string, uint64_t> computedB = getNextHops("B1");
+  Vector positionC = Names::Find<Node>("C1")->GetObject<MobilityModel>()->GetPosition();
+  BOOST_CHECK_EQUAL(computedA.size(), 1);
+  BOOST_CHECK_EQUAL(computedA.count("C1"), 1);
+  cleanUp();
+
+  BOOST_CHECK_EQUAL(setUpScenario(), true);
+  BOOST_CHECK(getNextHops("A1") == computedA);
+  BOOST_CHECK(getNextHops("B1") == computedB);
+  BOOST_CHECK_EQUAL(getNextHops("C1").size(), 0);
+
+  // the random position of C1 is in the snapshot
+  Vector readPositionC = Names::Find<Node>("C1")->GetObject<MobilityModel>()->GetPosition();
+  BOOST_CHECK_EQUAL(readPositionC.x, positionC.x);
+  BOOST_CHECK_EQUAL(readPositionC.y, positionC.y);
+  Vector positionA = Names::Find<Node>("A1")->GetObject<MobilityModel>()->GetPosition();
+  BOOST_CHECK_CLOSE(positionA.x, 10, 0.0001);
+  BOOST_CHECK_CLOSE(positionA.y, -10, 0.0001);
+
+  Ptr<NetDevice> device = Names::Find<Node>("A1")->GetDevice(1);
+  DataRateValue dataRate;
+  device->GetAttribute("DataRate", dataRate);
+  BOOST_CHECK_EQUAL(dataRate.Get(), DataRate("10Mbps"));
+  TimeValue delay;
+  device->GetChannel()->GetAttribute("Delay", delay);
+  BOOST_CHECK_EQUAL(delay.Get(), MilliSeconds(2));
+}
+
+BOOST_AUTO_TEST_CASE(ChangedTopology)
+{
+  BOOST_CHECK_EQUAL(setUpScenario(), false);
+  cleanUp();
+
+  // the route of A1 goes through B1 when the link to C1 is expensive
+  writeTopology("A1  NA  1  1\n"
+                "B1  NA  80 -40\n"
+                "C1  NA  0  0\n",
+                "A1  B1  10Mbps  100  1ms  100\n"
+                "A1  C1  10Mbps  500  2ms  100\n"
+                "B1  C1  10Mbps  1    1ms  100\n");
+  BOOST_CHECK_EQUAL(setUpScenario(), false);
+  BOOST_CHECK_EQUAL(getNextHops("A1").count("B1"), 1);
+  cleanUp();
+
+  BOOST_CHECK_EQUAL(setUpScenario(), true);
+  BOOST_CHECK_EQUAL(getNextHops("A1").count("B1"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
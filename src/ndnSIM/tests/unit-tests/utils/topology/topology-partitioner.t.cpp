@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTopologyPartitioner)
+
+BOOST_AUTO_TEST_CASE(SinglePartition)
+{
+  TopologyPartitioner partitioner;
+  for (int i = 0; i < 3; ++i) {
+    partitioner.AddVertex();
+  }
+  partitioner.AddEdge(0, 1, MilliSeconds(1));
+  partitioner.AddEdge(1, 2, MilliSeconds(1));
+
+  BOOST_CHECK(partitioner.Partition(1) == std::vector<uint32_t>(3, 0));
+  BOOST_CHECK_EQUAL(partitioner.GetCutSize(), 0);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), Time::Max());
+  BOOST_CHECK_EQUAL(partitioner.GetLoads().size(), 1);
+  BOOST_CHECK_EQUAL(partitioner.GetLoads()[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(CutLongestLink)
+{
+  // two rings of 10 vertices with 1ms links, joined by a 10ms link and a 2ms link
+  TopologyPartitioner partitioner;
+  for (int i = 0; i < 20; ++i) {
+    partitioner.AddVertex();
+  }
+  for (uint32_t ring = 0; ring < 2; ++ring) {
+    for (uint32_t i = 0; i < 10; ++i) {
+      partitioner.AddEdge(ring * 10 + i, ring * 10 + (i + 1) % 10, MilliSeconds(1));
+    }
+  }
+  partitioner.AddEdge(0, 10, MilliSeconds(10));
+  partitioner.AddEdge(5, 15, MilliSeconds(2));
+
+  const std::vector<uint32_t>& partitions = partitioner.Partition(2);
+  for (uint32_t i = 1; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(partitions[i], partitions[0]);
+    BOOST_CHECK_EQUAL(partitions[10 + i], partitions[10]);
+  }
+  BOOST_CHECK_NE(partitions[0], partitions[10]);
+
+  BOOST_CHECK_EQUAL(partitioner.GetCutSize(), 2);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(2));
+  BOOST_CHECK(partitioner.GetLoads() == std::vector<double>(2, 10));
+}
+
+BOOST_AUTO_TEST_CASE(BalancedGrid)
+{
+  // 32 rows of 30 vertices, with 1ms links within the rows and 5ms links between them
+  const uint32_t nRows = 32;
+  const uint32_t nColumns = 30;
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < nRows * nColumns; ++i) {
+    partitioner.AddVertex(1 + i % 3);
+  }
+  for (uint32_t row = 0; row < nRows; ++row) {
+    for (uint32_t column = 0; column < nColumns; ++column) {
+      uint32_t i = row * nColumns + column;
+      if (column + 1 < nColumns) {
+        partitioner.AddEdge(i, i + 1, MilliSeconds(1));
+      }
+      if (row + 1 < nRows) {
+        partitioner.AddEdge(i, i + nColumns, MilliSeconds(5));
+      }
+    }
+  }
+
+  std::vector<uint32_t> partitions = partitioner.Partition(4);
+  BOOST_CHECK_EQUAL(partitions.size(), nRows * nColumns);
+
+  std::vector<double> loads = partitioner.GetLoads();
+  BOOST_REQUIRE_EQUAL(loads.size(), 4);
+  for (double load : loads) {
+    BOOST_CHECK_LE(load, 1.05 * 2 * nRows * nColumns / 4);
+  }
+
+  // the rows are not split, so the lookahead is the delay between them
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(5));
+  BOOST_CHECK_LE(partitioner.GetCutSize(), 4 * nColumns);
+
+  // deterministic
+  BOOST_CHECK(partitioner.Partition(4) == partitions);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
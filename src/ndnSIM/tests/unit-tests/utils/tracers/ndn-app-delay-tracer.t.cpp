@@ -28,6 +28,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_SAMPLE = boost::filesystem::path(TEST_CONFIG_PATH) / "sample.txt";
 
 class AppDelayTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -68,6 +69,7 @@ public:
   ~AppDelayTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_SAMPLE);
     AppDelayTracer::Destroy(); // additional cleanup
   }
 };
@@ -157,6 +159,81 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
     "3.02089	2	0	1	FullDelay	0.0208856	20885.6	1	1\n"));
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllSummaries)
+{
+  AppDelayTracer::InstallAllSummaries(TEST_TRACE.string(), Seconds(3.5));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	MeanS	P50S	P90S	P99S	P999S	MaxS\n"
+    "3.5	1	0	LastDelay	1	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712\n"
+    "3.5	1	0	FullDelay	1	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712\n"
+    "3.5	1	-1	LastDelay	1	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712\n"
+    "3.5	1	-1	FullDelay	1	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712\n"
+    "3.5	2	0	LastDelay	2	0.0104428	0	0.0208856	0.0208856	0.0208856	0.0208856\n"
+    "3.5	2	0	FullDelay	2	0.0104428	0	0.0208856	0.0208856	0.0208856	0.0208856\n"
+    "3.5	2	-1	LastDelay	2	0.0104428	0	0.0208856	0.0208856	0.0208856	0.0208856\n"
+    "3.5	2	-1	FullDelay	2	0.0104428	0	0.0208856	0.0208856	0.0208856	0.0208856\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllSummariesWithSample)
+{
+  AppDelayTracer::InstallAllSummaries(TEST_TRACE.string(), Seconds(3.5), TEST_SAMPLE.string(), 1.0);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_SAMPLE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  // all the Data packets are in the sample
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417712	1	0	0	LastDelay	0.0417712	41771.2	1	2\n"
+    "0.0417712	1	0	0	FullDelay	0.0417712	41771.2	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "3.02089	2	0	1	LastDelay	0.0208856	20885.6	1	1\n"
+    "3.02089	2	0	1	FullDelay	0.0208856	20885.6	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllSummariesWithEmptySample)
+{
+  AppDelayTracer::InstallAllSummaries(TEST_TRACE.string(), Seconds(3.5), TEST_SAMPLE.string(), 0.0);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_SAMPLE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n");
+
+  // the summaries do not depend on the sample
+  std::ifstream summaries(TEST_TRACE.string().c_str());
+  std::string header;
+  std::string line;
+  std::getline(summaries, header);
+  std::getline(summaries, line);
+  BOOST_CHECK_EQUAL(line,
+    "3.5	1	0	LastDelay	1	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712	0.0417712");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
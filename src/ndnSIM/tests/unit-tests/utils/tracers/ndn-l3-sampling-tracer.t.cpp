@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-l3-sampling-tracer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class L3SamplingTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  L3SamplingTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1"},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "0.9s"} // send just one packet
+      });
+  }
+
+  ~L3SamplingTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    L3SamplingTracer::Destroy(); // additional cleanup
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3SamplingTracer, L3SamplingTracerFixture)
+
+BOOST_AUTO_TEST_CASE(SampleOneIn)
+{
+  PacketEventSampler sampler;
+  BOOST_CHECK(!sampler.Sample());
+  BOOST_CHECK_EQUAL(sampler.GetProbability(), 0);
+
+  sampler.SampleOneIn(3);
+  std::vector<bool> samples;
+  for (int i = 0; i < 6; i++) {
+    samples.push_back(sampler.Sample());
+  }
+  BOOST_CHECK((samples == std::vector<bool>{false, false, true, false, false, true}));
+
+  sampler.Disable();
+  BOOST_CHECK(!sampler.Sample());
+}
+
+BOOST_AUTO_TEST_CASE(SampleWithProbability)
+{
+  PacketEventSampler sampler;
+  sampler.SampleWithProbability(0.1);
+  BOOST_CHECK_EQUAL(sampler.GetProbability(), 0.1);
+
+  int nSamples = 0;
+  for (int i = 0; i < 100000; i++) {
+    nSamples += sampler.Sample();
+  }
+  BOOST_CHECK_CLOSE(nSamples, 10000.0, 5);
+}
+
+BOOST_AUTO_TEST_CASE(RecorderWrapsAround)
+{
+  PacketEventRecorder recorder(4);
+  recorder.GetSampler(IN_INTEREST).SampleAll();
+
+  std::vector<size_t> spans;
+  std::vector<int64_t> times;
+  recorder.SetConsumer([&] (const PacketEvent* events, size_t nEvents) {
+      spans.push_back(nEvents);
+      for (size_t i = 0; i < nEvents; i++) {
+        times.push_back(events[i].time);
+      }
+    });
+
+  shared_ptr<Face> face = getNode("1")->GetObject<L3Protocol>()->getFaceById(1);
+  Interest interest("/prefix");
+  for (int i = 0; i < 3; i++) {
+    recorder.Record(IN_INTEREST, interest, *face);
+  }
+  recorder.Drain();
+  BOOST_CHECK_EQUAL(recorder.GetSize(), 0);
+
+  // the 6 next events fill the buffer, which is drained in two spans around its end, and the last
+  // two events wrap around the end again
+  for (int i = 0; i < 6; i++) {
+    recorder.Record(IN_INTEREST, interest, *face);
+  }
+  BOOST_CHECK_EQUAL(recorder.GetSize(), 2);
+  recorder.Drain();
+
+  BOOST_CHECK((spans == std::vector<size_t>{3, 1, 3, 1, 1}));
+  BOOST_CHECK_EQUAL(times.size(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(SampleAllPackets)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3SamplingTracer::Install(nodes, TEST_TRACE.string(), Seconds(1), 1.0);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3SamplingTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	FaceId	FaceDescr	Type	Samples	PacketRaw	KilobytesRaw\n"
+    "1	1	257	appFace://	InInterests	1	1	0\n"
+    "1	1	257	appFace://	OutNacks	1	1	0\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-latency-histogram.hpp"
+
+#include <cmath>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  LatencyHistogram histogram;
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMean(), Time(0));
+  BOOST_CHECK_EQUAL(histogram.GetMax(), Time(0));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), Time(0));
+}
+
+BOOST_AUTO_TEST_CASE(SmallValues)
+{
+  LatencyHistogram histogram;
+  // the delays below 256ns are counted exactly
+  for (int i = 1; i <= 100; i++) {
+    histogram.AddValue(NanoSeconds(i));
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), NanoSeconds(1));
+  BOOST_CHECK_EQUAL(histogram.GetMax(), NanoSeconds(100));
+  BOOST_CHECK_EQUAL(histogram.GetMean(), NanoSeconds(50));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), NanoSeconds(50));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.9), NanoSeconds(90));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.99), NanoSeconds(99));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(1.0), NanoSeconds(100));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.0), NanoSeconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  LatencyHistogram histogram;
+  // delays from 1ms to 10s
+  for (int i = 1; i <= 10000; i++) {
+    histogram.AddValue(MilliSeconds(i));
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 10000);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), MilliSeconds(1));
+  BOOST_CHECK_EQUAL(histogram.GetMax(), Seconds(10));
+
+  const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+  for (double q : quantiles) {
+    double expected = std::ceil(q * 10000) / 1000;
+    double value = histogram.GetQuantile(q).ToDouble(Time::S);
+    BOOST_CHECK_CLOSE(value, expected, 0.4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  LatencyHistogram histogram;
+  histogram.AddValue(Seconds(1));
+  histogram.Reset();
+  histogram.AddValue(MilliSeconds(2));
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 1);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), MilliSeconds(2));
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.99), MilliSeconds(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
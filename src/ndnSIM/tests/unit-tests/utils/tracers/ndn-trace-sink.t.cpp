@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE_TXT = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_TRACE_BIN = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
+
+class TraceSinkFixture
+{
+public:
+  TraceSinkFixture()
+    : columns({{"Time", TraceSink::DOUBLE}, {"Node", TraceSink::STRING},
+               {"Seq", TraceSink::INTEGER}, {"Type", TraceSink::STRING}})
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TraceSinkFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE_TXT);
+    boost::filesystem::remove(TEST_TRACE_BIN);
+  }
+
+  void
+  writeRecords(TraceSink& sink)
+  {
+    sink.Write(0.5, "1", 10, "In");
+    sink.Write(1, "1", 11u, "Out");
+    sink.Write(1.5, std::string("2"), -1, "In");
+  }
+
+public:
+  std::vector<TraceSink::Column> columns;
+};
+
+template<typename T>
+static T
+readNumber(const std::string& buffer, size_t& position)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(buffer.at(position + i))) << (8 * i);
+  }
+  position += sizeof(T);
+
+  T result;
+  std::memcpy(&result, &value, sizeof(T));
+  return result;
+}
+
+static std::string
+readString(const std::string& buffer, size_t& position, size_t length)
+{
+  std::string value = buffer.substr(position, length);
+  position += length;
+  return value;
+}
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, TraceSinkFixture)
+
+BOOST_AUTO_TEST_CASE(TextFile)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(TEST_TRACE_TXT.string(), columns);
+  BOOST_REQUIRE(sink != nullptr);
+  writeRecords(*sink);
+  sink.reset(); // to force the records to be written
+
+  std::ifstream t(TEST_TRACE_TXT.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	Seq	Type\n"
+    "0.5	1	10	In\n"
+    "1	1	11	Out\n"
+    "1.5	2	-1	In\n");
+}
+
+BOOST_AUTO_TEST_CASE(TextFileHeader)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(TEST_TRACE_TXT.string(), columns,
+                                               "Time\tNode\tSeq\tType\t");
+  BOOST_REQUIRE(sink != nullptr);
+  writeRecords(*sink);
+  sink.reset(); // to force the records to be written
+
+  std::ifstream t(TEST_TRACE_TXT.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	Seq	Type	\n"
+    "0.5	1	10	In\n"
+    "1	1	11	Out\n"
+    "1.5	2	-1	In\n");
+}
+
+BOOST_AUTO_TEST_CASE(TextStream)
+{
+  auto output = make_shared<boost::test_tools::output_test_stream>();
+  shared_ptr<TraceSink> sink = TraceSink::CreateText(output, columns);
+
+  writeRecords(*sink);
+  // the records go through to the stream
+  BOOST_CHECK(output->is_equal(
+    "0.5	1	10	In\n"
+    "1	1	11	Out\n"
+    "1.5	2	-1	In\n"));
+}
+
+BOOST_AUTO_TEST_CASE(BinaryFile)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(TEST_TRACE_BIN.string(), columns);
+  BOOST_REQUIRE(sink != nullptr);
+  writeRecords(*sink);
+  sink.reset();
+
+  std::ifstream t(TEST_TRACE_BIN.string().c_str(), std::ios_base::binary);
+  std::stringstream stream;
+  stream << t.rdbuf();
+  std::string buffer = stream.str();
+
+  size_t position = 0;
+  BOOST_CHECK_EQUAL(readString(buffer, position, 8), "NDNTRACE");
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 1);
+  BOOST_REQUIRE_EQUAL(readNumber<uint32_t>(buffer, position), columns.size());
+  for (const auto& column : columns) {
+    BOOST_CHECK_EQUAL(readNumber<uint8_t>(buffer, position), column.type);
+    uint16_t length = readNumber<uint16_t>(buffer, position);
+    BOOST_CHECK_EQUAL(readString(buffer, position, length), column.name);
+  }
+
+  // one block of 3 records, with the strings "1", "In", "Out", "2"
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 3);
+  BOOST_REQUIRE_EQUAL(readNumber<uint32_t>(buffer, position), 4);
+  std::vector<std::string> strings;
+  for (int i = 0; i < 4; i++) {
+    uint32_t length = readNumber<uint32_t>(buffer, position);
+    strings.push_back(readString(buffer, position, length));
+  }
+  BOOST_CHECK_EQUAL(strings[0], "1");
+  BOOST_CHECK_EQUAL(strings[1], "In");
+  BOOST_CHECK_EQUAL(strings[2], "Out");
+  BOOST_CHECK_EQUAL(strings[3], "2");
+
+  BOOST_CHECK_EQUAL(readNumber<double>(buffer, position), 0.5);
+  BOOST_CHECK_EQUAL(readNumber<double>(buffer, position), 1.0);
+  BOOST_CHECK_EQUAL(readNumber<double>(buffer, position), 1.5);
+
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 0);
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 0);
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 3);
+
+  BOOST_CHECK_EQUAL(readNumber<int64_t>(buffer, position), 10);
+  BOOST_CHECK_EQUAL(readNumber<int64_t>(buffer, position), 11);
+  BOOST_CHECK_EQUAL(readNumber<int64_t>(buffer, position), -1);
+
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 1);
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 2);
+  BOOST_CHECK_EQUAL(readNumber<uint32_t>(buffer, position), 1);
+
+  BOOST_CHECK_EQUAL(position, buffer.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,168 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Copyright (c) 2011-2015  Regents of the University of California.
+#
+# This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+# contributors.
+#
+# ndnSIM is free software: you can redistribute it and/or modify it under the terms
+# of the GNU General Public License as published by the Free Software Foundation,
+# either version 3 of the License, or (at your option) any later version.
+#
+# ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with
+# ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Convert a CSV request trace to the binary format replayed by ns3::ndn::ConsumerTrace.
+
+The CSV lines are "timestamp,node,name,size", with the timestamp in seconds, the id of the
+node issuing the request, the NDN name in URI form, and the size of the requested content.  A
+header line is skipped.  The requests of each node must be in time order.
+
+The conversion reads the CSV twice and keeps only small per-node buffers in memory, so that
+traces larger than the memory can be converted.  The times are counted from the earliest
+timestamp of the trace.
+
+Usage: csv-to-request-trace.py trace.csv trace.bin
+"""
+
+import csv
+import struct
+import sys
+
+MAGIC = b'NDNRQTRC'
+VERSION = 1
+HEADER = struct.Struct('<8sII')
+INDEX_ENTRY = struct.Struct('<IIQQ')
+RECORD_HEADER = struct.Struct('<QIH')
+BUFFER_SIZE = 1 << 20
+
+
+def encodeNumber(n):
+    if n < 253:
+        return struct.pack('B', n)
+    elif n <= 0xFFFF:
+        return struct.pack('>BH', 253, n)
+    elif n <= 0xFFFFFFFF:
+        return struct.pack('>BI', 254, n)
+    else:
+        return struct.pack('>BQ', 255, n)
+
+
+def encodeTlv(type, value):
+    return encodeNumber(type) + encodeNumber(len(value)) + value
+
+
+def unescape(component):
+    value = bytearray()
+    i = 0
+    while i < len(component):
+        if component[i] == '%' and i + 2 < len(component):
+            value.append(int(component[i + 1:i + 3], 16))
+            i += 3
+        else:
+            value.extend(component[i].encode('utf-8'))
+            i += 1
+    return bytes(value)
+
+
+def encodeName(uri):
+    """TLV encoding of a name in URI form, as parsed by ndn::Name"""
+    if isinstance(uri, bytes):
+        # the csv module of python 2 reads byte strings
+        uri = uri.decode('utf-8')
+    if uri.startswith('ndn:'):
+        uri = uri[len('ndn:'):]
+    if uri.startswith('//'):
+        # skip the authority
+        uri = uri[uri.find('/', 2):] if uri.find('/', 2) >= 0 else '/'
+
+    components = b''
+    for component in uri.strip().split('/'):
+        if component == '':
+            continue
+        if component.startswith('sha256digest='):
+            components += encodeTlv(1, bytes(bytearray.fromhex(component[len('sha256digest='):])))
+            continue
+        value = unescape(component)
+        if value.strip(b'.') == b'':
+            if len(value) < 3:
+                raise ValueError('Invalid name component "%s" in %s' % (component, uri))
+            value = value[3:]
+        components += encodeTlv(8, value)
+    return encodeTlv(7, components)
+
+
+def readRequests(filename):
+    with open(filename) as f:
+        for lineNo, row in enumerate(csv.reader(f)):
+            if len(row) < 4:
+                continue
+            try:
+                timestamp = float(row[0])
+            except ValueError:
+                if lineNo == 0:
+                    continue  # header
+                raise
+            yield timestamp, int(row[1]), row[2].strip(), int(row[3])
+
+
+def convert(csvFilename, traceFilename):
+    # first pass: records and bytes of each node, and the time origin
+    nodes = {}
+    start = None
+    for timestamp, node, name, size in readRequests(csvFilename):
+        if start is None or timestamp < start:
+            start = timestamp
+        stats = nodes.setdefault(node, [0, 0, timestamp])
+        if timestamp < stats[2]:
+            raise ValueError('Requests of node %d are not in time order' % node)
+        stats[0] += 1
+        stats[1] += RECORD_HEADER.size + len(encodeName(name))
+        stats[2] = timestamp
+
+    nodeIds = sorted(nodes)
+    offsets = {}
+    offset = HEADER.size + INDEX_ENTRY.size * len(nodeIds)
+    for node in nodeIds:
+        offsets[node] = offset
+        offset += nodes[node][1]
+
+    with open(traceFilename, 'wb') as out:
+        out.write(HEADER.pack(MAGIC, VERSION, len(nodeIds)))
+        for node in nodeIds:
+            out.write(INDEX_ENTRY.pack(node, 0, offsets[node], nodes[node][0]))
+
+        # second pass: the records, written to the area of their node through small buffers
+        buffers = dict((node, bytearray()) for node in nodeIds)
+
+        def flush(node):
+            out.seek(offsets[node])
+            out.write(buffers[node])
+            offsets[node] += len(buffers[node])
+            buffers[node] = bytearray()
+
+        for timestamp, node, name, size in readRequests(csvFilename):
+            encodedName = encodeName(name)
+            if len(encodedName) > 0xFFFF:
+                raise ValueError('Name too long: %s' % name)
+            time = int(round((timestamp - start) * 1e9))
+            buffers[node] += RECORD_HEADER.pack(time, size, len(encodedName)) + encodedName
+            if len(buffers[node]) >= BUFFER_SIZE:
+                flush(node)
+        for node in nodeIds:
+            flush(node)
+
+    return sum(stats[0] for stats in nodes.values()), len(nodeIds)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        sys.stderr.write(__doc__)
+        sys.exit(1)
+    nRecords, nNodes = convert(sys.argv[1], sys.argv[2])
+    print('%d requests of %d nodes' % (nRecords, nNodes))
@@ -319,7 +319,9 @@ Block
 DummyTpm::signInTpm(const uint8_t* data, size_t dataLength, const Name& keyName,
                     DigestAlgorithm digestAlgorithm)
 {
-  return Block(DUMMY_SIGNATURE, sizeof(DUMMY_SIGNATURE));
+  // the signature does not depend on the data, so the same block (and buffer) is returned
+  static const Block signature(DUMMY_SIGNATURE, sizeof(DUMMY_SIGNATURE));
+  return signature;
 }
 
 ConstBufferPtr
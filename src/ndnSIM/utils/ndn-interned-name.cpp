@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-interned-name.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+/**
+ * @brief Global table of interned prefixes
+ *
+ * Entry 0 is the root prefix, which is not reference-counted and never released.  Released entries are kept on a free
+ * list and reused, so the table does not grow beyond the peak number of live prefixes.
+ *
+ * The partitions of a parallel simulation intern names concurrently, so the table is locked.  The
+ * entries are in a deque, whose references stay valid as it grows: getPrefix() returns a reference
+ * which a handle keeps valid.
+ */
+class PrefixTable
+{
+public:
+  PrefixTable()
+  {
+    m_entries.push_back(Entry{Name(), 0});
+    m_index.insert(std::make_pair(Name(), 0));
+  }
+
+  static PrefixTable&
+  get()
+  {
+    // never destroyed, as handles may outlive function-local statics
+    static PrefixTable* table = new PrefixTable;
+    return *table;
+  }
+
+  InternedName::PrefixId
+  acquire(const Name& prefix)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(prefix);
+    if (it != m_index.end()) {
+      ++m_entries[it->second].nRefs;
+      return it->second;
+    }
+
+    // deep copy, so the table does not keep alive the buffer of the packet the prefix came from
+    Entry entry{prefix.deepCopy(), 1};
+
+    InternedName::PrefixId id;
+    if (!m_freeIds.empty()) {
+      id = m_freeIds.back();
+      m_freeIds.pop_back();
+      m_entries[id] = entry;
+    }
+    else {
+      id = static_cast<InternedName::PrefixId>(m_entries.size());
+      m_entries.push_back(entry);
+    }
+    m_index.insert(std::make_pair(m_entries[id].prefix, id));
+    return id;
+  }
+
+  void
+  addRef(InternedName::PrefixId id)
+  {
+    if (id == 0)
+      return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_entries[id].nRefs;
+  }
+
+  void
+  release(InternedName::PrefixId id)
+  {
+    if (id == 0)
+      return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_entries[id].nRefs > 0)
+      return;
+
+    Entry& entry = m_entries[id];
+    m_index.erase(entry.prefix);
+    entry.prefix = Name();
+    m_freeIds.push_back(id);
+  }
+
+  const Name&
+  getPrefix(InternedName::PrefixId id) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries[id].prefix;
+  }
+
+  size_t
+  size() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.size();
+  }
+
+private:
+  struct Entry
+  {
+    Name prefix;
+    uint32_t nRefs;
+  };
+
+  mutable std::mutex m_mutex;
+  std::deque<Entry> m_entries;
+  std::vector<InternedName::PrefixId> m_freeIds;
+  std::unordered_map<Name, InternedName::PrefixId> m_index;
+};
+
+} // namespace
+
+InternedName::InternedName()
+  : m_prefixId(0)
+{
+}
+
+InternedName::InternedName(const Name& name)
+{
+  if (name.empty()) {
+    m_prefixId = 0;
+    return;
+  }
+
+  m_prefixId = PrefixTable::get().acquire(name.getPrefix(-1));
+
+  const Block& last = name.get(-1).wireEncode();
+  m_lastComponent.assign(reinterpret_cast<const char*>(last.wire()), last.size());
+}
+
+InternedName::InternedName(const InternedName& other)
+  : m_prefixId(other.m_prefixId)
+  , m_lastComponent(other.m_lastComponent)
+{
+  PrefixTable::get().addRef(m_prefixId);
+}
+
+InternedName&
+InternedName::operator=(const InternedName& other)
+{
+  if (this != &other) {
+    PrefixTable::get().addRef(other.m_prefixId);
+    PrefixTable::get().release(m_prefixId);
+    m_prefixId = other.m_prefixId;
+    m_lastComponent = other.m_lastComponent;
+  }
+  return *this;
+}
+
+InternedName::~InternedName()
+{
+  PrefixTable::get().release(m_prefixId);
+}
+
+const Name&
+InternedName::getPrefix() const
+{
+  return PrefixTable::get().getPrefix(m_prefixId);
+}
+
+name::Component
+InternedName::getLastComponent() const
+{
+  BOOST_ASSERT(!empty());
+  return name::Component(Block(reinterpret_cast<const uint8_t*>(m_lastComponent.data()),
+                               m_lastComponent.size()));
+}
+
+Name
+InternedName::toName() const
+{
+  Name name = getPrefix();
+  if (!empty()) {
+    name.append(getLastComponent());
+  }
+  return name;
+}
+
+size_t
+InternedName::hash() const
+{
+  size_t seed = m_prefixId;
+  boost::hash_combine(seed, m_lastComponent);
+  return seed;
+}
+
+size_t
+InternedName::GetNPrefixes()
+{
+  return PrefixTable::get().size();
+}
+
+std::ostream&
+operator<<(std::ostream& os, const InternedName& name)
+{
+  return os << name.toName();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_INTERNED_NAME_HPP
+#define NDNSIM_UTILS_NDN_INTERNED_NAME_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Compact handle to a name with its prefix interned in a global table
+ *
+ * Simulated names usually differ only in the last component (e.g., /prefix/%FE%00,
+ * /prefix/%FE%01, ...).  All components but the last are stored once in a reference-counted
+ * prefix table shared by all handles, while the handle itself keeps the prefix identifier and
+ * the TLV encoding of the last component (short enough to fit into std::string's inline
+ * storage for sequence numbers).  Unlike ndn::Name, a handle never holds a reference to the
+ * packet buffer the name was decoded from.
+ *
+ * Handles can be used as keys of std::map and std::unordered_map.  The ordering is consistent,
+ * but it is NOT the NDN canonical ordering of the corresponding names.
+ *
+ * The table is shared by the partitions of a parallel simulation and is locked; a single handle,
+ * like the rest of the simulation state, must not be used by several threads at once.
+ */
+class InternedName
+{
+public:
+  typedef uint32_t PrefixId;
+
+  /**
+   * @brief Create a handle for the empty name (ndn:/)
+   */
+  InternedName();
+
+  /**
+   * @brief Intern prefix of @p name and create a handle for it
+   */
+  explicit
+  InternedName(const Name& name);
+
+  InternedName(const InternedName& other);
+
+  InternedName&
+  operator=(const InternedName& other);
+
+  ~InternedName();
+
+  /**
+   * @brief Get identifier of the interned prefix (all but the last component)
+   *
+   * Identifiers are unique among the live prefixes and are reused once all handles to a prefix
+   * are gone.
+   */
+  PrefixId
+  getPrefixId() const
+  {
+    return m_prefixId;
+  }
+
+  /**
+   * @brief Get the interned prefix (all but the last component)
+   */
+  const Name&
+  getPrefix() const;
+
+  /**
+   * @brief Check if the handle refers to the empty name
+   */
+  bool
+  empty() const
+  {
+    return m_lastComponent.empty();
+  }
+
+  /**
+   * @brief Get the last component
+   * @pre !empty()
+   */
+  name::Component
+  getLastComponent() const;
+
+  /**
+   * @brief Reconstruct the full name
+   */
+  Name
+  toName() const;
+
+  bool
+  operator==(const InternedName& other) const
+  {
+    return m_prefixId == other.m_prefixId && m_lastComponent == other.m_lastComponent;
+  }
+
+  bool
+  operator!=(const InternedName& other) const
+  {
+    return !(*this == other);
+  }
+
+  bool
+  operator<(const InternedName& other) const
+  {
+    return m_prefixId < other.m_prefixId ||
+           (m_prefixId == other.m_prefixId && m_lastComponent < other.m_lastComponent);
+  }
+
+  size_t
+  hash() const;
+
+public:
+  /**
+   * @brief Get number of prefixes currently interned, including the root prefix
+   */
+  static size_t
+  GetNPrefixes();
+
+private:
+  PrefixId m_prefixId;
+  std::string m_lastComponent;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const InternedName& name);
+
+} // namespace ndn
+} // namespace ns3
+
+namespace std {
+
+template<>
+struct hash<ns3::ndn::InternedName>
+{
+  size_t
+  operator()(const ns3::ndn::InternedName& name) const
+  {
+    return name.hash();
+  }
+};
+
+} // namespace std
+
+#endif // NDNSIM_UTILS_NDN_INTERNED_NAME_HPP
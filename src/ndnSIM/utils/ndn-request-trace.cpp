@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RequestTrace");
+
+namespace ns3 {
+namespace ndn {
+
+static const char MAGIC[8] = {'N', 'D', 'N', 'R', 'Q', 'T', 'R', 'C'};
+static const uint32_t VERSION = 1;
+static const size_t HEADER_SIZE = 16;
+static const size_t INDEX_ENTRY_SIZE = 24;
+static const size_t RECORD_HEADER_SIZE = 14;
+
+template<typename T>
+static T
+readNumber(const uint8_t* position)
+{
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<T>(position[i]) << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Describe the position of a record in the error messages
+ */
+static std::string
+where(ptrdiff_t offset, const std::string& filename)
+{
+  return " at offset " + std::to_string(offset) + " of request trace " + filename;
+}
+
+shared_ptr<RequestTrace>
+RequestTrace::Open(const std::string& filename)
+{
+  // the applications of a parallel simulation may start concurrently
+  static std::map<std::string, std::weak_ptr<RequestTrace>> traces;
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+
+  shared_ptr<RequestTrace> trace = traces[filename].lock();
+  if (trace == nullptr) {
+    trace.reset(new RequestTrace(filename));
+    traces[filename] = trace;
+  }
+  return trace;
+}
+
+RequestTrace::RequestTrace(const std::string& filename)
+  : m_filename(filename)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_nNodes(0)
+  , m_index(nullptr)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open request trace " + filename);
+  }
+  struct stat status;
+  if (::fstat(fd, &status) < 0 || static_cast<size_t>(status.st_size) < HEADER_SIZE) {
+    ::close(fd);
+    throw std::runtime_error("Invalid request trace " + filename);
+  }
+  m_size = status.st_size;
+  void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Cannot map request trace " + filename);
+  }
+  m_data = static_cast<const uint8_t*>(data);
+  ::madvise(data, m_size, MADV_SEQUENTIAL);
+
+  m_nNodes = readNumber<uint32_t>(m_data + 12);
+  if (std::memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0
+      || readNumber<uint32_t>(m_data + 8) != VERSION
+      || HEADER_SIZE + static_cast<uint64_t>(m_nNodes) * INDEX_ENTRY_SIZE > m_size) {
+    ::munmap(data, m_size);
+    throw std::runtime_error("Invalid request trace " + filename);
+  }
+  m_index = m_data + HEADER_SIZE;
+
+  NS_LOG_DEBUG("Mapped " << m_size << " bytes of " << filename << " with " << m_nNodes
+                         << " nodes");
+}
+
+RequestTrace::~RequestTrace()
+{
+  ::munmap(const_cast<uint8_t*>(m_data), m_size);
+}
+
+RequestTrace::Cursor
+RequestTrace::getCursor(uint32_t nodeId) const
+{
+  // binary search of the index
+  uint32_t first = 0;
+  uint32_t last = m_nNodes;
+  while (first < last) {
+    uint32_t middle = first + (last - first) / 2;
+    if (readNumber<uint32_t>(m_index + middle * INDEX_ENTRY_SIZE) < nodeId) {
+      first = middle + 1;
+    }
+    else {
+      last = middle;
+    }
+  }
+
+  const uint8_t* entry = m_index + first * INDEX_ENTRY_SIZE;
+  if (first == m_nNodes || readNumber<uint32_t>(entry) != nodeId) {
+    return Cursor(shared_from_this(), nullptr, 0);
+  }
+
+  uint64_t offset = readNumber<uint64_t>(entry + 8);
+  uint64_t nRecords = readNumber<uint64_t>(entry + 16);
+  if (offset > m_size) {
+    throw std::runtime_error("Invalid index of node " + std::to_string(nodeId) + " in request trace "
+                             + m_filename);
+  }
+  return Cursor(shared_from_this(), m_data + offset, nRecords);
+}
+
+std::vector<uint32_t>
+RequestTrace::getNodeIds() const
+{
+  std::vector<uint32_t> nodeIds;
+  for (uint32_t i = 0; i < m_nNodes; i++) {
+    nodeIds.push_back(readNumber<uint32_t>(m_index + i * INDEX_ENTRY_SIZE));
+  }
+  return nodeIds;
+}
+
+RequestTrace::Cursor::Cursor(shared_ptr<const RequestTrace> trace, const uint8_t* position,
+                             uint64_t nRecords)
+  : m_trace(trace)
+  , m_position(position)
+  , m_released(position)
+  , m_nRemaining(nRecords)
+{
+}
+
+size_t
+RequestTrace::Cursor::read(std::vector<Record>& records, size_t n)
+{
+  const uint8_t* end = m_trace->m_data + m_trace->m_size;
+
+  records.resize(std::min<uint64_t>(n, m_nRemaining));
+  for (Record& record : records) {
+    const uint8_t* start = m_position;
+    if (end - m_position < static_cast<ptrdiff_t>(RECORD_HEADER_SIZE)) {
+      throw std::runtime_error("Truncated record" + where(start - m_trace->m_data, m_trace->m_filename));
+    }
+    record.time = NanoSeconds(readNumber<uint64_t>(m_position));
+    record.size = readNumber<uint32_t>(m_position + 8);
+    uint16_t length = readNumber<uint16_t>(m_position + 12);
+    m_position += RECORD_HEADER_SIZE;
+    if (end - m_position < length) {
+      throw std::runtime_error("Truncated record" + where(start - m_trace->m_data, m_trace->m_filename));
+    }
+    try {
+      record.name.wireDecode(Block(m_position, length));
+    }
+    catch (const ::ndn::tlv::Error& error) {
+      throw std::runtime_error("Invalid name" + where(start - m_trace->m_data, m_trace->m_filename)
+                               + ": " + error.what());
+    }
+    m_position += length;
+  }
+  m_nRemaining -= records.size();
+
+  // release the pages read, to keep the memory of long traces bounded
+  static const size_t pageSize = ::sysconf(_SC_PAGESIZE);
+  const uint8_t* base = m_trace->m_data;
+  const uint8_t* released = base + (m_position - base) / pageSize * pageSize;
+  if (released > m_released) {
+    const uint8_t* start = base + (m_released - base) / pageSize * pageSize;
+    ::madvise(const_cast<uint8_t*>(start), released - start, MADV_DONTNEED);
+    m_released = released;
+  }
+
+  return records.size();
+}
+
+} // namespace ndn
+} // namespace ns3
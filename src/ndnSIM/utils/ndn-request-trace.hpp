@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_REQUEST_TRACE_HPP
+#define NDNSIM_UTILS_NDN_REQUEST_TRACE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Read-only request trace, memory-mapped from a compact binary file
+ *
+ * The file, produced from a CSV trace by `csv-to-request-trace.py`, holds the requests of each
+ * node contiguously and in time order, after an index of the nodes:
+ *
+ *     header:  "NDNRQTRC", uint32 version (1), uint32 number of nodes
+ *     index:   per node, by increasing node id:
+ *              uint32 node id, uint32 reserved, uint64 offset of the first record, uint64 count
+ *     records: uint64 time (ns, from the start of the trace), uint32 size,
+ *              uint16 length, Name TLV of that length
+ *
+ * All the integers are little-endian.  The file is mapped once, whatever the number of consumers
+ * replaying it, and the records are decoded only when a cursor reads them: opening a trace of
+ * tens of GB does not read it.
+ */
+class RequestTrace : public std::enable_shared_from_this<RequestTrace>, boost::noncopyable
+{
+public:
+  struct Record
+  {
+    Time time;     ///< @brief time from the start of the trace
+    uint32_t size; ///< @brief size of the requested content, as recorded
+    Name name;     ///< @brief requested name
+  };
+
+  /**
+   * @brief Sequential reader of the records of one node
+   *
+   * The pages of the records already read are released from memory.
+   */
+  class Cursor
+  {
+  public:
+    /**
+     * @brief Decode up to @p n next records, replacing the content of @p records
+     * @return the number of records decoded, 0 at the end of the records of the node
+     * @throw std::runtime_error if a record is truncated or its name is invalid
+     */
+    size_t
+    read(std::vector<Record>& records, size_t n);
+
+    /**
+     * @brief Get the number of records not read yet
+     */
+    uint64_t
+    getNRemaining() const
+    {
+      return m_nRemaining;
+    }
+
+  private:
+    Cursor(shared_ptr<const RequestTrace> trace, const uint8_t* position, uint64_t nRecords);
+
+  private:
+    shared_ptr<const RequestTrace> m_trace;
+    const uint8_t* m_position;
+    const uint8_t* m_released; ///< @brief end of the pages already released
+    uint64_t m_nRemaining;
+
+    friend class RequestTrace;
+  };
+
+public:
+  /**
+   * @brief Map a trace file, or get the trace if it is already mapped
+   * @throw std::runtime_error if the file cannot be mapped or is not a valid trace
+   */
+  static shared_ptr<RequestTrace>
+  Open(const std::string& filename);
+
+  ~RequestTrace();
+
+  /**
+   * @brief Get a cursor at the first record of a node, without records if the node has none
+   */
+  Cursor
+  getCursor(uint32_t nodeId) const;
+
+  /**
+   * @brief Get the ids of the nodes with records
+   */
+  std::vector<uint32_t>
+  getNodeIds() const;
+
+private:
+  explicit
+  RequestTrace(const std::string& filename);
+
+private:
+  std::string m_filename;
+  const uint8_t* m_data;
+  size_t m_size;
+  uint32_t m_nNodes;
+  const uint8_t* m_index;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_REQUEST_TRACE_HPP
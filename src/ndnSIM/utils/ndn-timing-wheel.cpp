@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-timing-wheel.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TimingWheel");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(TimingWheel);
+
+TypeId
+TimingWheel::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::TimingWheel")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<TimingWheel>()
+
+      .AddAttribute("Granularity", "Period of the ticks of the wheel", TimeValue(MilliSeconds(1)),
+                    MakeTimeAccessor(&TimingWheel::m_granularity), MakeTimeChecker())
+      .AddAttribute("Slots", "Number of slots, i.e., ticks of a turn of the wheel",
+                    UintegerValue(4096), MakeUintegerAccessor(&TimingWheel::m_nSlots),
+                    MakeUintegerChecker<uint32_t>(1));
+
+  return tid;
+}
+
+Ptr<TimingWheel>
+TimingWheel::GetWheel(Ptr<Node> node)
+{
+  Ptr<TimingWheel> wheel = node->GetObject<TimingWheel>();
+  if (wheel == 0) {
+    wheel = CreateObject<TimingWheel>();
+    node->AggregateObject(wheel);
+  }
+  return wheel;
+}
+
+TimingWheel::TimingWheel()
+  : m_expiring(nullptr)
+  , m_nTimers(0)
+  , m_period(1)
+  , m_phase(0)
+{
+  m_timer.SetFunction(&TimingWheel::Tick, this);
+}
+
+int64_t
+TimingWheel::GetTick(int64_t time) const
+{
+  return (time - m_phase) / m_period;
+}
+
+void
+TimingWheel::Schedule(const Time& delay, Client* client, uint32_t id, uint32_t cookie)
+{
+  int64_t now = Simulator::Now().GetTimeStep();
+  if (!m_timer.IsRunning()) {
+    // the attributes are fixed from the first timer
+    NS_LOG_DEBUG("Starting with " << m_nSlots << " slots of " << m_granularity);
+    m_slots.resize(m_nSlots);
+    m_period = m_granularity.GetTimeStep();
+    m_phase = now % m_period;
+    m_timer.Start(m_granularity);
+  }
+  else {
+    m_timer.Wake();
+  }
+
+  // first tick at or after the expiration, and after the current tick which may be expiring
+  int64_t tick = (now + delay.GetTimeStep() - m_phase + m_period - 1) / m_period;
+  tick = std::max(tick, GetTick(now) + 1);
+
+  m_slots[tick % m_nSlots].push_back(Timer{tick, client, id, cookie});
+  m_nTimers++;
+}
+
+void
+TimingWheel::RemoveClient(Client* client)
+{
+  NS_LOG_FUNCTION(this << client);
+
+  for (auto& slot : m_slots) {
+    size_t size = slot.size();
+    slot.erase(std::remove_if(slot.begin(), slot.end(),
+                              [client](const Timer& timer) { return timer.client == client; }),
+               slot.end());
+    m_nTimers -= size - slot.size();
+  }
+
+  if (m_expiring != nullptr) {
+    // cannot be erased while iterated
+    for (Timer& timer : *m_expiring) {
+      if (timer.client == client) {
+        timer.client = nullptr;
+        m_nTimers--;
+      }
+    }
+  }
+}
+
+size_t
+TimingWheel::GetNTimers() const
+{
+  return m_nTimers;
+}
+
+bool
+TimingWheel::Tick()
+{
+  int64_t tick = GetTick(Simulator::Now().GetTimeStep());
+  std::vector<Timer>& slot = m_slots[tick % m_nSlots];
+
+  // the timers scheduled by the clients go to later ticks, possibly of this slot
+  std::vector<Timer> expiring;
+  expiring.swap(slot);
+  m_expiring = &expiring;
+  for (size_t i = 0; i < expiring.size(); i++) {
+    Timer timer = expiring[i];
+    if (timer.client == nullptr) {
+      continue;
+    }
+    // handled, so that RemoveClient called by a client does not count it again
+    expiring[i].client = nullptr;
+    if (timer.tick > tick) {
+      // a later turn of the wheel
+      slot.push_back(timer);
+      continue;
+    }
+    m_nTimers--;
+    timer.client->OnTimerExpired(timer.id, timer.cookie);
+  }
+  m_expiring = nullptr;
+
+  // keep the capacity of the slot
+  if (slot.empty()) {
+    expiring.clear();
+    slot.swap(expiring);
+  }
+
+  return m_nTimers > 0;
+}
+
+void
+TimingWheel::DoDispose()
+{
+  m_timer.Stop();
+  m_slots.clear();
+  m_nTimers = 0;
+
+  Object::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
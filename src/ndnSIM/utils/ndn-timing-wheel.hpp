@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_TIMING_WHEEL_HPP
+#define NDNSIM_UTILS_NDN_TIMING_WHEEL_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/periodic-timer.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Timing wheel shared by the timers of the applications of a node
+ *
+ * Scheduling a timer appends it to the slot of its expiration tick, and an expired timer costs
+ * one call, instead of the insertion and removal of a simulator event per timer.  The timers
+ * cannot be cancelled: the clients pass a cookie with each timer, e.g., the transmission count
+ * of a sequence number, and ignore the expirations whose cookie is stale.
+ *
+ * The wheel ticks with a PeriodicTimer of period Granularity, which is suspended while no timer
+ * is scheduled.  A timer expires at the first tick at or after its expiration time, i.e., up to
+ * Granularity late.  The timers further than Slots ticks away stay in their slot for the
+ * following turns of the wheel.
+ *
+ * The wheel must be used from the events of its node, like the applications are.
+ */
+class TimingWheel : public Object {
+public:
+  /**
+   * @brief Receiver of the expirations of the timers
+   */
+  class Client {
+  public:
+    virtual ~Client() = default;
+
+    /**
+     * @brief Called when a timer expires
+     * @param id the identifier of the timer, e.g., a sequence number
+     * @param cookie the cookie of the timer
+     */
+    virtual void
+    OnTimerExpired(uint32_t id, uint32_t cookie) = 0;
+  };
+
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Get the wheel of a node, aggregating one to the node at first use
+   */
+  static Ptr<TimingWheel>
+  GetWheel(Ptr<Node> node);
+
+  TimingWheel();
+
+  /**
+   * @brief Schedule a timer
+   * @param delay the time until the expiration
+   * @param client the client to notify, which must call RemoveClient before it is destroyed
+   * @param id the identifier of the timer
+   * @param cookie the cookie of the timer
+   */
+  void
+  Schedule(const Time& delay, Client* client, uint32_t id, uint32_t cookie);
+
+  /**
+   * @brief Drop all the timers of a client
+   *
+   * The call scans the whole wheel, and is meant for the stop of an application.
+   */
+  void
+  RemoveClient(Client* client);
+
+  /**
+   * @brief Get the number of scheduled timers
+   */
+  size_t
+  GetNTimers() const;
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  /// Expire the timers of the current tick, returning whether timers remain
+  bool
+  Tick();
+
+  /// The index of the last tick at or before a time
+  int64_t
+  GetTick(int64_t time) const;
+
+private:
+  struct Timer {
+    int64_t tick;
+    Client* client; ///< 0 for the removed timers
+    uint32_t id;
+    uint32_t cookie;
+  };
+
+  Time m_granularity;
+  uint32_t m_nSlots;
+
+  std::vector<std::vector<Timer>> m_slots;
+  std::vector<Timer>* m_expiring; ///< the timers of the slot of the current tick, while they expire
+  size_t m_nTimers;
+
+  PeriodicTimer m_timer;
+  int64_t m_period; ///< the granularity, in time steps
+  int64_t m_phase;  ///< time of tick 0, in time steps
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_TIMING_WHEEL_HPP
@@ -0,0 +1,165 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Copyright (c) 2011-2015  Regents of the University of California.
+#
+# This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+# contributors.
+#
+# ndnSIM is free software: you can redistribute it and/or modify it under the terms
+# of the GNU General Public License as published by the Free Software Foundation,
+# either version 3 of the License, or (at your option) any later version.
+#
+# ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+# PURPOSE.  See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with
+# ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Read the binary traces written by the ndnSIM tracers (files named *.bin).
+
+As a script, print the trace in the tab-separated text format of the tracers:
+
+    read-binary-trace.py rate-trace.bin > rate-trace.txt
+
+As a module, load the columns of a trace, as numpy arrays if numpy is available:
+
+    sys.path.append('src/ndnSIM/utils')
+    trace = __import__('read-binary-trace')
+    columns = trace.readTrace('rate-trace.bin')     # OrderedDict of the columns
+    frame = trace.readDataFrame('rate-trace.bin')   # pandas.DataFrame
+
+The string columns are decoded to lists of strings, or to pandas categories in a DataFrame.
+"""
+
+import collections
+import struct
+import sys
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+MAGIC = b'NDNTRACE'
+VERSION = 1
+HEADER = struct.Struct('<8sII')
+COLUMN_HEADER = struct.Struct('<BH')
+BLOCK_HEADER = struct.Struct('<II')
+UINT32 = struct.Struct('<I')
+
+DOUBLE, INTEGER, STRING = 0, 1, 2
+FORMATS = {DOUBLE: ('d', 8, '<f8'), INTEGER: ('q', 8, '<i8'), STRING: ('I', 4, '<u4')}
+
+
+def readExactly(f, size):
+    data = f.read(size)
+    if len(data) != size:
+        raise ValueError('Truncated trace')
+    return data
+
+
+def readHeader(f):
+    magic, version, nColumns = HEADER.unpack(readExactly(f, HEADER.size))
+    if magic != MAGIC or version != VERSION:
+        raise ValueError('Not a binary trace of version %d' % VERSION)
+    columns = []
+    for i in range(nColumns):
+        type, length = COLUMN_HEADER.unpack(readExactly(f, COLUMN_HEADER.size))
+        if type not in FORMATS:
+            raise ValueError('Unknown type %d of column %d' % (type, i))
+        columns.append((readExactly(f, length).decode('utf-8'), type))
+    return columns
+
+
+def readBlocks(f, columns, strings):
+    """Generate the values of each block, as a list per column, extending the string dictionary"""
+    while True:
+        header = f.read(BLOCK_HEADER.size)
+        if len(header) == 0:
+            return
+        if len(header) != BLOCK_HEADER.size:
+            raise ValueError('Truncated trace')
+        nRecords, nStrings = BLOCK_HEADER.unpack(header)
+        for i in range(nStrings):
+            length, = UINT32.unpack(readExactly(f, UINT32.size))
+            strings.append(readExactly(f, length).decode('utf-8'))
+
+        block = []
+        for name, type in columns:
+            code, size, dtype = FORMATS[type]
+            data = readExactly(f, nRecords * size)
+            if numpy is not None:
+                block.append(numpy.frombuffer(data, dtype=dtype))
+            else:
+                block.append(struct.unpack('<%d%s' % (nRecords, code), data))
+        yield block
+
+
+def readTrace(filename):
+    """Load a binary trace, returning an OrderedDict of the columns"""
+    with open(filename, 'rb') as f:
+        columns = readHeader(f)
+        strings = []
+        blocks = list(readBlocks(f, columns, strings))
+
+    trace = collections.OrderedDict()
+    for i, (name, type) in enumerate(columns):
+        if numpy is not None:
+            values = numpy.concatenate([block[i] for block in blocks]) if blocks else \
+                numpy.zeros(0, dtype=FORMATS[type][2])
+            if type == STRING:
+                values = numpy.array(strings, dtype=object)[values]
+        else:
+            values = [value for block in blocks for value in block[i]]
+            if type == STRING:
+                values = [strings[value] for value in values]
+        trace[name] = values
+    return trace
+
+
+def readDataFrame(filename):
+    """Load a binary trace as a pandas DataFrame, with the string columns as categories"""
+    import pandas
+
+    with open(filename, 'rb') as f:
+        columns = readHeader(f)
+        strings = []
+        blocks = list(readBlocks(f, columns, strings))
+
+    frame = collections.OrderedDict()
+    for i, (name, type) in enumerate(columns):
+        values = numpy.concatenate([block[i] for block in blocks]) if blocks else \
+            numpy.zeros(0, dtype=FORMATS[type][2])
+        if type == STRING:
+            values = pandas.Categorical.from_codes(values.astype('int64'), strings)
+        frame[name] = values
+    return pandas.DataFrame(frame)
+
+
+def printTrace(filename, out):
+    """Print a binary trace in the text format of the tracers"""
+    formats = {DOUBLE: lambda value: '%g' % value,
+               INTEGER: lambda value: '%d' % value}
+
+    with open(filename, 'rb') as f:
+        columns = readHeader(f)
+        out.write('\t'.join(name for name, type in columns) + '\n')
+        strings = []
+        for block in readBlocks(f, columns, strings):
+            fields = []
+            for (name, type), values in zip(columns, block):
+                if type == STRING:
+                    fields.append([strings[value] for value in values])
+                else:
+                    fields.append([formats[type](value) for value in values])
+            for record in zip(*fields):
+                out.write('\t'.join(record) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.stderr.write(__doc__)
+        sys.exit(1)
+    printTrace(sys.argv[1], sys.stdout)
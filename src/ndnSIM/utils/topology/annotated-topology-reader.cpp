@@ -41,8 +41,11 @@
 #include "ns3/error-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/data-rate.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "utils/topology/mapped-text-file.hpp"
+#include "utils/topology/topology-partitioner.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
@@ -51,11 +54,13 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
 
+#include <cmath>
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
-#ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
-#endif
 
 using namespace std;
 
@@ -65,10 +70,13 @@ NS_LOG_COMPONENT_DEFINE("AnnotatedTopologyReader");
 
 AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double scale /*=1.0*/)
   : m_path(path)
+  , m_scale(scale)
+  , m_nRandomPositions(0)
   , m_randX(CreateObject<UniformRandomVariable>())
   , m_randY(CreateObject<UniformRandomVariable>())
-  , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_isPartitioningEnabled(false)
+  , m_nPartitions(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -153,89 +161,112 @@ AnnotatedTopologyReader::GetLinks() const
 NodeContainer
 AnnotatedTopologyReader::Read(void)
 {
-  ifstream topgen;
-  topgen.open(GetFileName().c_str());
+  typedef MappedTextFile::Token Token;
 
-  if (!topgen.is_open() || !topgen.good()) {
+  MappedTextFile topgen(GetFileName());
+
+  if (!topgen.IsOpen()) {
     NS_FATAL_ERROR("Cannot open file " << GetFileName() << " for reading");
     return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-
-    if (line == "router")
+  Token line, token;
+  bool hasRouterSection = false;
+  while (topgen.NextLine(line)) {
+    if (MappedTextFile::NextToken(line, token) && token == "router") {
+      hasRouterSection = true;
       break;
+    }
   }
 
-  if (topgen.eof()) {
+  if (!hasRouterSection) {
     NS_FATAL_ERROR("Topology file " << GetFileName() << " does not have \"router\" section");
     return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line[0] == '#')
+  // the links refer to the nodes of the file by name, which are looked up here rather than
+  // through the path of ns3::Names
+  std::unordered_map<std::string, Ptr<Node>> nodes;
+
+  bool hasLinkSection = false;
+  while (topgen.NextLine(line)) {
+    if (line.begin != line.end && *line.begin == '#')
       continue; // comments
-    if (line == "link")
+
+    Token name;
+    if (!MappedTextFile::NextToken(line, name))
+      continue;
+    if (name == "link") {
+      hasLinkSection = true;
       break; // stop reading nodes
+    }
 
-    istringstream lineBuffer(line);
-    string name, city;
+    // as when extracting from a stream, the fields after the first malformed one are ignored
+    Token city;
     double latitude = 0, longitude = 0;
     uint32_t systemId = 0;
-
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
-      continue;
+    bool isValid = MappedTextFile::NextToken(line, city);
+    isValid = isValid && MappedTextFile::NextToken(line, token)
+              && MappedTextFile::ParseDouble(token, latitude);
+    isValid = isValid && MappedTextFile::NextToken(line, token)
+              && MappedTextFile::ParseDouble(token, longitude);
+    isValid = isValid && MappedTextFile::NextToken(line, token)
+              && MappedTextFile::ParseUint32(token, systemId);
 
     Ptr<Node> node;
 
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
+    if (std::abs(latitude) > 0.001)
+      node = CreateNode(name.str(), m_scale * longitude, -m_scale * latitude, systemId);
     else {
       Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
+      m_nRandomPositions++;
+      node = CreateNode(name.str(), var->GetValue(0, 200), var->GetValue(0, 200), systemId);
       // node = CreateNode (name, systemId);
     }
+    nodes[name.str()] = node;
   }
 
-  map<string, set<string>> processedLinks; // to eliminate duplications
-
-  if (topgen.eof()) {
+  if (!hasLinkSection) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
     return m_nodes;
   }
 
-  // SeekToSection ("link");
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line == "")
-      continue;
-    if (line[0] == '#')
-      continue; // comments
+  auto findNode = [this, &nodes] (const std::string& name) {
+    auto node = nodes.find(name);
+    return node != nodes.end() ? node->second : Names::Find<Node>(m_path, name);
+  };
 
-    // NS_LOG_DEBUG ("Input: [" << line << "]");
+  // to eliminate duplications, by the ids of the nodes
+  std::unordered_set<uint64_t> processedLinks;
 
-    istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  while (topgen.NextLine(line)) {
+    if (line.begin != line.end && *line.begin == '#')
+      continue; // comments
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+    // NS_LOG_DEBUG ("Input: [" << line.str() << "]");
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
-      continue; // duplicated link
+    Token fields[7] = {};
+    for (Token& field : fields) {
+      if (!MappedTextFile::NextToken(line, field))
+        break;
     }
-    processedLinks[from].insert(to);
+    if (fields[0].empty())
+      continue;
+
+    string from = fields[0].str(), to = fields[1].str(), capacity = fields[2].str(),
+           metric = fields[3].str(), delay = fields[4].str(), maxPackets = fields[5].str(),
+           lossRate = fields[6].str();
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
+    Ptr<Node> fromNode = findNode(from);
     NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
+    Ptr<Node> toNode = findNode(to);
     NS_ASSERT_MSG(toNode != 0, to << " node not found");
 
+    if (processedLinks.count((static_cast<uint64_t>(toNode->GetId()) << 32) | fromNode->GetId())) {
+      continue; // duplicated link
+    }
+    processedLinks.insert((static_cast<uint64_t>(fromNode->GetId()) << 32) | toNode->GetId());
+
     Link link(fromNode, from, toNode, to);
 
     link.SetAttribute("DataRate", capacity);
@@ -258,7 +289,6 @@ AnnotatedTopologyReader::Read(void)
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
 
   ApplySettings();
 
@@ -323,38 +353,110 @@ AnnotatedTopologyReader::ApplyOspfMetric()
   }
 }
 
+void
+AnnotatedTopologyReader::EnableAutomaticPartitioning(uint32_t nPartitions /* = 0*/)
+{
+  m_isPartitioningEnabled = true;
+  m_nPartitions = nPartitions;
+}
+
+void
+AnnotatedTopologyReader::PartitionNodes()
+{
+  if (!m_isPartitioningEnabled) {
+    return;
+  }
+
+  uint32_t nPartitions = m_nPartitions;
+  if (nPartitions == 0) {
+    nPartitions = MpiInterface::IsEnabled() ? MpiInterface::GetSize() : 1;
+  }
+
+  // links without delay get the one of the previous link, as with the PointToPointHelper below
+  TypeId::AttributeInformation info;
+  TypeId::LookupByName("ns3::PointToPointChannel").LookupAttributeByName("Delay", &info);
+  Time delay = DynamicCast<const TimeValue>(info.initialValue)->Get();
+
+  std::vector<uint32_t> degree(m_nodes.GetN(), 0);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  std::vector<Time> delays;
+  std::map<uint32_t, uint32_t> vertexOfNode;
+  for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+    vertexOfNode[m_nodes.Get(i)->GetId()] = i;
+  }
+
+  BOOST_FOREACH (const Link& link, m_linksList) {
+    string tmp;
+    if (link.GetAttributeFailSafe("Delay", tmp)) {
+      delay = Time(link.GetAttribute("Delay"));
+    }
+    uint32_t u = vertexOfNode[link.GetFromNode()->GetId()];
+    uint32_t v = vertexOfNode[link.GetToNode()->GetId()];
+    degree[u]++;
+    degree[v]++;
+    edges.push_back(std::make_pair(u, v));
+    delays.push_back(delay);
+  }
+
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+    partitioner.AddVertex(1 + degree[i]);
+  }
+  for (uint32_t i = 0; i < edges.size(); i++) {
+    partitioner.AddEdge(edges[i].first, edges[i].second, delays[i]);
+  }
+
+  const std::vector<uint32_t>& partitions = partitioner.Partition(nPartitions);
+  for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+    m_nodes.Get(i)->SetAttribute("SystemId", UintegerValue(partitions[i]));
+  }
+  m_requiredPartitions = nPartitions;
+
+  NS_LOG_INFO("Partitioned " << m_nodes.GetN() << " nodes in " << nPartitions << " system ids, "
+                             << partitioner.GetCutSize() << " links between them, lookahead "
+                             << partitioner.GetLookahead().As(Time::MS));
+  std::vector<double> loads = partitioner.GetLoads();
+  for (uint32_t i = 0; i < loads.size(); i++) {
+    NS_LOG_INFO("System id " << i << ": load " << loads[i]);
+  }
+}
+
 void
 AnnotatedTopologyReader::ApplySettings()
 {
-#ifdef NS3_MPI
+  PartitionNodes();
+
   if (MpiInterface::IsEnabled() && MpiInterface::GetSize() != m_requiredPartitions) {
     std::cerr << "MPI interface is enabled, but number of partitions (" << MpiInterface::GetSize()
               << ") is not equal to number of partitions in the topology (" << m_requiredPartitions
               << ")";
     exit(-1);
   }
-#endif
 
   PointToPointHelper p2p;
 
+  // the attributes of the helper are kept from a link to the next, and most links share them, so
+  // they are parsed and set, as typed values, only when they change
+  string maxPackets, dataRate, delay;
+
   BOOST_FOREACH (Link& link, m_linksList) {
     // cout << "Link: " << Findlink.GetFromNode () << ", " << link.GetToNode () << endl;
     string tmp;
 
     ////////////////////////////////////////////////
-    if (link.GetAttributeFailSafe("MaxPackets", tmp)) {
-      NS_LOG_INFO("MaxPackets = " + link.GetAttribute("MaxPackets"));
-
-      try {
-        uint32_t maxPackets = boost::lexical_cast<uint32_t>(link.GetAttribute("MaxPackets"));
+    if (link.GetAttributeFailSafe("MaxPackets", tmp) && tmp != maxPackets) {
+      NS_LOG_INFO("MaxPackets = " + tmp);
+      maxPackets = tmp;
 
+      uint32_t value;
+      MappedTextFile::Token token = {tmp.data(), tmp.data() + tmp.size()};
+      if (MappedTextFile::ParseUint32(token, value)) {
         // compatibility mode. Only DropTailQueue is supported
-        p2p.SetQueue("ns3::DropTailQueue", "MaxPackets", UintegerValue(maxPackets));
+        p2p.SetQueue("ns3::DropTailQueue", "MaxPackets", UintegerValue(value));
       }
-      catch (...) {
+      else {
         typedef boost::tokenizer<boost::escaped_list_separator<char>> tokenizer;
-        std::string value = link.GetAttribute("MaxPackets");
-        tokenizer tok(value);
+        tokenizer tok(tmp);
 
         tokenizer::iterator token = tok.begin();
         p2p.SetQueue(*token);
@@ -381,14 +483,16 @@ AnnotatedTopologyReader::ApplySettings()
       }
     }
 
-    if (link.GetAttributeFailSafe("DataRate", tmp)) {
-      NS_LOG_INFO("DataRate = " + link.GetAttribute("DataRate"));
-      p2p.SetDeviceAttribute("DataRate", StringValue(link.GetAttribute("DataRate")));
+    if (link.GetAttributeFailSafe("DataRate", tmp) && tmp != dataRate) {
+      NS_LOG_INFO("DataRate = " + tmp);
+      dataRate = tmp;
+      p2p.SetDeviceAttribute("DataRate", DataRateValue(DataRate(tmp)));
     }
 
-    if (link.GetAttributeFailSafe("Delay", tmp)) {
-      NS_LOG_INFO("Delay = " + link.GetAttribute("Delay"));
-      p2p.SetChannelAttribute("Delay", StringValue(link.GetAttribute("Delay")));
+    if (link.GetAttributeFailSafe("Delay", tmp) && tmp != delay) {
+      NS_LOG_INFO("Delay = " + tmp);
+      delay = tmp;
+      p2p.SetChannelAttribute("Delay", TimeValue(Time(tmp)));
     }
 
     NetDeviceContainer nd = p2p.Install(link.GetFromNode(), link.GetToNode());
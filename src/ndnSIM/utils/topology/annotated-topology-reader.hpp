@@ -103,6 +103,21 @@ public:
   virtual void
   ApplyOspfMetric();
 
+  /**
+   * \brief Assign the system ids of the nodes automatically, for parallel simulations
+   *
+   * The topology is partitioned by TopologyPartitioner when the links are created, balancing the
+   * number of links of each partition and keeping the links between partitions as long as
+   * possible.  The system ids from the topology file, if any, are ignored.
+   *
+   * Must be called before Read.
+   *
+   * \param nPartitions number of partitions, or 0 for the number of system ids of MpiInterface
+   *                    (1 if it is not enabled)
+   */
+  void
+  EnableAutomaticPartitioning(uint32_t nPartitions = 0);
+
   /**
    * \brief Save positions (e.g., after manual modification using visualizer)
    */
@@ -131,9 +146,17 @@ protected:
   void
   ApplySettings();
 
+  /**
+   * \brief Assign the system ids of the nodes, if automatic partitioning is enabled
+   */
+  void
+  PartitionNodes();
+
 protected:
   std::string m_path;
   NodeContainer m_nodes;
+  double m_scale;
+  uint32_t m_nRandomPositions; ///< nodes placed at random by Read, each with a new random variable
 
 private:
   AnnotatedTopologyReader(const AnnotatedTopologyReader&);
@@ -144,9 +167,10 @@ private:
   Ptr<UniformRandomVariable> m_randY;
 
   ObjectFactory m_mobilityFactory;
-  double m_scale;
 
   uint32_t m_requiredPartitions;
+  bool m_isPartitioningEnabled;
+  uint32_t m_nPartitions;
 };
 }
 
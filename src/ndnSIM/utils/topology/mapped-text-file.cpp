@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "mapped-text-file.hpp"
+
+#include "ns3/log.h"
+
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("MappedTextFile");
+
+namespace ns3 {
+
+MappedTextFile::MappedTextFile(const std::string& file)
+  : m_data(nullptr)
+  , m_size(0)
+  , m_position(nullptr)
+  , m_isOpen(false)
+{
+  int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat status;
+  if (::fstat(fd, &status) < 0) {
+    ::close(fd);
+    return;
+  }
+
+  m_size = status.st_size;
+  if (m_size > 0) {
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      return;
+    }
+    ::madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+  }
+  ::close(fd);
+
+  m_position = m_data;
+  m_isOpen = true;
+  NS_LOG_DEBUG("Mapped " << m_size << " bytes of " << file);
+}
+
+MappedTextFile::~MappedTextFile()
+{
+  if (m_data != nullptr) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+bool
+MappedTextFile::NextLine(Token& line)
+{
+  const char* end = m_data + m_size;
+  if (m_position == end) {
+    return false;
+  }
+
+  line.begin = m_position;
+  const char* newline = static_cast<const char*>(std::memchr(m_position, '\n', end - m_position));
+  if (newline == nullptr) {
+    line.end = end;
+    m_position = end;
+  }
+  else {
+    line.end = newline;
+    m_position = newline + 1;
+  }
+
+  if (line.end != line.begin && *(line.end - 1) == '\r') {
+    line.end--;
+  }
+  return true;
+}
+
+static bool
+isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool
+MappedTextFile::NextToken(Token& line, Token& token)
+{
+  const char* position = line.begin;
+  while (position != line.end && isSpace(*position)) {
+    position++;
+  }
+  if (position == line.end) {
+    line.begin = position;
+    return false;
+  }
+
+  token.begin = position;
+  while (position != line.end && !isSpace(*position)) {
+    position++;
+  }
+  token.end = position;
+  line.begin = position;
+  return true;
+}
+
+bool
+MappedTextFile::ParseDouble(const Token& token, double& value)
+{
+  // strtod needs a terminated string, and the token is not terminated in the mapped file
+  char buffer[64];
+  if (token.empty() || token.size() >= sizeof(buffer)) {
+    return false;
+  }
+  std::memcpy(buffer, token.begin, token.size());
+  buffer[token.size()] = '\0';
+
+  char* end = nullptr;
+  value = std::strtod(buffer, &end);
+  return end == buffer + token.size();
+}
+
+bool
+MappedTextFile::ParseUint32(const Token& token, uint32_t& value)
+{
+  if (token.empty()) {
+    return false;
+  }
+
+  uint64_t result = 0;
+  for (const char* c = token.begin; c != token.end; c++) {
+    if (*c < '0' || *c > '9') {
+      return false;
+    }
+    result = result * 10 + (*c - '0');
+    if (result > 0xFFFFFFFFu) {
+      return false;
+    }
+  }
+  value = static_cast<uint32_t>(result);
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MAPPED_TEXT_FILE_HPP
+#define NDNSIM_MAPPED_TEXT_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+namespace ns3 {
+
+/**
+ * \brief Read-only text file, memory-mapped and split in lines and whitespace-separated tokens
+ *
+ * The lines and tokens point into the mapped file, so that reading a large topology file copies
+ * only the fields which are kept, e.g., the names of the nodes.
+ */
+class MappedTextFile : boost::noncopyable
+{
+public:
+  /**
+   * \brief Part of the file, not terminated by '\0'
+   */
+  struct Token
+  {
+    const char* begin;
+    const char* end;
+
+    bool
+    empty() const
+    {
+      return begin == end;
+    }
+
+    size_t
+    size() const
+    {
+      return end - begin;
+    }
+
+    std::string
+    str() const
+    {
+      return std::string(begin, end);
+    }
+
+    bool
+    operator==(const char* value) const
+    {
+      return std::strlen(value) == size() && std::memcmp(begin, value, size()) == 0;
+    }
+
+    bool
+    operator!=(const char* value) const
+    {
+      return !(*this == value);
+    }
+  };
+
+  /**
+   * \brief Map a file, which is not open if it cannot be read
+   */
+  explicit
+  MappedTextFile(const std::string& file);
+
+  ~MappedTextFile();
+
+  bool
+  IsOpen() const
+  {
+    return m_isOpen;
+  }
+
+  /**
+   * \brief Get the whole content of the file, e.g., to hash it or to read binary data
+   */
+  Token
+  GetContents() const
+  {
+    return Token{m_data, m_data + m_size};
+  }
+
+  /**
+   * \brief Get the next line, without its end of line ("\n" or "\r\n")
+   * \return false at the end of the file
+   */
+  bool
+  NextLine(Token& line);
+
+  /**
+   * \brief Remove the first whitespace-separated token of a line
+   * \return false if the line has no more tokens
+   */
+  static bool
+  NextToken(Token& line, Token& token);
+
+  /**
+   * \brief Parse a token as a floating-point number
+   * \return false if the token is not entirely a number
+   */
+  static bool
+  ParseDouble(const Token& token, double& value);
+
+  /**
+   * \brief Parse a token as a decimal unsigned integer
+   * \return false if the token is not entirely a number which fits in 32 bits
+   */
+  static bool
+  ParseUint32(const Token& token, uint32_t& value);
+
+private:
+  const char* m_data;
+  size_t m_size;
+  const char* m_position;
+  bool m_isOpen;
+};
+
+} // namespace ns3
+
+#endif // NDNSIM_MAPPED_TEXT_FILE_HPP
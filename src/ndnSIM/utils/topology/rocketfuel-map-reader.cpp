@@ -43,6 +43,8 @@
 
 #include "ns3/mobility-model.h"
 
+#include "mapped-text-file.hpp"
+
 #include <regex.h>
 
 #include <boost/foreach.hpp>
@@ -52,6 +54,7 @@
 #include <boost/graph/connected_components.hpp>
 
 #include <iomanip>
+#include <unordered_map>
 
 using namespace std;
 using namespace boost;
@@ -93,25 +96,31 @@ RocketfuelMapReader::Read()
         "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE     \
         "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
 
+RocketfuelMapReader::LinkRange::LinkRange(const string& minBw, const string& maxBw,
+                                          const string& minDelay, const string& maxDelay)
+  : minBandwidth(lexical_cast<DataRate>(minBw))
+  , maxBandwidth(lexical_cast<DataRate>(maxBw))
+  , minDelay(lexical_cast<Time>(minDelay))
+  , maxDelay(lexical_cast<Time>(maxDelay))
+{
+}
+
 void
-RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double averageRtt,
-                                const string& minBw, const string& maxBw, const string& minDelay,
-                                const string& maxDelay)
+RocketfuelMapReader::CreateLink(Ptr<Node> node1, const string& nodeName1, Ptr<Node> node2,
+                                const string& nodeName2, double averageRtt, const LinkRange& range)
 {
-  Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
   Link link(node1, nodeName1, node2, nodeName2);
 
   DataRate randBandwidth(
-    m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
-                          static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate())));
+    m_randVar->GetInteger(static_cast<uint32_t>(range.minBandwidth.GetBitRate()),
+                          static_cast<uint32_t>(range.maxBandwidth.GetBitRate())));
 
   int32_t metric = std::max(1, static_cast<int32_t>(1.0 * m_referenceOspfRate.GetBitRate()
                                                     / randBandwidth.GetBitRate()));
 
   Time randDelay =
-    Time::FromDouble((m_randVar->GetValue(lexical_cast<Time>(minDelay).ToDouble(Time::US),
-                                          lexical_cast<Time>(maxDelay).ToDouble(Time::US))),
+    Time::FromDouble((m_randVar->GetValue(range.minDelay.ToDouble(Time::US),
+                                          range.maxDelay.ToDouble(Time::US))),
                      Time::US);
 
   uint32_t queue = ceil(averageRtt * (randBandwidth.GetBitRate() / 8.0 / 1100.0));
@@ -270,51 +279,41 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
 {
   m_maxNodeId = 0;
 
-  ifstream topgen;
-  topgen.open(GetFileName().c_str());
-  // NodeContainer nodes;
+  MappedTextFile topgen(GetFileName());
 
-  istringstream lineBuffer;
   string line;
-  int lineNumber = 0;
   char errbuf[512];
 
-  if (!topgen.is_open()) {
+  if (!topgen.IsOpen()) {
     NS_LOG_WARN("Couldn't open the file " << GetFileName());
     return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    int ret;
-    int argc;
-    char* argv[REGMATCH_MAX];
-    char* buf;
+  regmatch_t regmatch[REGMATCH_MAX];
+  regex_t regex;
 
-    lineNumber++;
-    line.clear();
-    lineBuffer.clear();
-
-    getline(topgen, line);
-    buf = (char*)line.c_str();
+  int ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0) {
+    regerror(ret, &regex, errbuf, sizeof(errbuf));
+    regfree(&regex);
+    NS_LOG_ERROR("Cannot compile the expression of the lines: " << errbuf);
+    return m_nodes;
+  }
 
-    regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
+  MappedTextFile::Token token;
+  while (topgen.NextLine(token)) {
+    int argc;
+    char* argv[REGMATCH_MAX];
 
-    ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0) {
-      regerror(ret, &regex, errbuf, sizeof(errbuf));
-      regfree(&regex);
-      continue;
-    }
+    // regexec needs a terminated line
+    line.assign(token.begin, token.end);
 
-    ret = regexec(&regex, buf, REGMATCH_MAX, regmatch, 0);
+    ret = regexec(&regex, line.c_str(), REGMATCH_MAX, regmatch, 0);
     if (ret == REG_NOMATCH) {
-      NS_LOG_WARN("match failed (maps file): %s" << buf);
-      regfree(&regex);
+      NS_LOG_WARN("match failed (maps file): %s" << line);
       continue;
     }
 
-    line = buf;
     argc = 0;
 
     /* regmatch[0] is the entire strings that matched */
@@ -330,8 +329,8 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     }
 
     GenerateFromMapsFile(argc, argv);
-    regfree(&regex);
   }
+  regfree(&regex);
 
   if (keepOneComponent) {
     NS_LOG_DEBUG("Before eliminating disconnected nodes: " << num_vertices(m_graph));
@@ -396,33 +395,53 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
   }
 
+  // the nodes are created with their final names, and kept by vertex for the links
+  std::unordered_map<Traits::vertex_descriptor, Ptr<Node>> nodes;
   for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
     string nodeName = get(vertex_name, m_graph, *v);
-    Ptr<Node> node = CreateNode(nodeName, 0);
 
     node_type_t type = get(vertex_rank, m_graph, *v);
     switch (type) {
     case BACKBONE:
-      Names::Rename(nodeName, "bb-" + nodeName);
-      put(vertex_name, m_graph, *v, "bb-" + nodeName);
+      nodeName = "bb-" + nodeName;
+      break;
+    case CLIENT:
+      nodeName = "leaf-" + nodeName;
+      break;
+    case GATEWAY:
+      nodeName = "gw-" + nodeName;
+      break;
+    case UNKNOWN:
+      NS_FATAL_ERROR("Should not happen");
+      break;
+    }
+
+    Ptr<Node> node = CreateNode(nodeName, 0);
+    put(vertex_name, m_graph, *v, nodeName);
+    nodes[*v] = node;
+
+    switch (type) {
+    case BACKBONE:
       m_backboneRouters.Add(node);
       break;
     case CLIENT:
-      Names::Rename(nodeName, "leaf-" + nodeName);
-      put(vertex_name, m_graph, *v, "leaf-" + nodeName);
       m_customerRouters.Add(node);
       break;
     case GATEWAY:
-      Names::Rename(nodeName, "gw-" + nodeName);
-      put(vertex_name, m_graph, *v, "gw-" + nodeName);
       m_gatewayRouters.Add(node);
       break;
     case UNKNOWN:
-      NS_FATAL_ERROR("Should not happen");
       break;
     }
   }
 
+  const LinkRange b2b(params.minb2bBandwidth, params.maxb2bBandwidth, params.minb2bDelay,
+                      params.maxb2bDelay);
+  const LinkRange b2g(params.minb2gBandwidth, params.maxb2gBandwidth, params.minb2gDelay,
+                      params.maxb2gDelay);
+  const LinkRange g2c(params.ming2cBandwidth, params.maxg2cBandwidth, params.ming2cDelay,
+                      params.maxg2cDelay);
+
   for (tie(e, ende) = edges(m_graph); e != ende; e++) {
     Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
 
@@ -431,21 +450,17 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     string u_name = get(vertex_name, m_graph, u), v_name = get(vertex_name, m_graph, v);
 
     if (u_type == BACKBONE && v_type == BACKBONE) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth, params.maxb2bBandwidth,
-                 params.minb2bDelay, params.maxb2bDelay);
+      CreateLink(nodes[u], u_name, nodes[v], v_name, params.averageRtt, b2b);
     }
     else if ((u_type == GATEWAY && v_type == BACKBONE)
              || (u_type == BACKBONE && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
+      CreateLink(nodes[u], u_name, nodes[v], v_name, params.averageRtt, b2g);
     }
     else if (u_type == GATEWAY && v_type == GATEWAY) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
+      CreateLink(nodes[u], u_name, nodes[v], v_name, params.averageRtt, b2g);
     }
     else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth, params.maxg2cBandwidth,
-                 params.ming2cDelay, params.maxg2cDelay);
+      CreateLink(nodes[u], u_name, nodes[v], v_name, params.averageRtt, g2c);
     }
     else {
       NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
@@ -26,6 +26,7 @@
 
 #include "ns3/net-device-container.h"
 #include "ns3/data-rate.h"
+#include "ns3/nstime.h"
 
 #include <set>
 #include <boost/graph/adjacency_list.hpp>
@@ -133,9 +134,22 @@ private:
   void
   GenerateFromMapsFile(int argc, char* argv[]);
 
+  /**
+   * \brief Ranges of the bandwidth and delay of a type of links, parsed once per Read
+   */
+  struct LinkRange {
+    LinkRange(const string& minBw, const string& maxBw, const string& minDelay,
+              const string& maxDelay);
+
+    DataRate minBandwidth;
+    DataRate maxBandwidth;
+    Time minDelay;
+    Time maxDelay;
+  };
+
   void
-  CreateLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
-             const string& maxBw, const string& minDelay, const string& maxDelay);
+  CreateLink(Ptr<Node> node1, const string& nodeName1, Ptr<Node> node2, const string& nodeName2,
+             double averageRtt, const LinkRange& range);
   void
   KeepOnlyBiggestConnectedComponent();
 
@@ -0,0 +1,437 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "snapshot-topology-reader.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/names.h"
+#include "ns3/mobility-model.h"
+#include "ns3/random-variable-stream.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "utils/topology/mapped-text-file.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("SnapshotTopologyReader");
+
+namespace ns3 {
+
+namespace {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'T', 'O', 'P', 'O', '\0'};
+const uint32_t VERSION = 1;
+
+/// FNV-1a
+uint64_t
+hashBytes(uint64_t hash, const char* begin, const char* end)
+{
+  for (const char* byte = begin; byte != end; byte++) {
+    hash ^= static_cast<uint8_t>(*byte);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/// Write an unsigned integer, in little-endian order
+template<typename T>
+void
+writeNumber(std::ostream& os, T value)
+{
+  for (size_t i = 0; i < sizeof(T); i++) {
+    os.put(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+
+void
+writeDouble(std::ostream& os, double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeNumber<uint64_t>(os, bits);
+}
+
+void
+writeString(std::ostream& os, const std::string& value)
+{
+  writeNumber<uint32_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+/// Reader of the fields of the mapped snapshot
+class SnapshotCursor
+{
+public:
+  SnapshotCursor(const std::string& file, const char* position, const char* end)
+    : m_file(file)
+    , m_position(position)
+    , m_end(end)
+  {
+  }
+
+  const char*
+  GetPosition() const
+  {
+    return m_position;
+  }
+
+  const char*
+  ReadBytes(size_t size)
+  {
+    if (static_cast<size_t>(m_end - m_position) < size) {
+      NS_FATAL_ERROR("Truncated snapshot " << m_file);
+    }
+    const char* bytes = m_position;
+    m_position += size;
+    return bytes;
+  }
+
+  template<typename T>
+  T
+  ReadNumber()
+  {
+    const char* bytes = ReadBytes(sizeof(T));
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+      value |= static_cast<T>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    }
+    return value;
+  }
+
+  double
+  ReadDouble()
+  {
+    uint64_t bits = ReadNumber<uint64_t>();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string
+  ReadString()
+  {
+    uint32_t size = ReadNumber<uint32_t>();
+    const char* bytes = ReadBytes(size);
+    return std::string(bytes, size);
+  }
+
+private:
+  const std::string& m_file;
+  const char* m_position;
+  const char* m_end;
+};
+
+struct Route
+{
+  uint32_t prefix;   ///< index in the prefixes of the snapshot
+  uint32_t endpoint; ///< 2 * index of the link, + 1 for the end of the link
+  uint32_t cost;
+};
+
+} // namespace
+
+SnapshotTopologyReader::SnapshotTopologyReader(const std::string& path, double scale /*=1.0*/)
+  : AnnotatedTopologyReader(path, scale)
+  , m_isSnapshotRead(false)
+  , m_prefixes(nullptr)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+SnapshotTopologyReader::~SnapshotTopologyReader()
+{
+  NS_LOG_FUNCTION(this);
+}
+
+void
+SnapshotTopologyReader::SetSnapshotFileName(const std::string& file)
+{
+  m_snapshotFile = file;
+}
+
+NodeContainer
+SnapshotTopologyReader::Read()
+{
+  if (m_snapshotFile.empty() || !ReadSnapshot()) {
+    return AnnotatedTopologyReader::Read();
+  }
+
+  m_isSnapshotRead = true;
+  NS_LOG_INFO("Topology created from " << m_snapshotFile << " with " << m_nodes.GetN()
+                                       << " nodes and " << LinksSize() << " links");
+
+  ApplySettings();
+
+  return m_nodes;
+}
+
+bool
+SnapshotTopologyReader::HashTopologyFile(uint64_t& hash) const
+{
+  MappedTextFile topology(GetFileName());
+  if (!topology.IsOpen()) {
+    return false;
+  }
+
+  MappedTextFile::Token contents = topology.GetContents();
+  hash = hashBytes(0xcbf29ce484222325ULL, contents.begin, contents.end);
+  hash = hashBytes(hash, reinterpret_cast<const char*>(&m_scale),
+                   reinterpret_cast<const char*>(&m_scale + 1));
+  return true;
+}
+
+bool
+SnapshotTopologyReader::ReadSnapshot()
+{
+  uint64_t hash = 0;
+  if (!HashTopologyFile(hash)) {
+    NS_LOG_WARN("Cannot read the topology file " << GetFileName() << " to check the snapshot");
+    return false;
+  }
+
+  m_snapshot.reset(new MappedTextFile(m_snapshotFile));
+  MappedTextFile::Token contents = m_snapshot->GetContents();
+  SnapshotCursor cursor(m_snapshotFile, contents.begin, contents.end);
+
+  const size_t headerSize = sizeof(MAGIC) + sizeof(uint32_t) + sizeof(uint64_t);
+  if (!m_snapshot->IsOpen() || contents.size() < headerSize
+      || std::memcmp(cursor.ReadBytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0
+      || cursor.ReadNumber<uint32_t>() != VERSION || cursor.ReadNumber<uint64_t>() != hash) {
+    NS_LOG_INFO("No valid snapshot " << m_snapshotFile << " of " << GetFileName());
+    m_snapshot.reset();
+    return false;
+  }
+
+  std::vector<std::string> names(cursor.ReadNumber<uint32_t>());
+  std::vector<Ptr<Node>> nodes;
+  for (std::string& name : names) {
+    name = cursor.ReadString();
+    double posX = cursor.ReadDouble();
+    double posY = cursor.ReadDouble();
+    uint32_t systemId = cursor.ReadNumber<uint32_t>();
+    nodes.push_back(CreateNode(name, posX, posY, systemId));
+  }
+
+  // as many random variables as Read created, so that the streams of the random variables created
+  // later by the scenario are the same as in the run which read the topology file
+  m_nRandomPositions = cursor.ReadNumber<uint32_t>();
+  for (uint32_t i = 0; i < m_nRandomPositions; i++) {
+    CreateObject<UniformRandomVariable>();
+  }
+
+  uint32_t nLinks = cursor.ReadNumber<uint32_t>();
+  for (uint32_t i = 0; i < nLinks; i++) {
+    uint32_t from = cursor.ReadNumber<uint32_t>();
+    uint32_t to = cursor.ReadNumber<uint32_t>();
+    if (from >= names.size() || to >= names.size()) {
+      NS_FATAL_ERROR("Invalid link " << from << " <==> " << to << " in snapshot "
+                                     << m_snapshotFile);
+    }
+
+    Link link(nodes[from], names[from], nodes[to], names[to]);
+    uint32_t nAttributes = cursor.ReadNumber<uint32_t>();
+    for (uint32_t j = 0; j < nAttributes; j++) {
+      std::string key = cursor.ReadString();
+      link.SetAttribute(key, cursor.ReadString());
+    }
+    AddLink(link);
+  }
+
+  // the routes are read by InstallRoutes, once the faces exist
+  m_prefixes = cursor.GetPosition();
+  return true;
+}
+
+void
+SnapshotTopologyReader::InstallRoutes()
+{
+  NS_ASSERT_MSG(m_snapshot != nullptr, "The topology has not been read from a snapshot");
+
+  MappedTextFile::Token contents = m_snapshot->GetContents();
+  SnapshotCursor cursor(m_snapshotFile, m_prefixes, contents.end);
+
+  std::vector<ndn::Name> prefixes(cursor.ReadNumber<uint32_t>());
+  for (ndn::Name& prefix : prefixes) {
+    uint32_t size = cursor.ReadNumber<uint32_t>();
+    prefix.wireDecode(ndn::Block(reinterpret_cast<const uint8_t*>(cursor.ReadBytes(size)), size));
+  }
+
+  // the faces of the ends of the links, in the order of the endpoints of the routes
+  std::vector<std::shared_ptr<ndn::Face>> faces;
+  for (const Link& link : m_linksList) {
+    for (Ptr<NetDevice> device : {link.GetFromNetDevice(), link.GetToNetDevice()}) {
+      Ptr<ndn::L3Protocol> ndn = device->GetNode()->GetObject<ndn::L3Protocol>();
+      NS_ASSERT_MSG(ndn != 0, "NDN stack is not installed on the nodes");
+      faces.push_back(ndn->getFaceByNetDevice(device));
+    }
+  }
+
+  uint32_t nRoutes = 0;
+  for (uint32_t node = 0; node < m_nodes.GetN(); node++) {
+    uint32_t nNodeRoutes = cursor.ReadNumber<uint32_t>();
+    for (uint32_t i = 0; i < nNodeRoutes; i++) {
+      uint32_t prefix = cursor.ReadNumber<uint32_t>();
+      uint32_t endpoint = cursor.ReadNumber<uint32_t>();
+      uint32_t cost = cursor.ReadNumber<uint32_t>();
+      if (prefix >= prefixes.size() || endpoint >= faces.size()) {
+        NS_FATAL_ERROR("Invalid route in snapshot " << m_snapshotFile);
+      }
+
+      ndn::FibHelper::AddRoute(m_nodes.Get(node), prefixes[prefix], faces[endpoint], cost);
+    }
+    nRoutes += nNodeRoutes;
+  }
+
+  NS_LOG_INFO("Installed " << nRoutes << " routes to " << prefixes.size() << " prefixes from "
+                           << m_snapshotFile);
+  m_snapshot.reset();
+  m_prefixes = nullptr;
+}
+
+void
+SnapshotTopologyReader::SaveSnapshot()
+{
+  NS_ASSERT_MSG(!m_snapshotFile.empty(), "The snapshot file is not set");
+
+  uint64_t hash = 0;
+  if (!HashTopologyFile(hash)) {
+    NS_FATAL_ERROR("Cannot read the topology file " << GetFileName());
+  }
+
+  std::unordered_map<uint32_t, uint32_t> indexOfNode;
+  for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+    indexOfNode[m_nodes.Get(i)->GetId()] = i;
+  }
+
+  // the endpoint of each face toward a link, per node
+  std::vector<std::unordered_map<nfd::FaceId, uint32_t>> endpoints(m_nodes.GetN());
+  uint32_t endpoint = 0;
+  for (const Link& link : m_linksList) {
+    for (Ptr<NetDevice> device : {link.GetFromNetDevice(), link.GetToNetDevice()}) {
+      Ptr<ndn::L3Protocol> ndn = device->GetNode()->GetObject<ndn::L3Protocol>();
+      if (ndn != 0) {
+        std::shared_ptr<ndn::Face> face = ndn->getFaceByNetDevice(device);
+        if (face != nullptr) {
+          endpoints[indexOfNode[device->GetNode()->GetId()]][face->getId()] = endpoint;
+        }
+      }
+      endpoint++;
+    }
+  }
+
+  // the next hops toward the links, without those of the applications and of the management
+  std::map<ndn::Name, uint32_t> prefixes;
+  std::vector<std::vector<Route>> routes(m_nodes.GetN());
+  for (uint32_t node = 0; node < m_nodes.GetN(); node++) {
+    Ptr<ndn::L3Protocol> ndn = m_nodes.Get(node)->GetObject<ndn::L3Protocol>();
+    if (ndn == 0) {
+      continue;
+    }
+
+    for (const nfd::fib::Entry& entry : ndn->getForwarder()->getFib()) {
+      for (const nfd::fib::NextHop& nextHop : entry.getNextHops()) {
+        auto face = endpoints[node].find(nextHop.getFace().getId());
+        if (face == endpoints[node].end()) {
+          continue;
+        }
+
+        auto prefix = prefixes.insert(std::make_pair(entry.getPrefix(), prefixes.size())).first;
+        routes[node].push_back(
+          Route{prefix->second, face->second, static_cast<uint32_t>(nextHop.getCost())});
+      }
+    }
+  }
+
+  std::ofstream os(m_snapshotFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!os) {
+    NS_FATAL_ERROR("Cannot open " << m_snapshotFile);
+  }
+  os.write(MAGIC, sizeof(MAGIC));
+  writeNumber<uint32_t>(os, VERSION);
+  writeNumber<uint64_t>(os, hash);
+
+  writeNumber<uint32_t>(os, m_nodes.GetN());
+  for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+    Ptr<Node> node = m_nodes.Get(i);
+    Vector position;
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    if (mobility != 0) {
+      position = mobility->GetPosition();
+    }
+
+    writeString(os, Names::FindName(node));
+    writeDouble(os, position.x);
+    writeDouble(os, position.y);
+    writeNumber<uint32_t>(os, node->GetSystemId());
+  }
+  writeNumber<uint32_t>(os, m_nRandomPositions);
+
+  writeNumber<uint32_t>(os, m_linksList.size());
+  for (const Link& link : m_linksList) {
+    writeNumber<uint32_t>(os, indexOfNode[link.GetFromNode()->GetId()]);
+    writeNumber<uint32_t>(os, indexOfNode[link.GetToNode()->GetId()]);
+
+    std::vector<std::pair<std::string, std::string>> attributes(link.AttributesBegin(),
+                                                                link.AttributesEnd());
+    writeNumber<uint32_t>(os, attributes.size());
+    for (const auto& attribute : attributes) {
+      writeString(os, attribute.first);
+      writeString(os, attribute.second);
+    }
+  }
+
+  std::vector<ndn::Block> wires(prefixes.size());
+  for (const auto& prefix : prefixes) {
+    wires[prefix.second] = prefix.first.wireEncode();
+  }
+  writeNumber<uint32_t>(os, wires.size());
+  for (const ndn::Block& wire : wires) {
+    writeNumber<uint32_t>(os, wire.size());
+    os.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+  }
+
+  uint32_t nRoutes = 0;
+  for (const std::vector<Route>& nodeRoutes : routes) {
+    writeNumber<uint32_t>(os, nodeRoutes.size());
+    for (const Route& route : nodeRoutes) {
+      writeNumber<uint32_t>(os, route.prefix);
+      writeNumber<uint32_t>(os, route.endpoint);
+      writeNumber<uint32_t>(os, route.cost);
+    }
+    nRoutes += nodeRoutes.size();
+  }
+
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write " << m_snapshotFile);
+  }
+  NS_LOG_INFO("Saved " << m_nodes.GetN() << " nodes, " << m_linksList.size() << " links and "
+                       << nRoutes << " routes to " << m_snapshotFile);
+}
+
+} // namespace ns3
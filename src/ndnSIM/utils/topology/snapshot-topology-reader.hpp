@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_SNAPSHOT_TOPOLOGY_READER_HPP
+#define NDNSIM_SNAPSHOT_TOPOLOGY_READER_HPP
+
+#include "annotated-topology-reader.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ns3 {
+
+class MappedTextFile;
+
+/**
+ * \brief Annotated topology reader which keeps the topology and the computed routes in a binary
+ *        snapshot, to start the later runs of a scenario without parsing the topology file and
+ *        computing the routes again
+ *
+ * The snapshot contains the nodes, their positions, the links and their attributes, and for each
+ * node the FIB next hops toward the links, with their costs.  It records a hash of the topology
+ * file and of the scale, and is read instead of the topology file only while they are unchanged:
+ *
+ * \code
+ *   SnapshotTopologyReader topologyReader("", 25);
+ *   topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-grid-3x3.txt");
+ *   topologyReader.SetSnapshotFileName("topo-grid-3x3.snapshot");
+ *   topologyReader.Read();
+ *
+ *   ndn::StackHelper ndnHelper;
+ *   ndnHelper.InstallAll();
+ *
+ *   if (topologyReader.IsSnapshotRead()) {
+ *     topologyReader.InstallRoutes();
+ *   }
+ *   else {
+ *     ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+ *     ndnGlobalRoutingHelper.InstallAll();
+ *     ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("Node8"));
+ *     ndn::GlobalRoutingHelper::CalculateRoutes();
+ *     topologyReader.SaveSnapshot();
+ *   }
+ * \endcode
+ *
+ * The hash does not cover what the scenario does with the topology, e.g., the origins of the
+ * prefixes, so a scenario which routes differently must use another snapshot file.  The routes
+ * of the snapshot are installed with ndn::FibHelper, after the NDN stack.
+ */
+class SnapshotTopologyReader : public AnnotatedTopologyReader {
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param path ns3::Names path
+   * \param scale Scaling factor for coordinates in input file
+   */
+  SnapshotTopologyReader(const std::string& path = "", double scale = 1.0);
+  virtual ~SnapshotTopologyReader();
+
+  /**
+   * \brief Set the file of the snapshot, read if it matches the topology file, and written by
+   *        SaveSnapshot
+   */
+  void
+  SetSnapshotFileName(const std::string& file);
+
+  /**
+   * \brief Read the topology from the snapshot if it is valid, otherwise from the topology file
+   *
+   * \return the container of the nodes created (or empty container if there was an error)
+   */
+  virtual NodeContainer
+  Read();
+
+  /**
+   * \brief Check whether Read created the topology from the snapshot, whose routes are then
+   *        installed by InstallRoutes
+   */
+  bool
+  IsSnapshotRead() const
+  {
+    return m_isSnapshotRead;
+  }
+
+  /**
+   * \brief Add the routes of the snapshot to the FIB of the nodes
+   *
+   * The NDN stack must be installed on the nodes.
+   */
+  void
+  InstallRoutes();
+
+  /**
+   * \brief Save the topology and the FIB next hops toward the links, e.g., after
+   *        ndn::GlobalRoutingHelper::CalculateRoutes
+   */
+  void
+  SaveSnapshot();
+
+private:
+  bool
+  ReadSnapshot();
+
+  /**
+   * \brief Hash the topology file and the scale
+   * \return false if the topology file cannot be read
+   */
+  bool
+  HashTopologyFile(uint64_t& hash) const;
+
+private:
+  std::string m_snapshotFile;
+  bool m_isSnapshotRead;
+
+  std::unique_ptr<MappedTextFile> m_snapshot; ///< mapped while its routes are not installed
+  const char* m_prefixes;                     ///< start of the prefixes in the mapped snapshot
+};
+
+} // namespace ns3
+
+#endif // NDNSIM_SNAPSHOT_TOPOLOGY_READER_HPP
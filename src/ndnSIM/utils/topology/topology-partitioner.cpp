@@ -0,0 +1,577 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+static const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+TopologyPartitioner::TopologyPartitioner()
+  : m_tolerance(0.05)
+  , m_nPartitions(1)
+  , m_maxLoad(0)
+  , m_clusterLoad(0)
+  , m_random(1)
+{
+}
+
+uint32_t
+TopologyPartitioner::AddVertex(double load /* = 1.0*/)
+{
+  m_loads.push_back(load);
+  return m_loads.size() - 1;
+}
+
+void
+TopologyPartitioner::AddEdge(uint32_t u, uint32_t v, const Time& delay, double weight /* = 1.0*/)
+{
+  NS_ASSERT(u < m_loads.size() && v < m_loads.size());
+  m_edges.push_back(Edge{u, v, delay.GetTimeStep(), weight});
+}
+
+void
+TopologyPartitioner::SetImbalanceTolerance(double tolerance)
+{
+  m_tolerance = tolerance;
+}
+
+const std::vector<uint32_t>&
+TopologyPartitioner::Partition(uint32_t nPartitions)
+{
+  uint32_t n = m_loads.size();
+  m_nPartitions = std::max(nPartitions, 1u);
+  m_partitions.assign(n, 0);
+  m_random = 2463534242u;
+
+  if (m_nPartitions == 1 || n == 0) {
+    return m_partitions;
+  }
+
+  double total = std::accumulate(m_loads.begin(), m_loads.end(), 0.0);
+  m_maxLoad = (1 + m_tolerance) * total / m_nPartitions;
+  m_clusterLoad = std::max(total / (4 * m_nPartitions),
+                           *std::max_element(m_loads.begin(), m_loads.end()));
+
+  std::vector<uint32_t> cluster;
+  uint32_t nClusters = ContractShortEdges(cluster);
+
+  std::vector<Graph> levels;
+  std::vector<std::vector<uint32_t>> maps;
+  levels.push_back(Contract(BuildGraph(), cluster, nClusters));
+
+  const uint32_t coarsest = std::max(100u, 20 * m_nPartitions);
+  while (levels.back().size() > coarsest) {
+    std::vector<uint32_t> map;
+    Graph coarse = Coarsen(levels.back(), map);
+    if (coarse.size() > 0.9 * levels.back().size()) {
+      break;
+    }
+    levels.push_back(std::move(coarse));
+    maps.push_back(std::move(map));
+  }
+  NS_LOG_DEBUG(n << " vertices, " << nClusters << " clusters, " << levels.back().size()
+                 << " vertices after " << maps.size() << " coarsening levels");
+
+  std::vector<uint32_t> part = InitialPartition(levels.back());
+  for (size_t level = maps.size(); level-- > 0;) {
+    std::vector<uint32_t> finePart(levels[level].size());
+    for (uint32_t v = 0; v < finePart.size(); v++) {
+      finePart[v] = part[maps[level][v]];
+    }
+    part.swap(finePart);
+    Refine(levels[level], part);
+  }
+
+  for (uint32_t v = 0; v < n; v++) {
+    m_partitions[v] = part[cluster[v]];
+  }
+
+  NS_LOG_DEBUG("Cut " << GetCutSize() << " of " << m_edges.size() << " edges, lookahead "
+                      << GetLookahead().As(Time::MS));
+  return m_partitions;
+}
+
+const std::vector<uint32_t>&
+TopologyPartitioner::GetPartitions() const
+{
+  return m_partitions;
+}
+
+Time
+TopologyPartitioner::GetLookahead() const
+{
+  int64_t lookahead = std::numeric_limits<int64_t>::max();
+  for (const Edge& edge : m_edges) {
+    if (m_partitions[edge.u] != m_partitions[edge.v]) {
+      lookahead = std::min(lookahead, edge.delay);
+    }
+  }
+  return lookahead == std::numeric_limits<int64_t>::max() ? Time::Max() : TimeStep(lookahead);
+}
+
+std::vector<double>
+TopologyPartitioner::GetLoads() const
+{
+  std::vector<double> loads(m_nPartitions, 0.0);
+  for (uint32_t v = 0; v < m_partitions.size(); v++) {
+    loads[m_partitions[v]] += m_loads[v];
+  }
+  return loads;
+}
+
+uint32_t
+TopologyPartitioner::GetCutSize() const
+{
+  uint32_t cut = 0;
+  for (const Edge& edge : m_edges) {
+    if (m_partitions[edge.u] != m_partitions[edge.v]) {
+      cut++;
+    }
+  }
+  return cut;
+}
+
+uint32_t
+TopologyPartitioner::ContractShortEdges(std::vector<uint32_t>& cluster) const
+{
+  uint32_t n = m_loads.size();
+
+  std::vector<uint32_t> order(m_edges.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    return m_edges[a].delay < m_edges[b].delay;
+  });
+
+  std::vector<uint32_t> parent(n);
+  std::vector<double> load;
+  auto find = [&parent](uint32_t v) {
+    while (parent[v] != v) {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+    return v;
+  };
+  auto merge = [&](const Edge& edge) {
+    uint32_t u = find(edge.u);
+    uint32_t v = find(edge.v);
+    if (u != v) {
+      parent[v] = u;
+      load[u] += load[v];
+    }
+    return load[u];
+  };
+
+  // Find the edges shorter than the largest threshold for which the clusters remain small enough,
+  // the edges of the same delay being either all contracted or none
+  std::iota(parent.begin(), parent.end(), 0);
+  load = m_loads;
+  size_t nContracted = 0;
+  for (size_t i = 0; i < order.size();) {
+    bool isFeasible = true;
+    size_t j = i;
+    for (; j < order.size() && m_edges[order[j]].delay == m_edges[order[i]].delay; j++) {
+      isFeasible = merge(m_edges[order[j]]) <= m_clusterLoad && isFeasible;
+    }
+    if (!isFeasible) {
+      break;
+    }
+    nContracted = j;
+    i = j;
+  }
+
+  std::iota(parent.begin(), parent.end(), 0);
+  load = m_loads;
+  for (size_t i = 0; i < nContracted; i++) {
+    merge(m_edges[order[i]]);
+  }
+
+  if (nContracted < order.size()) {
+    NS_LOG_DEBUG("Contracted " << nContracted << " edges shorter than "
+                               << TimeStep(m_edges[order[nContracted]].delay).As(Time::MS));
+  }
+  else {
+    NS_LOG_DEBUG("Contracted all the edges");
+  }
+
+  std::vector<uint32_t> clusterOfRoot(n, NONE);
+  uint32_t nClusters = 0;
+  cluster.resize(n);
+  for (uint32_t v = 0; v < n; v++) {
+    uint32_t root = find(v);
+    if (clusterOfRoot[root] == NONE) {
+      clusterOfRoot[root] = nClusters++;
+    }
+    cluster[v] = clusterOfRoot[root];
+  }
+  return nClusters;
+}
+
+TopologyPartitioner::Graph
+TopologyPartitioner::BuildGraph() const
+{
+  uint32_t n = m_loads.size();
+
+  int64_t maxDelay = 1;
+  for (const Edge& edge : m_edges) {
+    maxDelay = std::max(maxDelay, edge.delay);
+  }
+
+  Graph graph;
+  graph.load = m_loads;
+  graph.xadj.assign(n + 1, 0);
+  for (const Edge& edge : m_edges) {
+    if (edge.u != edge.v) {
+      graph.xadj[edge.u + 1]++;
+      graph.xadj[edge.v + 1]++;
+    }
+  }
+  std::partial_sum(graph.xadj.begin(), graph.xadj.end(), graph.xadj.begin());
+
+  // parallel edges are merged by Contract
+  std::vector<uint32_t> position(graph.xadj.begin(), graph.xadj.end() - 1);
+  graph.adj.resize(graph.xadj.back());
+  graph.cost.resize(graph.xadj.back());
+  for (const Edge& edge : m_edges) {
+    if (edge.u != edge.v) {
+      double cost = edge.weight * maxDelay / std::max<int64_t>(edge.delay, 1);
+      graph.adj[position[edge.u]] = edge.v;
+      graph.cost[position[edge.u]++] = cost;
+      graph.adj[position[edge.v]] = edge.u;
+      graph.cost[position[edge.v]++] = cost;
+    }
+  }
+  return graph;
+}
+
+TopologyPartitioner::Graph
+TopologyPartitioner::Contract(const Graph& graph, const std::vector<uint32_t>& map,
+                              uint32_t nGroups)
+{
+  uint32_t n = graph.size();
+
+  // vertices of each group
+  std::vector<uint32_t> start(nGroups + 1, 0);
+  for (uint32_t v = 0; v < n; v++) {
+    start[map[v] + 1]++;
+  }
+  std::partial_sum(start.begin(), start.end(), start.begin());
+  std::vector<uint32_t> members(n);
+  std::vector<uint32_t> next(start.begin(), start.end() - 1);
+  for (uint32_t v = 0; v < n; v++) {
+    members[next[map[v]]++] = v;
+  }
+
+  Graph coarse;
+  coarse.load.assign(nGroups, 0.0);
+  coarse.xadj.reserve(nGroups + 1);
+  coarse.xadj.push_back(0);
+
+  // position of the edge to each group in the adjacency of the current group, if greater than
+  // the start of this adjacency
+  std::vector<uint32_t> position(nGroups, 0);
+  for (uint32_t group = 0; group < nGroups; group++) {
+    uint32_t first = coarse.adj.size();
+    for (uint32_t i = start[group]; i < start[group + 1]; i++) {
+      uint32_t v = members[i];
+      coarse.load[group] += graph.load[v];
+      for (uint32_t e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+        uint32_t neighbor = map[graph.adj[e]];
+        if (neighbor == group) {
+          continue;
+        }
+        if (coarse.adj.size() == first || position[neighbor] < first
+            || coarse.adj[position[neighbor]] != neighbor) {
+          position[neighbor] = coarse.adj.size();
+          coarse.adj.push_back(neighbor);
+          coarse.cost.push_back(graph.cost[e]);
+        }
+        else {
+          coarse.cost[position[neighbor]] += graph.cost[e];
+        }
+      }
+    }
+    coarse.xadj.push_back(coarse.adj.size());
+  }
+  return coarse;
+}
+
+TopologyPartitioner::Graph
+TopologyPartitioner::Coarsen(const Graph& graph, std::vector<uint32_t>& coarse)
+{
+  uint32_t n = graph.size();
+
+  std::vector<uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  for (uint32_t i = n; i > 1; i--) {
+    std::swap(order[i - 1], order[GetRandom() % i]);
+  }
+
+  uint32_t nCoarse = 0;
+  coarse.assign(n, NONE);
+  for (uint32_t v : order) {
+    if (coarse[v] != NONE) {
+      continue;
+    }
+
+    uint32_t match = v;
+    double matchCost = 0;
+    for (uint32_t e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+      uint32_t u = graph.adj[e];
+      if (coarse[u] == NONE && graph.cost[e] > matchCost
+          && graph.load[u] + graph.load[v] <= m_clusterLoad) {
+        match = u;
+        matchCost = graph.cost[e];
+      }
+    }
+    coarse[v] = nCoarse;
+    coarse[match] = nCoarse;
+    nCoarse++;
+  }
+
+  return Contract(graph, coarse, nCoarse);
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::InitialPartition(const Graph& graph)
+{
+  const uint32_t nTrials = std::min(graph.size(), 8u);
+
+  std::vector<uint32_t> best;
+  double bestCut = 0;
+  double bestMaxLoad = 0;
+  for (uint32_t trial = 0; trial < nTrials; trial++) {
+    std::vector<uint32_t> part = GrowPartitions(graph, GetRandom() % graph.size());
+    Refine(graph, part);
+
+    std::vector<double> loads(m_nPartitions, 0.0);
+    for (uint32_t v = 0; v < graph.size(); v++) {
+      loads[part[v]] += graph.load[v];
+    }
+    double maxLoad = *std::max_element(loads.begin(), loads.end());
+    double cut = GetCut(graph, part);
+
+    // prefer balanced partitions, then the smallest cut
+    bool isBetter;
+    if (best.empty()) {
+      isBetter = true;
+    }
+    else if ((maxLoad <= m_maxLoad) != (bestMaxLoad <= m_maxLoad)) {
+      isBetter = maxLoad <= m_maxLoad;
+    }
+    else if (maxLoad <= m_maxLoad) {
+      isBetter = cut < bestCut;
+    }
+    else {
+      isBetter = maxLoad < bestMaxLoad;
+    }
+
+    if (isBetter) {
+      best.swap(part);
+      bestCut = cut;
+      bestMaxLoad = maxLoad;
+    }
+  }
+  return best;
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::GrowPartitions(const Graph& graph, uint32_t firstSeed)
+{
+  uint32_t n = graph.size();
+  const uint32_t unassigned = m_nPartitions;
+  std::vector<uint32_t> part(n, unassigned);
+
+  double target = std::accumulate(graph.load.begin(), graph.load.end(), 0.0) / m_nPartitions;
+
+  std::vector<double> connection(n);
+  std::vector<bool> isRejected(n);
+  for (uint32_t p = 0; p + 1 < m_nPartitions; p++) {
+    std::fill(connection.begin(), connection.end(), 0.0);
+    std::fill(isRejected.begin(), isRejected.end(), false);
+
+    // seeds of the disconnected parts of the partition
+    uint32_t cursor = GetRandom() % n;
+    uint32_t nScanned = 0;
+    auto nextSeed = [&]() {
+      for (; nScanned < n; nScanned++) {
+        uint32_t v = cursor;
+        cursor = (cursor + 1) % n;
+        if (part[v] == unassigned && !isRejected[v]) {
+          return v;
+        }
+      }
+      return NONE;
+    };
+
+    std::priority_queue<std::pair<double, uint32_t>> frontier;
+    frontier.push(std::make_pair(0.0, p == 0 ? firstSeed : nextSeed()));
+
+    double load = 0;
+    while (load < target) {
+      if (frontier.empty()) {
+        uint32_t seed = nextSeed();
+        if (seed == NONE) {
+          break;
+        }
+        frontier.push(std::make_pair(0.0, seed));
+      }
+
+      uint32_t v = frontier.top().second;
+      frontier.pop();
+      if (v == NONE || part[v] != unassigned || isRejected[v]) {
+        continue;
+      }
+      // do not overshoot the target by more than the remaining gap
+      if (load > 0 && load + graph.load[v] - target > target - load) {
+        isRejected[v] = true;
+        continue;
+      }
+
+      part[v] = p;
+      load += graph.load[v];
+      for (uint32_t e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+        uint32_t u = graph.adj[e];
+        if (part[u] == unassigned) {
+          connection[u] += graph.cost[e];
+          frontier.push(std::make_pair(connection[u], u));
+        }
+      }
+    }
+  }
+
+  for (uint32_t& p : part) {
+    if (p == unassigned) {
+      p = m_nPartitions - 1;
+    }
+  }
+  return part;
+}
+
+void
+TopologyPartitioner::Refine(const Graph& graph, std::vector<uint32_t>& part)
+{
+  const uint32_t nPasses = 8;
+  uint32_t n = graph.size();
+
+  std::vector<double> loads(m_nPartitions, 0.0);
+  for (uint32_t v = 0; v < n; v++) {
+    loads[part[v]] += graph.load[v];
+  }
+
+  std::vector<double> connection(m_nPartitions, 0.0);
+  std::vector<bool> isNeighbor(m_nPartitions, false);
+  std::vector<uint32_t> neighbors;
+  for (uint32_t pass = 0; pass < nPasses; pass++) {
+    uint32_t nMoves = 0;
+    for (uint32_t v = 0; v < n; v++) {
+      uint32_t from = part[v];
+      double load = graph.load[v];
+      bool isOverloaded = loads[from] > m_maxLoad;
+
+      neighbors.clear();
+      for (uint32_t e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+        uint32_t q = part[graph.adj[e]];
+        if (!isNeighbor[q]) {
+          isNeighbor[q] = true;
+          neighbors.push_back(q);
+        }
+        connection[q] += graph.cost[e];
+      }
+
+      uint32_t to = from;
+      double gain = -std::numeric_limits<double>::infinity();
+      for (uint32_t q : neighbors) {
+        if (q == from) {
+          continue;
+        }
+        if (loads[q] + load > m_maxLoad && !(isOverloaded && loads[q] + load < loads[from])) {
+          continue;
+        }
+        double candidateGain = connection[q] - connection[from];
+        if (candidateGain > gain || (candidateGain == gain && loads[q] < loads[to])) {
+          to = q;
+          gain = candidateGain;
+        }
+      }
+
+      for (uint32_t q : neighbors) {
+        isNeighbor[q] = false;
+        connection[q] = 0;
+      }
+
+      bool isMoved = false;
+      if (to != from) {
+        isMoved = gain > 0 || (gain == 0 && loads[to] + load < loads[from]) || isOverloaded;
+      }
+      else if (isOverloaded) {
+        // no neighboring partition can take the vertex: move it to the lightest one
+        to = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        isMoved = loads[to] + load < loads[from];
+      }
+
+      if (isMoved) {
+        loads[from] -= load;
+        loads[to] += load;
+        part[v] = to;
+        nMoves++;
+      }
+    }
+
+    if (nMoves == 0) {
+      break;
+    }
+  }
+}
+
+double
+TopologyPartitioner::GetCut(const Graph& graph, const std::vector<uint32_t>& part)
+{
+  double cut = 0;
+  for (uint32_t v = 0; v < graph.size(); v++) {
+    for (uint32_t e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+      if (part[v] != part[graph.adj[e]]) {
+        cut += graph.cost[e];
+      }
+    }
+  }
+  return cut / 2;
+}
+
+uint32_t
+TopologyPartitioner::GetRandom()
+{
+  // xorshift32
+  m_random ^= m_random << 13;
+  m_random ^= m_random >> 17;
+  m_random ^= m_random << 5;
+  return m_random;
+}
+
+} // namespace ns3
@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TOPOLOGY_PARTITIONER_HPP
+#define NDNSIM_TOPOLOGY_PARTITIONER_HPP
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Multilevel partitioner of a topology into system ids for parallel simulations
+ *
+ * The vertices are weighted by their expected event load and the edges by their delay.  A
+ * conservative parallel simulator can only advance a partition by the smallest delay of the
+ * links from the other partitions (the lookahead), so the partitioner:
+ *
+ * 1. contracts the links shorter than the largest delay threshold which still leaves clusters
+ *    small enough to be balanced (at most a quarter of the average partition load), so that
+ *    the lookahead is at least this threshold;
+ * 2. partitions the contracted graph with a multilevel scheme: heavy-edge matching coarsening,
+ *    greedy graph growing on the coarsest graph, and greedy boundary refinement while
+ *    projecting back.  The cost of cutting a link is inversely proportional to its delay, so
+ *    that the short links remaining are cut last.
+ *
+ * The result is deterministic for a given graph.
+ */
+class TopologyPartitioner {
+public:
+  TopologyPartitioner();
+
+  /**
+   * \brief Add a vertex
+   * \param load expected event load of the vertex (e.g., 1 + number of links)
+   * \return index of the vertex, starting from 0
+   */
+  uint32_t
+  AddVertex(double load = 1.0);
+
+  /**
+   * \brief Add an undirected edge
+   * \param u index of the first vertex
+   * \param v index of the second vertex
+   * \param delay propagation delay of the link
+   * \param weight relative cost of cutting the link, e.g., its expected traffic
+   */
+  void
+  AddEdge(uint32_t u, uint32_t v, const Time& delay, double weight = 1.0);
+
+  /**
+   * \brief Set the allowed imbalance
+   * \param tolerance allowed excess of the load of a partition over the average, e.g. 0.05
+   */
+  void
+  SetImbalanceTolerance(double tolerance);
+
+  /**
+   * \brief Partition the graph
+   * \param nPartitions number of partitions
+   * \return partition of each vertex
+   */
+  const std::vector<uint32_t>&
+  Partition(uint32_t nPartitions);
+
+  /**
+   * \brief Get the partition of each vertex, as computed by the last call to Partition
+   */
+  const std::vector<uint32_t>&
+  GetPartitions() const;
+
+  /**
+   * \brief Get the smallest delay of the edges between different partitions
+   * \return the smallest delay, or the maximum simulation time if no edge is cut
+   */
+  Time
+  GetLookahead() const;
+
+  /**
+   * \brief Get the sum of the loads of the vertices of each partition
+   */
+  std::vector<double>
+  GetLoads() const;
+
+  /**
+   * \brief Get the number of edges between different partitions
+   */
+  uint32_t
+  GetCutSize() const;
+
+private:
+  /**
+   * \brief Graph in compressed sparse row format, at one level of coarsening
+   */
+  struct Graph
+  {
+    std::vector<double> load;    ///< load of each vertex
+    std::vector<uint32_t> xadj;  ///< start of the neighbors of each vertex in adj
+    std::vector<uint32_t> adj;   ///< neighbors
+    std::vector<double> cost;    ///< cost of the edge to each neighbor
+
+    uint32_t
+    size() const
+    {
+      return load.size();
+    }
+  };
+
+  struct Edge
+  {
+    uint32_t u;
+    uint32_t v;
+    int64_t delay;
+    double weight;
+  };
+
+  /**
+   * \brief Contract the edges shorter than the largest feasible delay threshold
+   * \param[out] cluster cluster of each vertex
+   * \return number of clusters
+   */
+  uint32_t
+  ContractShortEdges(std::vector<uint32_t>& cluster) const;
+
+  /**
+   * \brief Build the graph of the vertices and edges, with the cost of cutting each edge
+   */
+  Graph
+  BuildGraph() const;
+
+  /**
+   * \brief Build the graph of groups of vertices, merging parallel edges
+   * \param map group of each vertex
+   * \param nGroups number of groups
+   */
+  static Graph
+  Contract(const Graph& graph, const std::vector<uint32_t>& map, uint32_t nGroups);
+
+  /**
+   * \brief Match the vertices with heavy-edge matching
+   * \param[out] coarse coarse vertex of each vertex
+   * \return the coarse graph
+   */
+  Graph
+  Coarsen(const Graph& graph, std::vector<uint32_t>& coarse);
+
+  /**
+   * \brief Partition the coarsest graph by greedy graph growing, keeping the best of a few trials
+   */
+  std::vector<uint32_t>
+  InitialPartition(const Graph& graph);
+
+  /**
+   * \brief Grow the partitions from seeds, each one up to the average load
+   */
+  std::vector<uint32_t>
+  GrowPartitions(const Graph& graph, uint32_t firstSeed);
+
+  /**
+   * \brief Move boundary vertices to reduce the cut while keeping the balance
+   */
+  void
+  Refine(const Graph& graph, std::vector<uint32_t>& part);
+
+  static double
+  GetCut(const Graph& graph, const std::vector<uint32_t>& part);
+
+  /**
+   * \brief Get a pseudo-random number, from a generator seeded by each call to Partition
+   */
+  uint32_t
+  GetRandom();
+
+private:
+  std::vector<double> m_loads;
+  std::vector<Edge> m_edges;
+  double m_tolerance;
+
+  uint32_t m_nPartitions;
+  double m_maxLoad;     ///< largest allowed load of a partition
+  double m_clusterLoad; ///< largest load of a cluster or of a coarse vertex
+  std::vector<uint32_t> m_partitions;
+  uint32_t m_random; ///< state of the generator used to break ties
+};
+
+} // namespace ns3
+
+#endif // NDNSIM_TOPOLOGY_PARTITIONER_HPP
@@ -21,6 +21,8 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.hpp"
+#include "ndn-node-context-event.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -42,12 +44,19 @@ public:
    * @brief Network layer tracer constructor
    */
   L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor, writing the records to a sink
+   */
+  L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node);
+
   virtual ~L2RateTracer();
 
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written
+   * @param file File to which traces will be written, in the binary format of ndn::TraceSink if
+   *             its name ends with .bin
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -69,6 +78,12 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Get the columns of the records of the tracer
+   */
+  static const std::vector<ndn::TraceSink::Column>&
+  GetColumns();
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -78,10 +93,19 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write the current trace data to a sink
+   */
+  void
+  Print(ndn::TraceSink& sink) const;
+
   virtual void
   Drop(Ptr<const Packet>);
 
 private:
+  void
+  SchedulePrinter();
+
   void
   PeriodicPrinter();
 
@@ -89,8 +113,9 @@ private:
   Reset();
 
 private:
-  std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceSink> m_sink;
   Time m_period;
+  ndn::NodeContextEvent m_startEvent; ///< first printing, scheduled in the context of the node
   EventId m_printEvent;
 
   mutable std::tuple<Stats, Stats, Stats, Stats> m_stats;
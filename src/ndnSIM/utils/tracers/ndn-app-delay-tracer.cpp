@@ -32,14 +32,16 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
-#include <fstream>
+#include <cmath>
+#include <limits>
+
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<AppDelayTracer>>>>
   g_tracers;
 
 void
@@ -51,129 +53,160 @@ AppDelayTracer::Destroy()
 void
 AppDelayTracer::InstallAll(const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, sink);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  g_tracers.push_back(std::make_tuple(sink, tracers));
+}
+
+void
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+{
+  std::list<Ptr<AppDelayTracer>> tracers;
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Ptr<AppDelayTracer> trace = Install(node, sink);
+  tracers.push_back(trace);
+
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::InstallAllSummaries(const std::string& file, Time period /* = Seconds(1.0)*/,
+                                    const std::string& sampleFile /* = ""*/,
+                                    double sampleProbability /* = 0.001*/)
 {
-  using namespace boost;
-  using namespace std;
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+
+  InstallSummaries(nodes, file, period, sampleFile, sampleProbability);
+}
 
+void
+AppDelayTracer::InstallSummaries(const NodeContainer& nodes, const std::string& file,
+                                 Time period /* = Seconds(1.0)*/,
+                                 const std::string& sampleFile /* = ""*/,
+                                 double sampleProbability /* = 0.001*/)
+{
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  shared_ptr<TraceSink> summarySink = TraceSink::Open(file, GetSummaryColumns());
+  if (summarySink == nullptr) {
+    return;
+  }
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+  shared_ptr<TraceSink> sampleSink;
+  if (!sampleFile.empty()) {
+    sampleSink = TraceSink::Open(sampleFile, GetColumns());
+    if (sampleSink == nullptr) {
       return;
     }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
-  tracers.push_back(trace);
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    NS_LOG_DEBUG("Node: " << (*node)->GetId());
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(sampleSink, *node);
+    trace->SetSampleProbability(sampleProbability);
+    trace->EnableSummaries(summarySink, period);
+    tracers.push_back(trace);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(summarySink, tracers));
 }
 
 Ptr<AppDelayTracer>
 AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  return Install(node, TraceSink::CreateText(outputStream, GetColumns()));
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(sink, node);
 
   return trace;
 }
 
+const std::vector<TraceSink::Column>&
+AppDelayTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"AppId", TraceSink::INTEGER},
+    {"SeqNo", TraceSink::INTEGER},
+    {"Type", TraceSink::STRING},
+    {"DelayS", TraceSink::DOUBLE},
+    {"DelayUS", TraceSink::DOUBLE},
+    {"RetxCount", TraceSink::INTEGER},
+    {"HopCount", TraceSink::INTEGER}};
+  return columns;
+}
+
+const std::vector<TraceSink::Column>&
+AppDelayTracer::GetSummaryColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"AppId", TraceSink::INTEGER},
+    {"Type", TraceSink::STRING},
+    {"Count", TraceSink::INTEGER},
+    {"MeanS", TraceSink::DOUBLE},
+    {"P50S", TraceSink::DOUBLE},
+    {"P90S", TraceSink::DOUBLE},
+    {"P99S", TraceSink::DOUBLE},
+    {"P999S", TraceSink::DOUBLE},
+    {"MaxS", TraceSink::DOUBLE}};
+  return columns;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : AppDelayTracer(TraceSink::CreateText(os, GetColumns()), node)
+{
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
+  , m_sampleThreshold(std::numeric_limits<uint64_t>::max())
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -187,12 +220,17 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(TraceSink::CreateText(os, GetColumns()))
+  , m_sampleThreshold(std::numeric_limits<uint64_t>::max())
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_startEvent.Cancel();
+  m_printEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -209,47 +247,116 @@ AppDelayTracer::Connect()
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-     << "Node"
-     << "\t"
-     << "AppId"
-     << "\t"
-     << "SeqNo"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "DelayS"
-     << "\t"
-     << "DelayUS"
-     << "\t"
-     << "RetxCount"
-     << "\t"
-     << "HopCount"
-     << "";
+  TraceSink::PrintColumnNames(os, GetColumns());
+}
+
+void
+AppDelayTracer::EnableSummaries(shared_ptr<TraceSink> sink, const Time& period)
+{
+  m_summarySink = sink;
+  m_period = period;
+  m_printEvent.Cancel();
+  m_startEvent.Cancel();
+  m_startEvent = ScheduleInNodeContext(m_nodePtr, Seconds(0),
+                                       &AppDelayTracer::SchedulePrinter, this);
+}
+
+void
+AppDelayTracer::SetSampleProbability(double probability)
+{
+  if (probability >= 1.0) {
+    m_sampleThreshold = std::numeric_limits<uint64_t>::max();
+  }
+  else {
+    m_sampleThreshold = static_cast<uint64_t>(std::max(probability, 0.0) * std::pow(2.0, 64));
+  }
+}
+
+bool
+AppDelayTracer::IsSampled(uint32_t appId, uint32_t seqno) const
+{
+  if (m_sampleThreshold == std::numeric_limits<uint64_t>::max()) {
+    return true;
+  }
+
+  // Fibonacci hashing spreads the consecutive sequence numbers evenly
+  uint64_t hash = ((static_cast<uint64_t>(appId) << 32) | seqno) * 0x9E3779B97F4A7C15ULL;
+  return hash < m_sampleThreshold;
+}
+
+void
+AppDelayTracer::SchedulePrinter()
+{
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+  for (size_t appId = 0; appId < m_appHistograms.size(); appId++) {
+    PrintSummary(time, appId, "LastDelay", m_appHistograms[appId].lastDelay);
+    PrintSummary(time, appId, "FullDelay", m_appHistograms[appId].fullDelay);
+  }
+  PrintSummary(time, -1, "LastDelay", m_nodeHistograms.lastDelay);
+  PrintSummary(time, -1, "FullDelay", m_nodeHistograms.fullDelay);
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::PrintSummary(double time, int64_t appId, const char* type,
+                             LatencyHistogram& histogram)
+{
+  if (histogram.GetCount() == 0) {
+    return;
+  }
+
+  m_summarySink->Write(time, m_node, appId, type, histogram.GetCount(),
+                       histogram.GetMean().ToDouble(Time::S),
+                       histogram.GetQuantile(0.5).ToDouble(Time::S),
+                       histogram.GetQuantile(0.9).ToDouble(Time::S),
+                       histogram.GetQuantile(0.99).ToDouble(Time::S),
+                       histogram.GetQuantile(0.999).ToDouble(Time::S),
+                       histogram.GetMax().ToDouble(Time::S));
+  histogram.Reset();
 }
 
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (m_summarySink != nullptr) {
+    if (app->GetId() >= m_appHistograms.size()) {
+      m_appHistograms.resize(app->GetId() + 1);
+    }
+    m_appHistograms[app->GetId()].lastDelay.AddValue(delay);
+    m_nodeHistograms.lastDelay.AddValue(delay);
+  }
+
+  if (m_sink != nullptr && IsSampled(app->GetId(), seqno)) {
+    m_sink->Write(Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, "LastDelay",
+                  delay.ToDouble(Time::S), delay.ToDouble(Time::US), 1, hopCount);
+  }
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (m_summarySink != nullptr) {
+    if (app->GetId() >= m_appHistograms.size()) {
+      m_appHistograms.resize(app->GetId() + 1);
+    }
+    m_appHistograms[app->GetId()].fullDelay.AddValue(delay);
+    m_nodeHistograms.fullDelay.AddValue(delay);
+  }
+
+  if (m_sink != nullptr && IsSampled(app->GetId(), seqno)) {
+    m_sink->Write(Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, "FullDelay",
+                  delay.ToDouble(Time::S), delay.ToDouble(Time::US), retxCount, hopCount);
+  }
 }
 
 } // namespace ndn
@@ -22,6 +22,10 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-latency-histogram.hpp"
+#include "ndn-node-context-event.hpp"
+#include "ndn-trace-sink.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -30,6 +34,7 @@
 
 #include <tuple>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -49,7 +54,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    *
    */
   static void
@@ -59,7 +65,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    *
    */
   static void
@@ -69,7 +76,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *        second)
    */
@@ -91,6 +99,56 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink Sink of the records, e.g., opened with TraceSink::Open
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink);
+
+  /**
+   * @brief Get the columns of the records of the tracer
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
+  /**
+   * @brief Get the columns of the summaries of the delays
+   */
+  static const std::vector<TraceSink::Column>&
+  GetSummaryColumns();
+
+  /**
+   * @brief Helper method to install tracers summarizing the delays on all simulation nodes
+   *
+   * Instead of a record per Data packet, the tracers write periodically the count and the
+   * quantiles of the delays of each application and of each node (AppId -1) during the period.
+   * The delays are kept in LatencyHistogram, with a cost independent of the number of Data.
+   *
+   * @param file File to which the summaries will be written.  If filename is -, then std::out is
+   *             used, and if it ends with .bin, the traces are written in the binary format of
+   *             TraceSink
+   * @param period How often the summaries will be written (default, every second)
+   * @param sampleFile File to which the records of a sample of the Data packets will be written,
+   *                   in the format of InstallAll, or empty for none
+   * @param sampleProbability Probability of a Data packet to be in the sample
+   */
+  static void
+  InstallAllSummaries(const std::string& file, Time period = Seconds(1.0),
+                      const std::string& sampleFile = "", double sampleProbability = 0.001);
+
+  /**
+   * @brief Helper method to install tracers summarizing the delays on the selected simulation
+   *        nodes
+   *
+   * @see InstallAllSummaries
+   */
+  static void
+  InstallSummaries(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0),
+                   const std::string& sampleFile = "", double sampleProbability = 0.001);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -114,6 +172,13 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param sink  sink of the records, possibly shared with other tracers
+   * @param node  pointer to the node
+   */
+  AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -127,10 +192,37 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Write periodically the summaries of the delays to a sink
+   */
+  void
+  EnableSummaries(shared_ptr<TraceSink> sink, const Time& period);
+
+  /**
+   * @brief Write the records of only a sample of the Data packets
+   *
+   * A Data packet is in the sample if the hash of its application id and sequence number is
+   * below the probability, so that both its LastDelay and FullDelay records are written.
+   */
+  void
+  SetSampleProbability(double probability);
+
 private:
   void
   Connect();
 
+  bool
+  IsSampled(uint32_t appId, uint32_t seqno) const;
+
+  void
+  SchedulePrinter();
+
+  void
+  PeriodicPrinter();
+
+  void
+  PrintSummary(double time, int64_t appId, const char* type, LatencyHistogram& histogram);
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -142,7 +234,20 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink; ///< sink of the per-packet records, if any
+  uint64_t m_sampleThreshold;   ///< largest hash of the sampled Data packets
+
+  struct Histograms {
+    LatencyHistogram lastDelay;
+    LatencyHistogram fullDelay;
+  };
+
+  shared_ptr<TraceSink> m_summarySink;
+  Time m_period;
+  NodeContextEvent m_startEvent; ///< first printing, scheduled in the context of the node
+  EventId m_printEvent;
+  std::vector<Histograms> m_appHistograms; ///< per application id
+  Histograms m_nodeHistograms;
 };
 
 } // namespace ndn
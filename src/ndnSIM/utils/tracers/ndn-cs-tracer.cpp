@@ -32,14 +32,16 @@
 
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<CsTracer>>>> g_tracers;
+
+/// header of the text traces, with the trailing tab the tracer always wrote
+static const std::string TEXT_HEADER = "Time\tNode\tType\tPackets\t";
 
 void
 CsTracer::Destroy()
@@ -50,133 +52,96 @@ CsTracer::Destroy()
 void
 CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns(), TEXT_HEADER);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns(), TEXT_HEADER);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns(), TEXT_HEADER);
+  if (sink == nullptr) {
+    return;
   }
 
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<CsTracer> trace = Install(node, sink, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                   Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, TraceSink::CreateText(outputStream, GetColumns()), averagingPeriod);
+}
+
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
+  Ptr<CsTracer> trace = Create<CsTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
+const std::vector<TraceSink::Column>&
+CsTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Packets", TraceSink::DOUBLE}};
+  return columns;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : CsTracer(TraceSink::CreateText(os, GetColumns()), node)
+{
+}
+
+CsTracer::CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -190,12 +155,16 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
-  , m_os(os)
+  , m_sink(TraceSink::CreateText(os, GetColumns()))
 {
   Connect();
 }
 
-CsTracer::~CsTracer(){};
+CsTracer::~CsTracer()
+{
+  m_startEvent.Cancel();
+  m_printEvent.Cancel();
+}
 
 void
 CsTracer::Connect()
@@ -211,6 +180,14 @@ void
 CsTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
+  m_printEvent.Cancel();
+  m_startEvent.Cancel();
+  m_startEvent = ScheduleInNodeContext(m_nodePtr, Seconds(0), &CsTracer::SchedulePrinter, this);
+}
+
+void
+CsTracer::SchedulePrinter()
+{
   m_printEvent.Cancel();
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
@@ -218,7 +195,7 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -227,16 +204,7 @@ CsTracer::PeriodicPrinter()
 void
 CsTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t";
+  os << TEXT_HEADER;
 }
 
 void
@@ -246,11 +214,16 @@ CsTracer::Reset()
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  sink.Write(time.ToDouble(Time::S), m_node, printName, m_stats.fieldName);
 
 void
 CsTracer::Print(std::ostream& os) const
+{
+  Print(*TraceSink::CreateText(shared_ptr<std::ostream>(&os, std::bind([]{})), GetColumns()));
+}
+
+void
+CsTracer::Print(TraceSink& sink) const
 {
   Time time = Simulator::Now();
 
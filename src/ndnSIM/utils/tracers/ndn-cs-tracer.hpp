@@ -22,6 +22,9 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-node-context-event.hpp"
+#include "ndn-trace-sink.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -64,7 +67,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -80,7 +84,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -96,7 +101,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -124,6 +130,23 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink Sink of the records, e.g., opened with TraceSink::Open
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get the columns of the records of the tracer
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +170,13 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the records, possibly shared with other tracers
+   * @param node  pointer to the node
+   */
+  CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -168,6 +198,12 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write the current trace data to a sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
 private:
   void
   Connect();
@@ -185,6 +221,9 @@ private:
   void
   Reset();
 
+  void
+  SchedulePrinter();
+
   void
   PeriodicPrinter();
 
@@ -192,9 +231,10 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
 
   Time m_period;
+  NodeContextEvent m_startEvent; ///< first printing, scheduled in the context of the node
   EventId m_printEvent;
   cs::Stats m_stats;
 };
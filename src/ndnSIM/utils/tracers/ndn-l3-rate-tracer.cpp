@@ -29,7 +29,6 @@
 
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -37,9 +36,11 @@ NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<L3RateTracer>>>>
   g_tracers;
 
+const uint32_t L3RateTracer::NO_SLOT;
+
 void
 L3RateTracer::Destroy()
 {
@@ -50,138 +51,118 @@ void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<L3RateTracer> trace = Install(node, sink, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, TraceSink::CreateText(outputStream, GetColumns()), averagingPeriod);
+}
+
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
+const std::vector<TraceSink::Column>&
+L3RateTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"FaceId", TraceSink::INTEGER},
+    {"FaceDescr", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Packets", TraceSink::DOUBLE},
+    {"Kilobytes", TraceSink::DOUBLE},
+    {"PacketRaw", TraceSink::DOUBLE},
+    {"KilobytesRaw", TraceSink::DOUBLE}};
+  return columns;
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(TraceSink::CreateText(os, GetColumns()))
+  , m_nodeStats(FaceStats{nfd::face::INVALID_FACEID, "all"})
+  , m_hasNodeStats(false)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(TraceSink::CreateText(os, GetColumns()))
+  , m_nodeStats(FaceStats{nfd::face::INVALID_FACEID, "all"})
+  , m_hasNodeStats(false)
+{
+  SetAveragingPeriod(Seconds(1.0));
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
+  : L3Tracer(node)
+  , m_sink(sink)
+  , m_nodeStats(FaceStats{nfd::face::INVALID_FACEID, "all"})
+  , m_hasNodeStats(false)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::~L3RateTracer()
 {
+  m_startEvent.Cancel();
   m_printEvent.Cancel();
 }
 
@@ -189,6 +170,14 @@ void
 L3RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
+  m_printEvent.Cancel();
+  m_startEvent.Cancel();
+  m_startEvent = ScheduleInNodeContext(m_nodePtr, Seconds(0), &L3RateTracer::SchedulePrinter, this);
+}
+
+void
+L3RateTracer::SchedulePrinter()
+{
   m_printEvent.Cancel();
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
@@ -196,7 +185,7 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -205,68 +194,51 @@ L3RateTracer::PeriodicPrinter()
 void
 L3RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "FaceId"
-     << "\t"
-     << "FaceDescr"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketRaw"
-     << "\t"
-     << "KilobytesRaw";
+  TraceSink::PrintColumnNames(os, GetColumns());
 }
 
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (FaceStats& stats : m_faceStats) {
+    stats.packets.Reset();
+    stats.bytes.Reset();
   }
+  m_nodeStats.packets.Reset();
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
+// the averages are updated with the counts of the period when they are printed
 #define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  stats.packetRate.fieldName = /*new value*/ alpha * stats.packets.fieldName / period              \
+                               + /*old value*/ (1 - alpha) * stats.packetRate.fieldName;           \
+  stats.kilobyteRate.fieldName = /*new value*/ alpha * stats.bytes.fieldName / period / 1024.0     \
+                                 + /*old value*/ (1 - alpha) * stats.kilobyteRate.fieldName;       \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  sink.Write(time, m_node, faceId, stats.description, printName, stats.packetRate.fieldName,       \
+             stats.kilobyteRate.fieldName, stats.packets.fieldName, stats.bytes.fieldName / 1024.0);
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  Print(*TraceSink::CreateText(shared_ptr<std::ostream>(&os, std::bind([]{})), GetColumns()));
+}
+
+void
+L3RateTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+  double period = m_period.ToDouble(Time::S);
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
+  // by increasing face id
+  for (uint32_t slot : m_slots) {
+    if (slot == NO_SLOT)
       continue;
 
+    FaceStats& stats = m_faceStats[slot];
+    int64_t faceId = stats.faceId;
+
     PRINTER("InInterests", m_inInterests);
     PRINTER("OutInterests", m_outInterests);
 
@@ -283,122 +255,123 @@ L3RateTracer::Print(std::ostream& os) const
     PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
   }
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+  if (m_hasNodeStats) {
+    FaceStats& stats = m_nodeStats;
+    int64_t faceId = -1;
+
+    PRINTER("SatisfiedInterests", m_satisfiedInterests);
+    PRINTER("TimedOutInterests", m_timedOutInterests);
   }
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_outInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_inInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
+    stats.bytes.m_outData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
+    stats.bytes.m_inData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_outNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_inNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  m_hasNodeStats = true;
+  m_nodeStats.packets.m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    GetStats(in.getFace()).packets.m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    GetStats(out.getFace()).packets.m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  m_hasNodeStats = true;
+  m_nodeStats.packets.m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    GetStats(in.getFace()).packets.m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+    GetStats(out.getFace()).packets.m_outTimedOutInterests++;
   }
 }
 
-void
-L3RateTracer::AddInfo(const Face& face)
+L3RateTracer::FaceStats&
+L3RateTracer::AddFace(const Face& face)
 {
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+  nfd::FaceId faceId = face.getId();
+  NS_LOG_DEBUG("Node " << m_node << ": stats of face " << faceId);
+
+  if (faceId >= m_slots.size()) {
+    m_slots.resize(faceId + 1, NO_SLOT);
   }
+  m_slots[faceId] = m_faceStats.size();
+
+  FaceStats stats = FaceStats();
+  stats.faceId = faceId;
+  stats.description = boost::lexical_cast<std::string>(face.getLocalUri());
+  m_faceStats.push_back(stats);
+  return m_faceStats.back();
 }
 
 } // namespace ndn
@@ -23,14 +23,17 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-node-context-event.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
-#include <tuple>
-#include <map>
+#include <limits>
 #include <list>
+#include <tuple>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -44,7 +47,8 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -56,7 +60,8 @@ public:
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -67,7 +72,8 @@ public:
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    */
@@ -97,6 +103,13 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the records, possibly shared with other tracers
+   * @param node  pointer to the node
+   */
+  L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -118,6 +131,23 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param sink Sink of the records, e.g., opened with TraceSink::Open
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get the columns of the records of the tracer
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -125,6 +155,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write the current trace data to a sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -155,24 +191,57 @@ private:
   void
   SetAveragingPeriod(const Time& period);
 
+  void
+  SchedulePrinter();
+
   void
   PeriodicPrinter();
 
   void
   Reset();
 
-  void
-  AddInfo(const Face& face);
+  struct FaceStats;
+
+  /// Get the stats of a face, adding them at the first packet of the face
+  FaceStats&
+  GetStats(const Face& face);
+
+  FaceStats&
+  AddFace(const Face& face);
 
 private:
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
   Time m_period;
+  NodeContextEvent m_startEvent; ///< first printing, scheduled in the context of the node
   EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  struct FaceStats {
+    nfd::FaceId faceId;
+    std::string description; // needed, because face may no longer exists at the time of stat printing
+    Stats packets;      ///< counts of the current period
+    Stats bytes;        ///< sizes of the current period
+    Stats packetRate;   ///< average packets per second, updated at each print
+    Stats kilobyteRate; ///< average kilobytes per second, updated at each print
+  };
+
+  static const uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+  std::vector<uint32_t> m_slots; ///< per face id, index of the stats of the face, or NO_SLOT
+  mutable std::vector<FaceStats> m_faceStats;
+  mutable FaceStats m_nodeStats; ///< satisfied and timed out Interests of the node (face -1)
+  bool m_hasNodeStats;
 };
 
+inline L3RateTracer::FaceStats&
+L3RateTracer::GetStats(const Face& face)
+{
+  nfd::FaceId faceId = face.getId();
+  if (faceId < m_slots.size() && m_slots[faceId] != NO_SLOT) {
+    return m_faceStats[m_slots[faceId]];
+  }
+  return AddFace(face);
+}
+
 } // namespace ndn
 } // namespace ns3
 
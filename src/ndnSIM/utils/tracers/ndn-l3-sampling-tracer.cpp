@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-l3-sampling-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.L3SamplingTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<L3SamplingTracer>>>>
+  g_tracers;
+
+static const uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+static const char* const TYPE_NAMES[N_PACKET_EVENT_TYPES] = {
+  "InInterests", "OutInterests", "InData", "OutData", "InNacks", "OutNacks"};
+
+void
+L3SamplingTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+L3SamplingTracer::InstallAll(const std::string& file, Time period /* = Seconds(1.0)*/,
+                             double probability /* = 0.01*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+
+  Install(nodes, file, period, probability);
+}
+
+void
+L3SamplingTracer::Install(const NodeContainer& nodes, const std::string& file,
+                          Time period /* = Seconds(1.0)*/, double probability /* = 0.01*/)
+{
+  std::list<Ptr<L3SamplingTracer>> tracers;
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, GetColumns());
+  if (sink == nullptr) {
+    return;
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3SamplingTracer> trace = Install(*node, sink, period, probability);
+    tracers.push_back(trace);
+  }
+
+  g_tracers.push_back(std::make_tuple(sink, tracers));
+}
+
+void
+L3SamplingTracer::Install(Ptr<Node> node, const std::string& file, Time period /* = Seconds(1.0)*/,
+                          double probability /* = 0.01*/)
+{
+  NodeContainer nodes;
+  nodes.Add(node);
+
+  Install(nodes, file, period, probability);
+}
+
+Ptr<L3SamplingTracer>
+L3SamplingTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                          Time period /* = Seconds(1.0)*/, double probability /* = 0.01*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<L3SamplingTracer> trace = Create<L3SamplingTracer>(sink, node);
+  for (int type = 0; type < N_PACKET_EVENT_TYPES; type++) {
+    trace->GetSampler(static_cast<PacketEventType>(type)).SampleWithProbability(probability);
+  }
+  trace->SetPeriod(period);
+
+  return trace;
+}
+
+const std::vector<TraceSink::Column>&
+L3SamplingTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"FaceId", TraceSink::INTEGER},
+    {"FaceDescr", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Samples", TraceSink::INTEGER},
+    {"PacketRaw", TraceSink::DOUBLE},
+    {"KilobytesRaw", TraceSink::DOUBLE}};
+  return columns;
+}
+
+L3SamplingTracer::L3SamplingTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_l3(node->GetObject<L3Protocol>())
+  , m_sink(sink)
+  , m_recorder(make_shared<PacketEventRecorder>())
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+#ifdef NDNSIM_DISABLE_PACKET_EVENTS
+  NS_LOG_WARN("Packet events are compiled out, the tracer of node " << m_node
+              << " will not record any packet");
+#endif
+
+  m_recorder->SetConsumer(std::bind(&L3SamplingTracer::Aggregate, this, std::placeholders::_1,
+                                    std::placeholders::_2));
+  if (m_l3->getPacketEventRecorder() != nullptr) {
+    NS_LOG_WARN("Replacing the packet event recorder of node " << m_node);
+  }
+  m_l3->setPacketEventRecorder(m_recorder);
+
+  // the description of a face is taken when it is added, as the face may be removed before the
+  // events recorded on it are aggregated
+  for (const Face& face : m_l3->getForwarder()->getFaceTable()) {
+    AddFace(face);
+  }
+  m_afterAddFace = m_l3->getForwarder()->getFaceTable().afterAdd.connect(
+    std::bind(&L3SamplingTracer::AddFace, this, std::placeholders::_1));
+
+  SetPeriod(Seconds(1.0));
+}
+
+L3SamplingTracer::~L3SamplingTracer()
+{
+  m_startEvent.Cancel();
+  m_printEvent.Cancel();
+  if (m_l3->getPacketEventRecorder() == m_recorder) {
+    m_l3->setPacketEventRecorder(nullptr);
+  }
+}
+
+void
+L3SamplingTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_startEvent.Cancel();
+  m_startEvent = ScheduleInNodeContext(m_nodePtr, Seconds(0),
+                                       &L3SamplingTracer::SchedulePrinter, this);
+}
+
+void
+L3SamplingTracer::SchedulePrinter()
+{
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &L3SamplingTracer::PeriodicPrinter, this);
+}
+
+void
+L3SamplingTracer::PeriodicPrinter()
+{
+  m_recorder->Drain();
+
+  double time = Simulator::Now().ToDouble(Time::S);
+  // by increasing face id
+  for (uint32_t slot : m_slots) {
+    if (slot == NO_SLOT)
+      continue;
+
+    FaceCounters& face = m_faceCounters[slot];
+    for (int type = 0; type < N_PACKET_EVENT_TYPES; type++) {
+      Counters& counters = face.counters[type];
+      double probability = GetSampler(static_cast<PacketEventType>(type)).GetProbability();
+      if (counters.packets == 0 || probability == 0) {
+        continue;
+      }
+
+      m_sink->Write(time, m_node, static_cast<int64_t>(face.faceId), face.description,
+                    TYPE_NAMES[type], counters.packets, counters.packets / probability,
+                    counters.bytes / probability / 1024.0);
+      counters = Counters{0, 0};
+    }
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &L3SamplingTracer::PeriodicPrinter, this);
+}
+
+void
+L3SamplingTracer::Aggregate(const PacketEvent* events, size_t nEvents)
+{
+  for (const PacketEvent* event = events; event != events + nEvents; event++) {
+    Counters& counters = GetFaceCounters(event->faceId).counters[event->type];
+    counters.packets++;
+    counters.bytes += event->size;
+  }
+}
+
+L3SamplingTracer::FaceCounters&
+L3SamplingTracer::GetFaceCounters(nfd::FaceId faceId)
+{
+  if (faceId < m_slots.size() && m_slots[faceId] != NO_SLOT) {
+    return m_faceCounters[m_slots[faceId]];
+  }
+
+  if (faceId >= m_slots.size()) {
+    m_slots.resize(faceId + 1, NO_SLOT);
+  }
+  m_slots[faceId] = m_faceCounters.size();
+
+  FaceCounters face = FaceCounters();
+  face.faceId = faceId;
+  Face* nfdFace = m_l3->getForwarder()->getFace(faceId);
+  if (nfdFace != nullptr) {
+    face.description = boost::lexical_cast<std::string>(nfdFace->getLocalUri());
+  }
+  m_faceCounters.push_back(face);
+  return m_faceCounters.back();
+}
+
+void
+L3SamplingTracer::AddFace(const Face& face)
+{
+  GetFaceCounters(face.getId()).description = boost::lexical_cast<std::string>(face.getLocalUri());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_L3_SAMPLING_TRACER_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_L3_SAMPLING_TRACER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-packet-event-recorder.hpp"
+#include "ndn-node-context-event.hpp"
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class L3Protocol;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN network-layer tracer estimating the traffic of the faces from sampled packets
+ *
+ * Unlike L3RateTracer, which is called with every packet, the tracer sets a PacketEventRecorder
+ * on L3Protocol, so that only a sample of the packets is recorded, each as a compact
+ * PacketEvent.  The events are aggregated per face when the buffer of the recorder is full and at
+ * the end of each period, when the tracer writes, for each face and type of packet, the number
+ * of sampled packets and the estimated numbers of packets and kilobytes of the period.
+ *
+ * A node has at most one recorder, so at most one L3SamplingTracer.  The recording is compiled
+ * out with ./waf configure --disable-ndn-packet-events.
+ */
+class L3SamplingTracer : public SimpleRefCount<L3SamplingTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used,
+   *             and if it ends with .bin, the traces are written in the binary format of TraceSink
+   * @param period How often data will be written into the trace file (default, every second)
+   * @param probability Probability of a packet to be sampled, for all types of packets
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1.0), double probability = 0.01);
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @see InstallAll
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0),
+          double probability = 0.01);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @see InstallAll
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file, Time period = Seconds(1.0),
+          double probability = 0.01);
+
+  /**
+   * @brief Helper method to install a tracer on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink of the records, e.g., opened with TraceSink::Open
+   * @param period How often data will be written into the trace file (default, every second)
+   * @param probability Probability of a packet to be sampled, for all types of packets
+   *
+   * The returned tracer needs to be preserved for the lifetime of the simulation.
+   */
+  static Ptr<L3SamplingTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time period = Seconds(1.0),
+          double probability = 0.01);
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Get the columns of the records of the tracer
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the records, possibly shared with other tracers
+   * @param node  pointer to the node
+   */
+  L3SamplingTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  ~L3SamplingTracer();
+
+  /**
+   * @brief Get the sampler of a type of packets, e.g., to record one in 100 outgoing Interests
+   */
+  PacketEventSampler&
+  GetSampler(PacketEventType type)
+  {
+    return m_recorder->GetSampler(type);
+  }
+
+  void
+  SetPeriod(const Time& period);
+
+private:
+  void
+  SchedulePrinter();
+
+  void
+  PeriodicPrinter();
+
+  void
+  Aggregate(const PacketEvent* events, size_t nEvents);
+
+  struct Counters
+  {
+    uint64_t packets;
+    uint64_t bytes;
+  };
+
+  struct FaceCounters
+  {
+    nfd::FaceId faceId;
+    std::string description;
+    Counters counters[N_PACKET_EVENT_TYPES];
+  };
+
+  FaceCounters&
+  GetFaceCounters(nfd::FaceId faceId);
+
+  void
+  AddFace(const Face& face);
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+  Ptr<L3Protocol> m_l3;
+  shared_ptr<TraceSink> m_sink;
+  shared_ptr<PacketEventRecorder> m_recorder;
+
+  Time m_period;
+  NodeContextEvent m_startEvent; ///< first printing, scheduled in the context of the node
+  EventId m_printEvent;
+  ::ndn::util::signal::ScopedConnection m_afterAddFace;
+
+  std::vector<uint32_t> m_slots; ///< index in m_faceCounters per face id
+  std::vector<FaceCounters> m_faceCounters;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_L3_SAMPLING_TRACER_HPP
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-latency-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+static const int SUB_BITS = 8;                          ///< the first 2^SUB_BITS bins have width 1
+static const uint64_t HALF_BINS = 1 << (SUB_BITS - 1); ///< bins per following power of two
+
+LatencyHistogram::LatencyHistogram()
+{
+  Reset();
+}
+
+size_t
+LatencyHistogram::GetIndex(uint64_t value)
+{
+  if (value < (HALF_BINS << 1)) {
+    return value;
+  }
+
+  int msb = 63;
+  while ((value >> msb) == 0) {
+    msb--;
+  }
+  int shift = msb - SUB_BITS + 1;
+  return shift * HALF_BINS + (value >> shift);
+}
+
+uint64_t
+LatencyHistogram::GetBinStart(size_t index)
+{
+  if (index < (HALF_BINS << 1)) {
+    return index;
+  }
+  uint64_t shift = index / HALF_BINS - 1;
+  return (index - shift * HALF_BINS) << shift;
+}
+
+uint64_t
+LatencyHistogram::GetBinWidth(size_t index)
+{
+  if (index < (HALF_BINS << 1)) {
+    return 1;
+  }
+  return uint64_t(1) << (index / HALF_BINS - 1);
+}
+
+void
+LatencyHistogram::AddValue(const Time& delay)
+{
+  uint64_t value = std::max<int64_t>(delay.GetNanoSeconds(), 0);
+
+  size_t index = GetIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  m_counts[index]++;
+
+  m_count++;
+  m_sum += value;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+}
+
+void
+LatencyHistogram::Reset()
+{
+  m_counts.clear(); // keeps the capacity
+  m_count = 0;
+  m_sum = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+}
+
+Time
+LatencyHistogram::GetMean() const
+{
+  if (m_count == 0) {
+    return Time(0);
+  }
+  return NanoSeconds(static_cast<int64_t>(m_sum / m_count));
+}
+
+Time
+LatencyHistogram::GetMin() const
+{
+  return m_count == 0 ? Time(0) : NanoSeconds(m_min);
+}
+
+Time
+LatencyHistogram::GetMax() const
+{
+  return NanoSeconds(m_max);
+}
+
+Time
+LatencyHistogram::GetQuantile(double q) const
+{
+  if (m_count == 0) {
+    return Time(0);
+  }
+
+  uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(q * m_count)), 1);
+  uint64_t seen = 0;
+  for (size_t index = 0; index < m_counts.size(); index++) {
+    seen += m_counts[index];
+    if (seen >= rank) {
+      uint64_t value = GetBinStart(index) + GetBinWidth(index) / 2;
+      return NanoSeconds(std::min(std::max(value, m_min), m_max));
+    }
+  }
+  return NanoSeconds(m_max);
+}
+
+} // namespace ndn
+} // namespace ns3
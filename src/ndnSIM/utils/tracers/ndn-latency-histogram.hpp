@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_LATENCY_HISTOGRAM_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_LATENCY_HISTOGRAM_HPP
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of delays with a bounded relative error, for online quantiles
+ *
+ * The delays are counted in nanoseconds, in bins whose width is proportional to their value
+ * (log-linear bins, as in HDR histograms): the delays below 256ns have bins of 1ns, and each
+ * following power of two is split into 128 bins.  A quantile is thus known within 0.4% of its
+ * value, and a histogram of delays up to 10 seconds holds less than 3600 counters, whatever
+ * the number of delays added.
+ *
+ * Unlike with ns3::Histogram of the flow monitor, whose bins have the same width, the memory does
+ * not grow linearly with the largest delay.
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram();
+
+  void
+  AddValue(const Time& delay);
+
+  /**
+   * @brief Remove all the values
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  Time
+  GetMean() const;
+
+  Time
+  GetMin() const;
+
+  Time
+  GetMax() const;
+
+  /**
+   * @brief Get the q-quantile of the values, e.g., the median for 0.5
+   *
+   * The quantile is the middle of the bin of the value of rank ceil(q * count), within the
+   * minimum and the maximum of the values, and 0 without values.
+   */
+  Time
+  GetQuantile(double q) const;
+
+private:
+  static size_t
+  GetIndex(uint64_t value);
+
+  static uint64_t
+  GetBinStart(size_t index);
+
+  static uint64_t
+  GetBinWidth(size_t index);
+
+private:
+  std::vector<uint32_t> m_counts; ///< per bin, grown to the bin of the largest value
+  uint64_t m_count;
+  double m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_LATENCY_HISTOGRAM_HPP
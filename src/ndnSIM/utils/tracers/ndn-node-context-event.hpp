@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_NODE_CONTEXT_EVENT_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_NODE_CONTEXT_EVENT_HPP
+
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Cancellable handle to an event scheduled in the context of a node
+ *
+ * Simulator::ScheduleWithContext returns no EventId, as a parallel simulator may insert the
+ * event from another thread; the handle cancels the event itself instead, which is harmless
+ * once it has been executed.
+ */
+class NodeContextEvent {
+public:
+  NodeContextEvent() = default;
+
+  explicit NodeContextEvent(Ptr<EventImpl> event)
+    : m_event(event)
+  {
+  }
+
+  /**
+   * @brief Cancel the event, if any
+   */
+  void
+  Cancel()
+  {
+    if (m_event != 0) {
+      m_event->Cancel();
+      m_event = 0;
+    }
+  }
+
+private:
+  Ptr<EventImpl> m_event;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Schedule a method in the context of a node
+ *
+ * The tracers start printing this way, so that a parallel simulator prints from the thread
+ * which updates their stats.
+ */
+template<typename MEM, typename OBJ>
+NodeContextEvent
+ScheduleInNodeContext(Ptr<Node> node, const Time& delay, MEM mem, OBJ obj)
+{
+  EventImpl* event = MakeEvent(mem, obj);
+  NodeContextEvent handle(event);
+  Simulator::ScheduleWithContext(node->GetId(), delay, event);
+  return handle;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_NODE_CONTEXT_EVENT_HPP
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-packet-event-recorder.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PacketEventRecorder");
+
+namespace ns3 {
+namespace ndn {
+
+PacketEventSampler::PacketEventSampler()
+  : m_countdown(0)
+  , m_interval(0)
+  , m_probability(0)
+{
+}
+
+void
+PacketEventSampler::Disable()
+{
+  m_countdown = 0;
+  m_probability = 0;
+}
+
+void
+PacketEventSampler::SampleAll()
+{
+  SampleOneIn(1);
+}
+
+void
+PacketEventSampler::SampleOneIn(uint32_t n)
+{
+  NS_ASSERT(n > 0);
+  m_interval = n;
+  m_probability = 1.0 / n;
+  m_countdown = GetNextInterval();
+}
+
+void
+PacketEventSampler::SampleWithProbability(double probability)
+{
+  if (probability <= 0) {
+    Disable();
+    return;
+  }
+  if (probability >= 1) {
+    SampleAll();
+    return;
+  }
+
+  if (m_random == nullptr) {
+    m_random = CreateObject<UniformRandomVariable>();
+  }
+  m_interval = 0;
+  m_probability = probability;
+  m_countdown = GetNextInterval();
+}
+
+uint64_t
+PacketEventSampler::GetNextInterval()
+{
+  if (m_interval != 0) {
+    return m_interval;
+  }
+
+  // number of trials until the first success, by inversion of the geometric distribution
+  double u = 1.0 - m_random->GetValue(); // in (0, 1]
+  return 1 + static_cast<uint64_t>(std::floor(std::log(u) / std::log1p(-m_probability)));
+}
+
+PacketEventRecorder::PacketEventRecorder(size_t capacity /* = 4096*/)
+  : m_head(0)
+  , m_tail(0)
+{
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  m_events.resize(size);
+  m_mask = size - 1;
+}
+
+void
+PacketEventRecorder::Push(PacketEventType type, const Name& name, size_t size, nfd::FaceId faceId)
+{
+  if (m_head - m_tail == m_events.size()) {
+    NS_LOG_LOGIC("Buffer full, draining " << m_events.size() << " events");
+    Drain();
+  }
+
+  PacketEvent& event = m_events[m_head & m_mask];
+  event.time = Simulator::Now().GetTimeStep();
+  event.nameHash = std::hash<Name>()(name);
+  event.faceId = faceId;
+  event.size = static_cast<uint32_t>(size);
+  event.type = type;
+  m_head++;
+}
+
+void
+PacketEventRecorder::Drain()
+{
+  if (m_consumer) {
+    // the events from the tail to the end of the vector, then those wrapped around its beginning
+    while (m_tail != m_head) {
+      size_t start = m_tail & m_mask;
+      size_t count = std::min<uint64_t>(m_head - m_tail, m_events.size() - start);
+      m_consumer(&m_events[start], count);
+      m_tail += count;
+    }
+  }
+  m_tail = m_head;
+}
+
+} // namespace ndn
+} // namespace ns3
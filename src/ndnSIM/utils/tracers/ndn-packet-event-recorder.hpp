@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_PACKET_EVENT_RECORDER_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_PACKET_EVENT_RECORDER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/lp/nack.hpp>
+
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+#include <functional>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Record a sampled packet event of L3Protocol, if a recorder is set
+ *
+ * With NDNSIM_DISABLE_PACKET_EVENTS defined (./waf configure --disable-ndn-packet-events), the
+ * events are compiled out of the forwarding path.
+ */
+#ifdef NDNSIM_DISABLE_PACKET_EVENTS
+#define NDN_RECORD_PACKET_EVENT(recorder, type, packet, face)
+#else
+#define NDN_RECORD_PACKET_EVENT(recorder, type, packet, face)                                      \
+  do {                                                                                             \
+    if (recorder != nullptr) {                                                                     \
+      recorder->Record(type, packet, face);                                                        \
+    }                                                                                              \
+  } while (false)
+#endif
+
+namespace ns3 {
+namespace ndn {
+
+enum PacketEventType : uint8_t {
+  IN_INTEREST = 0,
+  OUT_INTEREST,
+  IN_DATA,
+  OUT_DATA,
+  IN_NACK,
+  OUT_NACK,
+  N_PACKET_EVENT_TYPES
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Compact record of a packet received or sent by a face
+ */
+struct PacketEvent
+{
+  int64_t time;      ///< simulation time, in time steps
+  uint64_t nameHash; ///< hash of the name of the packet (of the Interest of a Nack)
+  nfd::FaceId faceId;
+  uint32_t size;     ///< size of the wire encoding of the packet
+  PacketEventType type;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Decides which events of a trace source are recorded
+ *
+ * The sampler counts down the events until the next sampled one, so that skipping an event costs
+ * a decrement.  With a probability, the intervals between the sampled events are drawn from the
+ * geometric distribution, i.e., each event is sampled independently with that probability.
+ */
+class PacketEventSampler
+{
+public:
+  /**
+   * @brief Create a sampler recording no event
+   */
+  PacketEventSampler();
+
+  void
+  Disable();
+
+  void
+  SampleAll();
+
+  /**
+   * @brief Record every n-th event
+   */
+  void
+  SampleOneIn(uint32_t n);
+
+  /**
+   * @brief Record each event with a probability
+   */
+  void
+  SampleWithProbability(double probability);
+
+  /**
+   * @brief Get the fraction of the events which are recorded, 0 if disabled
+   */
+  double
+  GetProbability() const
+  {
+    return m_probability;
+  }
+
+  /**
+   * @brief Check whether the next event is recorded
+   */
+  bool
+  Sample()
+  {
+    if (m_countdown == 0 || --m_countdown != 0) {
+      return false;
+    }
+    m_countdown = GetNextInterval();
+    return true;
+  }
+
+private:
+  uint64_t
+  GetNextInterval();
+
+private:
+  uint64_t m_countdown; ///< number of events until the next sampled one, 0 if disabled
+  uint32_t m_interval;  ///< fixed interval, or 0 with a probability
+  double m_probability;
+  Ptr<UniformRandomVariable> m_random;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Ring buffer of the sampled packet events of the faces of a node
+ *
+ * L3Protocol records the events through NDN_RECORD_PACKET_EVENT: the sampler of the type of the
+ * event is checked first, and only a sampled event is hashed and stored.  The events are handed
+ * over in batches to a consumer, which aggregates them off the forwarding path, when the buffer
+ * is full and when Drain is called, e.g., periodically by L3SamplingTracer.
+ */
+class PacketEventRecorder : boost::noncopyable
+{
+public:
+  /**
+   * @brief Consumer of the events, given as contiguous spans in the order of the events
+   */
+  typedef std::function<void(const PacketEvent* events, size_t nEvents)> Consumer;
+
+  /**
+   * @param capacity number of events in the buffer, rounded up to a power of two
+   */
+  explicit
+  PacketEventRecorder(size_t capacity = 4096);
+
+  PacketEventSampler&
+  GetSampler(PacketEventType type)
+  {
+    return m_samplers[type];
+  }
+
+  void
+  SetConsumer(const Consumer& consumer)
+  {
+    m_consumer = consumer;
+  }
+
+  template<typename Packet>
+  void
+  Record(PacketEventType type, const Packet& packet, const Face& face)
+  {
+    if (m_samplers[type].Sample()) {
+      Push(type, packet.getName(), packet.hasWire() ? packet.wireEncode().size() : 0,
+           face.getId());
+    }
+  }
+
+  void
+  Record(PacketEventType type, const lp::Nack& nack, const Face& face)
+  {
+    Record(type, nack.getInterest(), face);
+  }
+
+  /**
+   * @brief Hand the buffered events over to the consumer
+   */
+  void
+  Drain();
+
+  /**
+   * @brief Get the number of events in the buffer
+   */
+  size_t
+  GetSize() const
+  {
+    return m_head - m_tail;
+  }
+
+private:
+  void
+  Push(PacketEventType type, const Name& name, size_t size, nfd::FaceId faceId);
+
+private:
+  PacketEventSampler m_samplers[N_PACKET_EVENT_TYPES];
+  std::vector<PacketEvent> m_events;
+  size_t m_mask;
+  uint64_t m_head; ///< number of events pushed
+  uint64_t m_tail; ///< number of events handed over to the consumer
+  Consumer m_consumer;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_PACKET_EVENT_RECORDER_HPP
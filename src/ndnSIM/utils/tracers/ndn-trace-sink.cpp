@@ -0,0 +1,470 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+static const char MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t VERSION = 1;
+static const size_t BUFFER_SIZE = 1 << 20;   ///< size of the text buffers written at once
+static const size_t MAX_QUEUED_BUFFERS = 16; ///< buffers waiting for the writer thread
+static const size_t BLOCK_SIZE = 1 << 16;    ///< records of a block of a binary trace
+
+template<typename T>
+static void
+appendNumber(std::string& buffer, T value)
+{
+  for (size_t i = 0; i < sizeof(T); i++) {
+    buffer.push_back(static_cast<char>(static_cast<uint64_t>(value) >> (8 * i)));
+  }
+}
+
+namespace {
+
+/**
+ * @brief Writer of buffers to a file, from a background thread
+ *
+ * The producer blocks while MAX_QUEUED_BUFFERS buffers are waiting, so that a simulation faster
+ * than the disk does not exhaust the memory.
+ */
+class AsyncWriter : boost::noncopyable
+{
+public:
+  explicit
+  AsyncWriter(const std::string& file)
+    : m_file(file)
+    , m_os(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary)
+    , m_isStopped(false)
+  {
+    if (m_os.is_open()) {
+      m_thread = std::thread(&AsyncWriter::Run, this);
+    }
+  }
+
+  ~AsyncWriter()
+  {
+    if (!m_thread.joinable()) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopped = true;
+    }
+    m_hasBuffers.notify_one();
+    m_thread.join();
+
+    m_os.close();
+    if (m_os.fail()) {
+      NS_LOG_ERROR("Writing the trace " << m_file << " failed");
+    }
+  }
+
+  bool
+  IsOpen() const
+  {
+    return m_thread.joinable();
+  }
+
+  void
+  Push(std::string&& buffer)
+  {
+    if (buffer.empty()) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_hasSpace.wait(lock, [this] { return m_buffers.size() < MAX_QUEUED_BUFFERS; });
+    m_buffers.push_back(std::move(buffer));
+    lock.unlock();
+    m_hasBuffers.notify_one();
+  }
+
+private:
+  void
+  Run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_hasBuffers.wait(lock, [this] { return !m_buffers.empty() || m_isStopped; });
+      if (m_buffers.empty()) {
+        break;
+      }
+
+      std::string buffer = std::move(m_buffers.front());
+      m_buffers.pop_front();
+      lock.unlock();
+      m_hasSpace.notify_one();
+
+      m_os.write(buffer.data(), buffer.size());
+
+      lock.lock();
+    }
+  }
+
+private:
+  std::string m_file;
+  std::ofstream m_os;
+
+  std::mutex m_mutex;
+  std::condition_variable m_hasBuffers;
+  std::condition_variable m_hasSpace;
+  std::deque<std::string> m_buffers;
+  bool m_isStopped;
+
+  std::thread m_thread;
+};
+
+/**
+ * @brief Sink of tab-separated text lines
+ *
+ * The lines either go through to a stream, or are buffered and written by an AsyncWriter.
+ */
+class TextTraceSink : public TraceSink
+{
+public:
+  TextTraceSink(const std::vector<Column>& columns, shared_ptr<std::ostream> os)
+    : TraceSink(columns)
+    , m_os(os)
+    , m_precision(static_cast<int>(os->precision()))
+  {
+  }
+
+  TextTraceSink(const std::vector<Column>& columns, std::unique_ptr<AsyncWriter> writer)
+    : TraceSink(columns)
+    , m_writer(std::move(writer))
+    , m_precision(6) // default of the streams
+  {
+    m_buffer.reserve(BUFFER_SIZE);
+  }
+
+  ~TextTraceSink()
+  {
+    DoFlush();
+  }
+
+  void
+  WriteHeader(const std::string& header)
+  {
+    if (header.empty()) {
+      for (size_t i = 0; i < m_columns.size(); i++) {
+        if (i > 0) {
+          m_buffer += '\t';
+        }
+        m_buffer += m_columns[i].name;
+      }
+    }
+    else {
+      m_buffer += header;
+    }
+    m_buffer += '\n';
+    if (m_os != nullptr) {
+      DoFlush();
+    }
+  }
+
+protected:
+  virtual void
+  AddDouble(double value)
+  {
+    // formatted as by the default std::ostream::operator<<
+    char number[32];
+    int length = std::snprintf(number, sizeof(number), "%.*g", m_precision, value);
+    AddSeparator();
+    m_buffer.append(number, length);
+  }
+
+  virtual void
+  AddInteger(int64_t value)
+  {
+    char number[32];
+    int length = std::snprintf(number, sizeof(number), "%" PRId64, value);
+    AddSeparator();
+    m_buffer.append(number, length);
+  }
+
+  virtual void
+  AddString(const std::string& value)
+  {
+    AddSeparator();
+    m_buffer += value;
+  }
+
+  virtual void
+  EndRecord()
+  {
+    m_buffer += '\n';
+    if (m_os != nullptr || m_buffer.size() >= BUFFER_SIZE) {
+      DoFlush();
+    }
+  }
+
+  virtual void
+  DoFlush()
+  {
+    if (m_os != nullptr) {
+      m_os->write(m_buffer.data(), m_buffer.size());
+      m_buffer.clear();
+    }
+    else if (!m_buffer.empty()) {
+      m_writer->Push(std::move(m_buffer));
+      m_buffer = std::string();
+      m_buffer.reserve(BUFFER_SIZE);
+    }
+  }
+
+private:
+  void
+  AddSeparator()
+  {
+    if (m_field > 0) {
+      m_buffer += '\t';
+    }
+  }
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::unique_ptr<AsyncWriter> m_writer;
+  int m_precision;
+  std::string m_buffer;
+};
+
+/**
+ * @brief Sink of blocks of columns, as described in TraceSink
+ */
+class BinaryTraceSink : public TraceSink
+{
+public:
+  BinaryTraceSink(const std::vector<Column>& columns, std::unique_ptr<AsyncWriter> writer)
+    : TraceSink(columns)
+    , m_writer(std::move(writer))
+    , m_values(columns.size())
+    , m_nRecords(0)
+  {
+    std::string header(MAGIC, sizeof(MAGIC));
+    appendNumber<uint32_t>(header, VERSION);
+    appendNumber<uint32_t>(header, m_columns.size());
+    for (const Column& column : m_columns) {
+      appendNumber<uint8_t>(header, column.type);
+      appendNumber<uint16_t>(header, column.name.size());
+      header += column.name;
+    }
+    m_writer->Push(std::move(header));
+
+    for (auto& values : m_values) {
+      values.reserve(BLOCK_SIZE);
+    }
+  }
+
+  ~BinaryTraceSink()
+  {
+    DoFlush();
+  }
+
+protected:
+  virtual void
+  AddDouble(double value)
+  {
+    switch (GetFieldType()) {
+    case DOUBLE: {
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      m_values[m_field].push_back(bits);
+      break;
+    }
+    case INTEGER:
+      m_values[m_field].push_back(static_cast<int64_t>(value));
+      break;
+    case STRING:
+      AddString(boost::lexical_cast<std::string>(value));
+      break;
+    }
+  }
+
+  virtual void
+  AddInteger(int64_t value)
+  {
+    switch (GetFieldType()) {
+    case DOUBLE:
+      AddDouble(value);
+      break;
+    case INTEGER:
+      m_values[m_field].push_back(value);
+      break;
+    case STRING:
+      AddString(boost::lexical_cast<std::string>(value));
+      break;
+    }
+  }
+
+  virtual void
+  AddString(const std::string& value)
+  {
+    if (GetFieldType() != STRING) {
+      NS_FATAL_ERROR("String for the numeric column " << m_columns[m_field].name);
+    }
+
+    auto entry = m_dictionary.insert(std::make_pair(value, m_dictionary.size()));
+    if (entry.second) {
+      m_newStrings.push_back(&entry.first->first);
+    }
+    m_values[m_field].push_back(entry.first->second);
+  }
+
+  virtual void
+  EndRecord()
+  {
+    NS_ASSERT_MSG(m_field == m_columns.size(), "Record with " << m_field << " fields instead of "
+                                                              << m_columns.size());
+    m_nRecords++;
+    if (m_nRecords == BLOCK_SIZE) {
+      DoFlush();
+    }
+  }
+
+  virtual void
+  DoFlush()
+  {
+    if (m_nRecords == 0) {
+      return;
+    }
+
+    std::string block;
+    appendNumber<uint32_t>(block, m_nRecords);
+    appendNumber<uint32_t>(block, m_newStrings.size());
+    for (const std::string* string : m_newStrings) {
+      appendNumber<uint32_t>(block, string->size());
+      block += *string;
+    }
+    for (size_t i = 0; i < m_columns.size(); i++) {
+      if (m_columns[i].type == STRING) {
+        for (uint64_t value : m_values[i]) {
+          appendNumber<uint32_t>(block, value);
+        }
+      }
+      else {
+        for (uint64_t value : m_values[i]) {
+          appendNumber<uint64_t>(block, value);
+        }
+      }
+      m_values[i].clear();
+    }
+    m_newStrings.clear();
+    m_nRecords = 0;
+
+    m_writer->Push(std::move(block));
+  }
+
+private:
+  std::unique_ptr<AsyncWriter> m_writer;
+
+  std::vector<std::vector<uint64_t>> m_values; ///< per column, the raw values of the block
+  size_t m_nRecords;                           ///< records of the block
+
+  std::unordered_map<std::string, uint32_t> m_dictionary;
+  std::vector<const std::string*> m_newStrings; ///< strings first used in the block
+};
+
+} // namespace
+
+shared_ptr<TraceSink>
+TraceSink::Open(const std::string& file, const std::vector<Column>& columns,
+                const std::string& textHeader /* = ""*/)
+{
+  if (file == "-") {
+    auto sink = make_shared<TextTraceSink>(columns,
+                                           shared_ptr<std::ostream>(&std::cout, std::bind([]{})));
+    sink->WriteHeader(textHeader);
+    return sink;
+  }
+
+  std::unique_ptr<AsyncWriter> writer(new AsyncWriter(file));
+  if (!writer->IsOpen()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+  static const std::string binarySuffix = ".bin";
+  if (file.size() >= binarySuffix.size()
+      && file.compare(file.size() - binarySuffix.size(), binarySuffix.size(), binarySuffix) == 0) {
+    return make_shared<BinaryTraceSink>(columns, std::move(writer));
+  }
+
+  auto sink = make_shared<TextTraceSink>(columns, std::move(writer));
+  sink->WriteHeader(textHeader);
+  return sink;
+}
+
+shared_ptr<TraceSink>
+TraceSink::CreateText(shared_ptr<std::ostream> os, const std::vector<Column>& columns)
+{
+  return make_shared<TextTraceSink>(columns, os);
+}
+
+void
+TraceSink::PrintColumnNames(std::ostream& os, const std::vector<Column>& columns)
+{
+  for (size_t i = 0; i < columns.size(); i++) {
+    if (i > 0) {
+      os << "\t";
+    }
+    os << columns[i].name;
+  }
+}
+
+TraceSink::TraceSink(const std::vector<Column>& columns)
+  : m_columns(columns)
+  , m_field(0)
+{
+}
+
+TraceSink::~TraceSink()
+{
+}
+
+void
+TraceSink::Flush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  DoFlush();
+}
+
+} // namespace ndn
+} // namespace ns3
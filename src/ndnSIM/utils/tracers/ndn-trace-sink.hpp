@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_TRACE_SINK_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_TRACE_SINK_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Destination of the records of a tracer
+ *
+ * A sink receives records of a fixed schema, i.e., a list of typed columns, and encodes them in
+ * one of the formats:
+ *
+ * - text: a header line with the names of the columns, then one line per record, with
+ *   tab-separated fields, as the tracers always wrote;
+ * - binary (files named *.bin): the records are stored by column, in blocks of up to 65536
+ *   records, and the strings are replaced by indexes in a dictionary of the file:
+ *
+ *       header:  "NDNTRACE", uint32 version (1), uint32 number of columns,
+ *                per column: uint8 type (0 double, 1 integer, 2 string),
+ *                            uint16 length, name of that length
+ *       blocks:  uint32 number of records, uint32 number of new strings,
+ *                per new string: uint32 length, bytes of that length,
+ *                per column: the values, as float64, int64, or uint32 dictionary index
+ *
+ *   All the numbers are little-endian.  The strings of the dictionary are numbered from 0, in
+ *   the order of their first appearance in the blocks.
+ *
+ * The sinks of files accumulate the encoded records in large buffers, which a background thread
+ * writes to the file, so that the simulation does not wait for the disk.  The records are
+ * written in order, and all of them are written when the sink is destroyed.
+ *
+ * The tracers of several nodes may share a sink, and the records are complete whatever the
+ * threads writing them, e.g., with the multithreaded simulator.
+ *
+ * Use ns3/ndnSIM/utils/read-binary-trace.py to load the binary traces for analysis.
+ */
+class TraceSink : boost::noncopyable
+{
+public:
+  enum ColumnType {
+    DOUBLE = 0,
+    INTEGER = 1,
+    STRING = 2
+  };
+
+  struct Column
+  {
+    std::string name;
+    ColumnType type;
+  };
+
+  /**
+   * @brief Open a sink writing a trace file
+   *
+   * @param file name of the file, in binary format if it ends with .bin, in text format
+   *             otherwise.  If the name is -, the records are written to std::cout in text format
+   * @param columns schema of the records
+   * @param textHeader header line of the text format, without the end of line, if it is not the
+   *                   tab-separated names of the columns, e.g., to keep the header of a tracer
+   * @returns the sink, or nullptr if the file cannot be opened for writing
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file, const std::vector<Column>& columns,
+       const std::string& textHeader = "");
+
+  /**
+   * @brief Create a sink writing each record to a stream in text format, without header
+   *
+   * The records go through to the stream, which the sink does not flush, so that several sinks
+   * may share the stream.
+   */
+  static shared_ptr<TraceSink>
+  CreateText(shared_ptr<std::ostream> os, const std::vector<Column>& columns);
+
+  /**
+   * @brief Print the tab-separated names of columns, as in the header of the text traces
+   */
+  static void
+  PrintColumnNames(std::ostream& os, const std::vector<Column>& columns);
+
+  virtual
+  ~TraceSink();
+
+  const std::vector<Column>&
+  GetColumns() const
+  {
+    return m_columns;
+  }
+
+  /**
+   * @brief Write a record, whose fields are given in the order of the columns
+   *
+   * The numbers are converted to the type of their column.
+   */
+  template<typename... Fields>
+  void
+  Write(const Fields&... fields)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_field = 0;
+    AddFields(fields...);
+    EndRecord();
+  }
+
+  /**
+   * @brief Hand the buffered records over to the output
+   */
+  void
+  Flush();
+
+protected:
+  explicit
+  TraceSink(const std::vector<Column>& columns);
+
+  virtual void
+  AddDouble(double value) = 0;
+
+  virtual void
+  AddInteger(int64_t value) = 0;
+
+  virtual void
+  AddString(const std::string& value) = 0;
+
+  virtual void
+  EndRecord() = 0;
+
+  virtual void
+  DoFlush() = 0;
+
+  /// Type of the column of the next field of the record
+  ColumnType
+  GetFieldType() const
+  {
+    return m_columns[m_field].type;
+  }
+
+private:
+  void
+  AddFields()
+  {
+  }
+
+  template<typename Field, typename... Fields>
+  void
+  AddFields(const Field& field, const Fields&... fields)
+  {
+    AddField(field);
+    m_field++;
+    AddFields(fields...);
+  }
+
+  void
+  AddField(double value)
+  {
+    AddDouble(value);
+  }
+
+  void
+  AddField(int value)
+  {
+    AddInteger(value);
+  }
+
+  void
+  AddField(unsigned int value)
+  {
+    AddInteger(value);
+  }
+
+  void
+  AddField(long value)
+  {
+    AddInteger(value);
+  }
+
+  void
+  AddField(unsigned long value)
+  {
+    AddInteger(static_cast<int64_t>(value));
+  }
+
+  void
+  AddField(long long value)
+  {
+    AddInteger(value);
+  }
+
+  void
+  AddField(unsigned long long value)
+  {
+    AddInteger(static_cast<int64_t>(value));
+  }
+
+  void
+  AddField(const std::string& value)
+  {
+    AddString(value);
+  }
+
+  void
+  AddField(const char* value)
+  {
+    AddString(value);
+  }
+
+protected:
+  const std::vector<Column> m_columns;
+  size_t m_field; ///< index of the column of the next field
+
+private:
+  std::mutex m_mutex;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_TRACE_SINK_HPP
@@ -50,7 +50,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -75,9 +75,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList *Buffer::g_freeList = 0;
+thread_local struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
 {
@@ -123,6 +123,9 @@ Buffer::Create (uint32_t dataSize)
   if (IS_UNINITIALIZED (g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
+      // refer to the destructor of this thread, so that it is
+      // constructed and run when the thread exits
+      static_cast<void> (&g_localStaticDestructor);
     }
   else if (IS_INITIALIZED (g_freeList))
     {
@@ -1123,9 +1126,31 @@ void
 Buffer::Iterator::Read (uint8_t *buffer, uint32_t size)
 {
   NS_LOG_FUNCTION (this << &buffer << size);
-  for (uint32_t i = 0; i < size; i++)
+  NS_ASSERT_MSG (m_current >= m_dataStart &&
+                 m_current + size <= m_dataEnd,
+                 GetReadErrorMessage ());
+  if (m_current < m_zeroStart)
     {
-      buffer[i] = ReadU8 ();
+      // bytes before the zero area
+      uint32_t n = std::min (size, m_zeroStart - m_current);
+      memcpy (buffer, &m_data[m_current], n);
+      buffer += n;
+      size -= n;
+      m_current += n;
+    }
+  if (size > 0 && m_current < m_zeroEnd)
+    {
+      uint32_t n = std::min (size, m_zeroEnd - m_current);
+      memset (buffer, 0, n);
+      buffer += n;
+      size -= n;
+      m_current += n;
+    }
+  if (size > 0)
+    {
+      // bytes after the zero area
+      memcpy (buffer, &m_data[m_current - (m_zeroEnd - m_zeroStart)], size);
+      m_current += size;
     }
 }
 
@@ -1161,6 +1186,13 @@ Buffer::Iterator::GetSize (void) const
   return m_dataEnd - m_dataStart;
 }
 
+uint32_t
+Buffer::Iterator::GetRemainingSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_dataEnd - m_current;
+}
+
 
 std::string 
 Buffer::Iterator::GetReadErrorMessage (void) const
@@ -28,7 +28,7 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+thread_local uint32_t Packet::m_globalUid = 0;
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -815,6 +815,17 @@ Packet::AddByteTag (const Tag &tag) const
                                 GetSize ());
   tag.Serialize (buffer);
 }
+void
+Packet::AddByteTag (const Tag &tag, uint32_t start, uint32_t end) const
+{
+  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ().GetName () << tag.GetSerializedSize () << start << end);
+  NS_ASSERT (start <= end && end <= GetSize ());
+  ByteTagList *list = const_cast<ByteTagList *> (&m_byteTagList);
+  TagBuffer buffer = list->Add (tag.GetInstanceTypeId (), tag.GetSerializedSize (),
+                                start,
+                                end);
+  tag.Serialize (buffer);
+}
 ByteTagIterator 
 Packet::GetByteTagIterator (void) const
 {
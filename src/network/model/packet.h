@@ -554,6 +554,18 @@ public:
    * packet).
    */
   void AddByteTag (const Tag &tag) const;
+  /**
+   * \brief Tag the specified bytes of this packet with a byte tag.
+   *
+   * \param tag the new tag to add to this packet
+   * \param start the offset of the first byte tagged
+   * \param end the offset after the last byte tagged
+   *
+   * Works like AddByteTag (const Tag &), but covers only the bytes
+   * in [\p start, \p end).  This is used to rebuild the byte tags of
+   * a packet, as found by GetByteTagIterator(), on a copy of it.
+   */
+  void AddByteTag (const Tag &tag, uint32_t start, uint32_t end) const;
   /**
    * \brief Retiurns an iterator over the set of byte tags included in this packet
    *
@@ -714,7 +726,7 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static thread_local uint32_t m_globalUid; //!< Global counter of packets Uid, per thread
 };
 
 /**
@@ -121,6 +121,13 @@ PointToPointChannel::GetPointToPointDevice (uint32_t i) const
   return m_link[i].m_src;
 }
 
+PointToPointNetDevice *
+PointToPointChannel::PeekPointToPointDevice (uint32_t i) const
+{
+  NS_ASSERT (i < 2);
+  return PeekPointer (m_link[i].m_src);
+}
+
 Ptr<NetDevice>
 PointToPointChannel::GetDevice (uint32_t i) const
 {
@@ -69,7 +69,7 @@ public:
    * \brief Attach a given netdevice to this channel
    * \param device pointer to the netdevice to attach to the channel
    */
-  void Attach (Ptr<PointToPointNetDevice> device);
+  virtual void Attach (Ptr<PointToPointNetDevice> device);
 
   /**
    * \brief Transmit a packet over this channel
@@ -93,6 +93,18 @@ public:
    */
   Ptr<PointToPointNetDevice> GetPointToPointDevice (uint32_t i) const;
 
+  /**
+   * \brief Get PointToPointNetDevice corresponding to index i on this channel,
+   * without touching its reference count
+   *
+   * The devices of a PointToPointRemoteChannel may be simulated by
+   * different threads, which must not share reference counts.
+   *
+   * \param i Index number of the device requested
+   * \returns pointer to PointToPointNetDevice requested
+   */
+  PointToPointNetDevice *PeekPointToPointDevice (uint32_t i) const;
+
   /**
    * \brief Get NetDevice corresponding to index i on this channel
    * \param i Index number of the device requested
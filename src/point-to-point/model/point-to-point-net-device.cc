@@ -362,9 +362,13 @@ PointToPointNetDevice::Receive (Ptr<Packet> packet)
 
       //
       // Trace sinks will expect complete packets, not packets without some of the
-      // headers.
+      // headers.  Only copy the packet for them if there are any.
       //
-      Ptr<Packet> originalPacket = packet->Copy ();
+      Ptr<Packet> originalPacket = packet;
+      if (!m_macRxTrace.IsEmpty () || !m_macPromiscRxTrace.IsEmpty ())
+        {
+          originalPacket = packet->Copy ();
+        }
 
       //
       // Strip off the point-to-point protocol header and forward this packet
@@ -624,7 +628,9 @@ PointToPointNetDevice::GetRemote (void) const
   NS_ASSERT (m_channel->GetNDevices () == 2);
   for (uint32_t i = 0; i < m_channel->GetNDevices (); ++i)
     {
-      Ptr<NetDevice> tmp = m_channel->GetDevice (i);
+      // the remote device may belong to another thread, so do not
+      // copy a Ptr to it
+      PointToPointNetDevice *tmp = m_channel->PeekPointToPointDevice (i);
       if (tmp != this)
         {
           return tmp->GetAddress ();
@@ -46,12 +46,37 @@ PointToPointRemoteChannel::GetTypeId (void)
 
 PointToPointRemoteChannel::PointToPointRemoteChannel ()
 {
+  for (uint32_t wire = 0; wire < 2; ++wire)
+    {
+      m_src[wire] = 0;
+      m_dstNode[wire] = 0;
+      m_dstIfIndex[wire] = 0;
+    }
 }
 
 PointToPointRemoteChannel::~PointToPointRemoteChannel ()
 {
 }
 
+void
+PointToPointRemoteChannel::Attach (Ptr<PointToPointNetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+
+  PointToPointChannel::Attach (device);
+  if (GetNDevices () == 2)
+    {
+      for (uint32_t wire = 0; wire < 2; ++wire)
+        {
+          Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+          NS_ASSERT_MSG (dst->GetNode () != 0, "Devices must be added to a node before being attached to a remote channel");
+          m_src[wire] = PeekPointer (GetSource (wire));
+          m_dstNode[wire] = dst->GetNode ()->GetId ();
+          m_dstIfIndex[wire] = dst->GetIfIndex ();
+        }
+    }
+}
+
 bool
 PointToPointRemoteChannel::TransmitStart (
   Ptr<Packet> p,
@@ -63,16 +88,14 @@ PointToPointRemoteChannel::TransmitStart (
 
   IsInitialized ();
 
-  uint32_t wire = src == GetSource (0) ? 0 : 1;
-  Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+  // The destination device may belong to another thread (see
+  // MultithreadedSimulatorImpl), so only the values recorded by
+  // Attach are used, and its reference count is left alone.
+  uint32_t wire = PeekPointer (src) == m_src[0] ? 0 : 1;
 
-#ifdef NS3_MPI
   // Calculate the rxTime (absolute)
   Time rxTime = Simulator::Now () + txTime + GetDelay ();
-  MpiInterface::SendPacket (p, rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
-#else
-  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
-#endif
+  MpiInterface::SendPacket (p, rxTime, m_dstNode[wire], m_dstIfIndex[wire]);
   return true;
 }
 
@@ -58,6 +58,17 @@ public:
    */
   ~PointToPointRemoteChannel ();
 
+  /**
+   * \brief Attach a given netdevice to this channel
+   *
+   * Once both devices are attached, the destination of each wire is
+   * recorded, so that transmitting does not touch the other device,
+   * which may be simulated by another thread.
+   *
+   * \param device pointer to the netdevice to attach to the channel
+   */
+  virtual void Attach (Ptr<PointToPointNetDevice> device);
+
   /**
    * \brief Transmit the packet
    *
@@ -68,6 +79,11 @@ public:
    */
   virtual bool TransmitStart (Ptr<Packet> p, Ptr<PointToPointNetDevice> src,
                               Time txTime);
+
+private:
+  PointToPointNetDevice *m_src[2];          //!< Source device of each wire
+  uint32_t m_dstNode[2];                    //!< Id of the destination node of each wire
+  uint32_t m_dstIfIndex[2];                 //!< Interface of the destination device of each wire
 };
 
 } // namespace ns3
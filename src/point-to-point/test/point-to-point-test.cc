@@ -23,6 +23,17 @@
 #include "ns3/simulator.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/socket.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -93,6 +104,490 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test class for PointToPointRemoteChannel with the
+ * MultithreadedSimulatorImpl
+ *
+ * It forwards packets back and forth along a chain of nodes, each one
+ * simulated by its own thread, and checks that they are received at
+ * the same times and with the same tags as with the default
+ * simulator.
+ */
+class PointToPointMultithreadedTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointMultithreadedTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Simulate the chain, recording the receptions
+   *
+   * \param multithreaded true to simulate each node by its own thread
+   */
+  void RunChain (bool multithreaded);
+
+  /**
+   * \brief Send one packet from the device specified
+   *
+   * \param device NetDevice to send from
+   * \param size size of the packet
+   * \param ttl number of times the packet is to be forwarded
+   */
+  void SendOnePacket (Ptr<NetDevice> device, uint32_t size, uint8_t ttl);
+
+  /**
+   * \brief Record a packet, and forward it if its ttl allows
+   *
+   * \param device NetDevice which received the packet
+   * \param p the packet
+   * \param protocol protocol number
+   * \param from the sender
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from);
+
+  static const uint32_t N_NODES = 4;     //!< Length of the chain
+  std::vector<std::vector<Time> > m_rxTimes; //!< Reception times, per node
+  std::vector<uint32_t> m_errors;        //!< Packets received without their byte tag, per node
+};
+
+const uint32_t PointToPointMultithreadedTest::N_NODES;
+
+PointToPointMultithreadedTest::PointToPointMultithreadedTest ()
+  : TestCase ("PointToPoint with MultithreadedSimulatorImpl")
+{
+}
+
+void
+PointToPointMultithreadedTest::SendOnePacket (Ptr<NetDevice> device, uint32_t size, uint8_t ttl)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  SocketIpTtlTag byteTag;
+  byteTag.SetTtl (42);
+  p->AddByteTag (byteTag);
+  SocketIpTtlTag packetTag;
+  packetTag.SetTtl (ttl);
+  p->AddPacketTag (packetTag);
+  device->Send (p, device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointMultithreadedTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from)
+{
+  // only the vectors of this node are touched: the nodes run in parallel
+  Ptr<Node> node = device->GetNode ();
+  m_rxTimes[node->GetId ()].push_back (Simulator::Now ());
+  SocketIpTtlTag byteTag;
+  if (!p->FindFirstMatchingByteTag (byteTag) || byteTag.GetTtl () != 42)
+    {
+      m_errors[node->GetId ()]++;
+    }
+
+  SocketIpTtlTag packetTag;
+  p->PeekPacketTag (packetTag);
+  if (packetTag.GetTtl () > 0)
+    {
+      // forward on the other device, or send back at the ends of the chain
+      Ptr<NetDevice> out = node->GetNDevices () == 1 ? device : node->GetDevice (1 - device->GetIfIndex ());
+      Ptr<Packet> q = p->Copy ();
+      q->RemovePacketTag (packetTag);
+      packetTag.SetTtl (packetTag.GetTtl () - 1);
+      q->AddPacketTag (packetTag);
+      out->Send (q, out->GetBroadcast (), 0x800);
+    }
+  return true;
+}
+
+void
+PointToPointMultithreadedTest::RunChain (bool multithreaded)
+{
+  if (multithreaded)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+      GlobalValue::Bind ("ThreadCount", UintegerValue (N_NODES));
+      MpiInterface::Enable (0, 0);
+    }
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      nodes.Add (CreateObject<Node> (multithreaded ? i : 0));
+    }
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  for (uint32_t i = 0; i + 1 < N_NODES; ++i)
+    {
+      NetDeviceContainer devices = p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+      devices.Get (0)->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedTest::Receive, this));
+      devices.Get (1)->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedTest::Receive, this));
+    }
+
+  m_rxTimes.assign (N_NODES, std::vector<Time> ());
+  m_errors.assign (N_NODES, 0);
+  Ptr<Node> first = nodes.Get (0);
+  Ptr<Node> last = nodes.Get (N_NODES - 1);
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      Simulator::ScheduleWithContext (first->GetId (), MicroSeconds (500 * i),
+                                      &PointToPointMultithreadedTest::SendOnePacket, this,
+                                      first->GetDevice (0), 100 + i, 9);
+      Simulator::ScheduleWithContext (last->GetId (), MicroSeconds (300 * i),
+                                      &PointToPointMultithreadedTest::SendOnePacket, this,
+                                      last->GetDevice (0), 1000 - i, 9);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (multithreaded)
+    {
+      MpiInterface::Disable ();
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+    }
+  // the order of simultaneous receptions is not specified
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      std::sort (m_rxTimes[i].begin (), m_rxTimes[i].end ());
+    }
+}
+
+void
+PointToPointMultithreadedTest::DoRun (void)
+{
+  RunChain (false);
+  std::vector<std::vector<Time> > expected = m_rxTimes;
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      total += expected[i].size ();
+    }
+  // 40 packets, each received 10 times
+  NS_TEST_ASSERT_MSG_EQ (total, 400, "Wrong number of receptions with the default simulator");
+
+  RunChain (true);
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_errors[i], 0, "Byte tag lost on node " << i);
+      NS_TEST_ASSERT_MSG_EQ (m_rxTimes[i].size (), expected[i].size (), "Wrong number of receptions on node " << i);
+      for (uint32_t j = 0; j < expected[i].size (); ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_rxTimes[i][j], expected[i][j], "Wrong reception time on node " << i);
+        }
+    }
+}
+
+/**
+ * \brief Test class for Simulator::Stop and EventIds with the
+ * MultithreadedSimulatorImpl
+ *
+ * Every node of a chain, each one simulated by its own thread, ticks
+ * every millisecond.  One node stops the simulation with a delay, and
+ * all the nodes must stop at the same time as with the default
+ * simulator.  An event scheduled before Run () is removed during it.
+ */
+class PointToPointMultithreadedStopTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointMultithreadedStopTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Simulate the chain, counting the ticks
+   *
+   * \param multithreaded true to simulate each node by its own thread
+   */
+  void RunChain (bool multithreaded);
+
+  /**
+   * \brief Count a tick of a node, and schedule the next one
+   *
+   * \param node the node
+   */
+  void Tick (uint32_t node);
+
+  /**
+   * \brief Stop the simulation, and remove the event scheduled before Run ()
+   */
+  void StopLater (void);
+
+  /**
+   * \brief The event which must not be executed
+   */
+  void Removed (void);
+
+  static const uint32_t N_NODES = 4;     //!< Length of the chain
+  std::vector<uint32_t> m_ticks;         //!< Number of ticks, per node
+  EventId m_removed;                     //!< Event scheduled before Run ()
+  bool m_isRemovedPending;               //!< Whether the event was pending when removed
+  bool m_isRemovedExecuted;              //!< Whether the event was executed
+};
+
+const uint32_t PointToPointMultithreadedStopTest::N_NODES;
+
+PointToPointMultithreadedStopTest::PointToPointMultithreadedStopTest ()
+  : TestCase ("Stop and EventIds with MultithreadedSimulatorImpl")
+{
+}
+
+void
+PointToPointMultithreadedStopTest::Tick (uint32_t node)
+{
+  m_ticks[node]++;
+  Simulator::Schedule (MilliSeconds (1), &PointToPointMultithreadedStopTest::Tick, this, node);
+}
+
+void
+PointToPointMultithreadedStopTest::StopLater (void)
+{
+  m_isRemovedPending = !m_removed.IsExpired ();
+  Simulator::Remove (m_removed);
+  Simulator::Stop (MilliSeconds (5));
+}
+
+void
+PointToPointMultithreadedStopTest::Removed (void)
+{
+  m_isRemovedExecuted = true;
+}
+
+void
+PointToPointMultithreadedStopTest::RunChain (bool multithreaded)
+{
+  if (multithreaded)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+      GlobalValue::Bind ("ThreadCount", UintegerValue (N_NODES));
+      MpiInterface::Enable (0, 0);
+    }
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      nodes.Add (CreateObject<Node> (multithreaded ? i : 0));
+    }
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  for (uint32_t i = 0; i + 1 < N_NODES; ++i)
+    {
+      p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+    }
+
+  m_ticks.assign (N_NODES, 0);
+  m_isRemovedPending = false;
+  m_isRemovedExecuted = false;
+  m_removed = Simulator::Schedule (Seconds (1), &PointToPointMultithreadedStopTest::Removed, this);
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      Simulator::ScheduleWithContext (nodes.Get (i)->GetId (), MilliSeconds (1),
+                                      &PointToPointMultithreadedStopTest::Tick, this, i);
+    }
+  // partition 0 holds the event scheduled before Run ()
+  Simulator::ScheduleWithContext (nodes.Get (0)->GetId (), MicroSeconds (10500),
+                                  &PointToPointMultithreadedStopTest::StopLater, this);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (multithreaded)
+    {
+      MpiInterface::Disable ();
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+    }
+}
+
+void
+PointToPointMultithreadedStopTest::DoRun (void)
+{
+  RunChain (false);
+  std::vector<uint32_t> expected = m_ticks;
+  // ticks at 1ms to 15ms
+  NS_TEST_ASSERT_MSG_EQ (expected[0], 15, "Wrong number of ticks with the default simulator");
+
+  RunChain (true);
+  NS_TEST_ASSERT_MSG_EQ (m_isRemovedPending, true, "Event scheduled before Run () expired");
+  NS_TEST_ASSERT_MSG_EQ (m_isRemovedExecuted, false, "Removed event executed");
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_ticks[i], expected[i], "Wrong number of ticks on node " << i);
+    }
+}
+
+/**
+ * \brief Test class for the lookahead of the partitions without events
+ * with the MultithreadedSimulatorImpl
+ *
+ * Two linked nodes, each one simulated by its own thread, send a
+ * packet back and forth, and the first one also ticks every
+ * millisecond, as does a third node which is not linked.  Between the
+ * receptions the second node has no event, and the first one must not
+ * run ahead of the packet it will receive back: the number of ticks at
+ * each reception must be the same as with the default simulator.
+ */
+class PointToPointMultithreadedIdleTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointMultithreadedIdleTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Simulate the nodes, recording the receptions
+   *
+   * \param multithreaded true to simulate each node by its own thread
+   */
+  void RunPingPong (bool multithreaded);
+
+  /**
+   * \brief Count a tick of a node, and schedule the next one
+   *
+   * \param node the node
+   */
+  void Tick (uint32_t node);
+
+  /**
+   * \brief Send a packet
+   *
+   * \param device NetDevice to send from
+   */
+  void SendOnePacket (Ptr<NetDevice> device);
+
+  /**
+   * \brief Record a packet, and send it back
+   *
+   * \param device NetDevice which received the packet
+   * \param p the packet
+   * \param protocol protocol number
+   * \param from the sender
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from);
+
+  static const uint32_t N_NODES = 3;     //!< Number of nodes
+  std::vector<uint32_t> m_ticks;         //!< Number of ticks, per node
+  std::vector<std::vector<Time> > m_rxTimes; //!< Reception times, per node
+  std::vector<std::vector<uint32_t> > m_rxTicks; //!< Number of ticks of the node at each reception, per node
+};
+
+const uint32_t PointToPointMultithreadedIdleTest::N_NODES;
+
+PointToPointMultithreadedIdleTest::PointToPointMultithreadedIdleTest ()
+  : TestCase ("Idle partitions with MultithreadedSimulatorImpl")
+{
+}
+
+void
+PointToPointMultithreadedIdleTest::Tick (uint32_t node)
+{
+  m_ticks[node]++;
+  Simulator::Schedule (MilliSeconds (1), &PointToPointMultithreadedIdleTest::Tick, this, node);
+}
+
+void
+PointToPointMultithreadedIdleTest::SendOnePacket (Ptr<NetDevice> device)
+{
+  device->Send (Create<Packet> (100), device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointMultithreadedIdleTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from)
+{
+  uint32_t node = device->GetNode ()->GetId ();
+  m_rxTimes[node].push_back (Simulator::Now ());
+  m_rxTicks[node].push_back (m_ticks[node]);
+  device->Send (p->Copy (), device->GetBroadcast (), 0x800);
+  return true;
+}
+
+void
+PointToPointMultithreadedIdleTest::RunPingPong (bool multithreaded)
+{
+  if (multithreaded)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+      GlobalValue::Bind ("ThreadCount", UintegerValue (N_NODES));
+      MpiInterface::Enable (0, 0);
+    }
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      nodes.Add (CreateObject<Node> (multithreaded ? i : 0));
+    }
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer devices = p2p.Install (nodes.Get (0), nodes.Get (1));
+  devices.Get (0)->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedIdleTest::Receive, this));
+  devices.Get (1)->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedIdleTest::Receive, this));
+
+  m_ticks.assign (N_NODES, 0);
+  m_rxTimes.assign (N_NODES, std::vector<Time> ());
+  m_rxTicks.assign (N_NODES, std::vector<uint32_t> ());
+  Simulator::ScheduleWithContext (nodes.Get (0)->GetId (), MicroSeconds (500),
+                                  &PointToPointMultithreadedIdleTest::SendOnePacket, this,
+                                  devices.Get (0));
+  Simulator::ScheduleWithContext (nodes.Get (0)->GetId (), MilliSeconds (1),
+                                  &PointToPointMultithreadedIdleTest::Tick, this, 0);
+  Simulator::ScheduleWithContext (nodes.Get (2)->GetId (), MilliSeconds (1),
+                                  &PointToPointMultithreadedIdleTest::Tick, this, 2);
+  Simulator::Stop (MilliSeconds (100));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (multithreaded)
+    {
+      MpiInterface::Disable ();
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+    }
+}
+
+void
+PointToPointMultithreadedIdleTest::DoRun (void)
+{
+  RunPingPong (false);
+  std::vector<std::vector<Time> > expectedTimes = m_rxTimes;
+  std::vector<std::vector<uint32_t> > expectedTicks = m_rxTicks;
+  std::vector<uint32_t> expected = m_ticks;
+  NS_TEST_ASSERT_MSG_GT (expectedTimes[0].size (), 10, "Too few receptions with the default simulator");
+
+  RunPingPong (true);
+  for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_ticks[i], expected[i], "Wrong number of ticks on node " << i);
+      NS_TEST_ASSERT_MSG_EQ (m_rxTimes[i].size (), expectedTimes[i].size (), "Wrong number of receptions on node " << i);
+      for (uint32_t j = 0; j < expectedTimes[i].size () && j < m_rxTimes[i].size (); ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_rxTimes[i][j], expectedTimes[i][j], "Wrong reception time on node " << i);
+          NS_TEST_ASSERT_MSG_EQ (m_rxTicks[i][j], expectedTicks[i][j], "Node " << i << " ran ahead of reception " << j);
+        }
+    }
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -109,6 +604,9 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointMultithreadedTest, TestCase::QUICK);
+  AddTestCase (new PointToPointMultithreadedStopTest, TestCase::QUICK);
+  AddTestCase (new PointToPointMultithreadedIdleTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -45,7 +45,8 @@ public:
   Bench (const uint32_t population, const uint32_t total)
   : m_population (population),
     m_total (total),
-    m_count (0)
+    m_count (0),
+    m_ndn (false)
   { };
   
   void SetRandomStream (Ptr<RandomVariableStream> stream)
@@ -62,15 +63,30 @@ public:
   {
     m_total = total;
   }
+
+  /**
+   * Make each event also start a long timer, which is removed
+   * by a short timer firing shortly afterwards, like the expiry
+   * timer of a PIT entry being cancelled when the Data arrives.
+   */
+  void SetNdn (const Time timeout)
+  {
+    m_ndn = true;
+    m_timeout = timeout;
+  }
     
   void RunBench (void);
 private:
   void Cb (void);
+  void Satisfy (EventId timeout);
+  void Timeout (void);
   
   Ptr<RandomVariableStream> m_rand;
   uint32_t m_population;
   uint32_t m_total;
   uint32_t m_count;
+  bool m_ndn;
+  Time m_timeout;
 };
 
 void
@@ -121,6 +137,24 @@ Bench::Cb (void)
   Time after = NanoSeconds (m_rand->GetValue ());
   Simulator::Schedule (after, &Bench::Cb, this);
   ++m_count;
+
+  if (m_ndn)
+    {
+      EventId timeout = Simulator::Schedule (m_timeout, &Bench::Timeout, this);
+      Time rtt = NanoSeconds (m_rand->GetValue ());
+      Simulator::Schedule (rtt, &Bench::Satisfy, this, timeout);
+    }
+}
+
+void
+Bench::Satisfy (EventId timeout)
+{
+  Simulator::Remove (timeout);
+}
+
+void
+Bench::Timeout (void)
+{
 }
 
 
@@ -184,8 +218,12 @@ int main (int argc, char *argv[])
 
   bool schedCal  = false;
   bool schedHeap = false;
+  bool schedIHeap = false;
+  bool schedLadder = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool ndn = false;
+  uint64_t timeout = 1000000;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
@@ -200,9 +238,15 @@ int main (int argc, char *argv[])
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in ns.\n"
+             "\n"
+             "With --ndn, each event also schedules a timer --timeout ns later\n"
+             "and another event, drawn from the same distribution, which\n"
+             "removes that timer (like PIT entry expiry timers in NDN).");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
+  cmd.AddValue ("iheap", "use IndexedHeapScheduler",      schedIHeap);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
@@ -211,6 +255,8 @@ int main (int argc, char *argv[])
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
   cmd.AddValue ("file",  "file of relative event times",  filename);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
+  cmd.AddValue ("ndn",   "add a removed timer to each event (NDN-like workload)", ndn);
+  cmd.AddValue ("timeout", "delay of the removed timers in ns (default 1E6)", timeout);
   cmd.Parse (argc, argv);
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
@@ -218,6 +264,8 @@ int main (int argc, char *argv[])
   ObjectFactory factory ("ns3::MapScheduler");
   if (schedCal)  { factory.SetTypeId ("ns3::CalendarScheduler"); }
   if (schedHeap) { factory.SetTypeId ("ns3::HeapScheduler");     }
+  if (schedIHeap) { factory.SetTypeId ("ns3::IndexedHeapScheduler"); }
+  if (schedLadder) { factory.SetTypeId ("ns3::LadderScheduler"); }
   if (schedList) { factory.SetTypeId ("ns3::ListScheduler");     }  
   Simulator::SetScheduler (factory);
 
@@ -228,9 +276,17 @@ int main (int argc, char *argv[])
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
+  if (ndn)
+    {
+      LOGME ("removed timers: " << timeout << " ns");
+    }
   
   Bench *bench = new Bench (pop, total);
   bench->SetRandomStream (GetRandomStream (filename));
+  if (ndn)
+    {
+      bench->SetNdn (NanoSeconds (timeout));
+    }
 
   // table header
   LOG ("");